@@ -0,0 +1,361 @@
+// Microbenchmarks of the parser: FixTokenizer::Parse, the value converters and FixGroupParser
+// Each benchmark runs over the messages of a log (see generate_fix_log.cpp) loaded into memory,
+// and reports the best of --repeat runs and the heap allocations per message of one more run
+//
+// Usage: quackfix_bench_parser <log file> [--delimiter pipe|soh] [--repeat 5] [--max-mb 512]
+
+#include "parser/fix_tokenizer.hpp"
+#include "parser/fix_group_parser.hpp"
+#include "parser/fix_type_conversions.hpp"
+#include "dictionary/fix_dictionary_tables.hpp"
+#include "dictionary/embedded_fix44_dictionary.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace duckdb;
+
+// Heap allocations of the process, counted by the replaced global operator new
+static std::atomic<uint64_t> allocation_count {0};
+
+void *operator new(size_t size) {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	if (auto result = malloc(size ? size : 1)) {
+		return result;
+	}
+	throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept {
+	free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+	free(ptr);
+}
+
+namespace {
+
+struct Line {
+	const char *data;
+	size_t len;
+};
+
+struct Options {
+	std::string file;
+	char delimiter = '|';
+	int repeat = 5;
+	size_t max_bytes = 512ULL << 20;
+};
+
+// Messages that sink into this are not optimized away
+uint64_t checksum = 0;
+
+// Best wall time of repeat runs of f, in seconds
+template <class F>
+double BestOf(int repeat, F &&f) {
+	double best = 0;
+	for (int i = 0; i < repeat; i++) {
+		auto start = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		if (i == 0 || elapsed.count() < best) {
+			best = elapsed.count();
+		}
+	}
+	return best;
+}
+
+void Report(const char *name, double seconds, uint64_t bytes, uint64_t items, const char *unit) {
+	if (items == 0) {
+		printf("%-24s %10s (no values in the log)\n", name, "-");
+		return;
+	}
+	printf("%-24s %10.1f MB/s %14.0f %s/s %10.2f ns/%s\n", name, static_cast<double>(bytes) / (1 << 20) / seconds,
+	       static_cast<double>(items) / seconds, unit, seconds * 1e9 / static_cast<double>(items), unit);
+}
+
+// Heap allocations per item of one more run of f, after the timed runs have grown the reused buffers
+// Steady-state parsing is meant to allocate nothing
+template <class F>
+void ReportAllocations(uint64_t items, F &&f) {
+	auto before = allocation_count.load(std::memory_order_relaxed);
+	f();
+	auto allocations = allocation_count.load(std::memory_order_relaxed) - before;
+	printf("%-24s %10.4f allocations/msg%s\n", "", items ? static_cast<double>(allocations) / items : 0.0,
+	       allocations ? " (expected 0)" : "");
+}
+
+std::string LoadFile(const Options &options) {
+	auto file = fopen(options.file.c_str(), "rb");
+	if (!file) {
+		fprintf(stderr, "cannot open %s\n", options.file.c_str());
+		exit(1);
+	}
+	std::string data(options.max_bytes, '\0');
+	data.resize(fread(&data[0], 1, data.size(), file));
+	fclose(file);
+	// Drop a partial last line
+	auto last = data.rfind('\n');
+	data.resize(last == std::string::npos ? 0 : last + 1);
+	return data;
+}
+
+std::vector<Line> SplitLines(const std::string &data) {
+	std::vector<Line> lines;
+	size_t start = 0;
+	while (start < data.size()) {
+		auto end = data.find('\n', start);
+		if (end == std::string::npos) {
+			end = data.size();
+		}
+		if (end > start) {
+			lines.push_back({data.data() + start, end - start});
+		}
+		start = end + 1;
+	}
+	return lines;
+}
+
+void BenchTokenizer(const Options &options, const std::vector<Line> &lines, uint64_t bytes) {
+	ParsedFixMessage parsed;
+	uint64_t failed = 0;
+
+	// Full parse, as for the tags, groups and parse_error columns
+	FixParseOptions full;
+	full.delimiter = options.delimiter;
+	auto run_full = [&]() {
+		failed = 0;
+		for (auto &line : lines) {
+			if (!FixTokenizer::Parse(line.data, line.len, parsed, full)) {
+				failed++;
+			}
+			checksum += parsed.all_tags_ordered.size();
+		}
+	};
+	auto seconds = BestOf(options.repeat, run_full);
+	Report("tokenize_full", seconds, bytes, lines.size(), "msg");
+	printf("%-24s %10llu of %zu messages rejected\n", "", static_cast<unsigned long long>(failed), lines.size());
+	ReportAllocations(lines.size(), run_full);
+
+	// Projection of a few hot tags, the tokenizer stops once it has them
+	FixParseOptions hot;
+	hot.delimiter = options.delimiter;
+	hot.keep_tag_list = false;
+	for (auto tag : {FixHotTags::MSG_TYPE, FixHotTags::SENDING_TIME, FixHotTags::SYMBOL}) {
+		hot.RequireSlot(static_cast<uint16_t>(FixHotTags::HotSlot(tag)));
+	}
+	auto run_hot = [&]() {
+		for (auto &line : lines) {
+			FixTokenizer::Parse(line.data, line.len, parsed, hot);
+			checksum += parsed.Hot<FixHotTags::SYMBOL>().len;
+		}
+	};
+	seconds = BestOf(options.repeat, run_hot);
+	Report("tokenize_hot_early_exit", seconds, bytes, lines.size(), "msg");
+	ReportAllocations(lines.size(), run_hot);
+
+	// Promoted tags (rtags/tagIds) on top of the hot tags, without the tag list
+	FixTagLayout layout;
+	auto transact_time = layout.AddTag(60);
+	auto account = layout.AddTag(1);
+	ParsedFixMessage promoted(layout);
+	FixParseOptions promoted_options;
+	promoted_options.delimiter = options.delimiter;
+	promoted_options.keep_tag_list = false;
+	auto run_promoted = [&]() {
+		for (auto &line : lines) {
+			FixTokenizer::Parse(line.data, line.len, promoted, promoted_options);
+			checksum += promoted.GetSlot(transact_time).len + promoted.GetSlot(account).len;
+		}
+	};
+	seconds = BestOf(options.repeat, run_promoted);
+	Report("tokenize_promoted", seconds, bytes, lines.size(), "msg");
+	ReportAllocations(lines.size(), run_promoted);
+}
+
+struct Values {
+	std::vector<ParsedFixMessage::TagValue> values;
+	uint64_t bytes = 0;
+
+	void Add(const ParsedFixMessage::TagValue &value) {
+		if (value.data && value.len > 0) {
+			values.push_back(value);
+			bytes += value.len;
+		}
+	}
+};
+
+// The converters run over values collected first, so the numbers do not include tokenizing
+void BenchConverters(const Options &options, const std::vector<Line> &lines) {
+	Values ints, doubles, timestamps;
+	ParsedFixMessage parsed;
+	FixParseOptions parse_options;
+	parse_options.delimiter = options.delimiter;
+	parse_options.keep_tag_list = false;
+	for (auto &line : lines) {
+		FixTokenizer::Parse(line.data, line.len, parsed, parse_options);
+		ints.Add(parsed.Hot<FixHotTags::MSG_SEQ_NUM>());
+		doubles.Add(parsed.Hot<FixHotTags::PRICE>());
+		doubles.Add(parsed.Hot<FixHotTags::ORDER_QTY>());
+		doubles.Add(parsed.Hot<FixHotTags::LAST_PX>());
+		timestamps.Add(parsed.Hot<FixHotTags::SENDING_TIME>());
+	}
+
+	auto seconds = BestOf(options.repeat, [&]() {
+		for (auto &value : ints.values) {
+			int64_t result;
+			if (ConvertToInt64(value.data, value.len, result, nullptr, "MsgSeqNum")) {
+				checksum += static_cast<uint64_t>(result);
+			}
+		}
+	});
+	Report("convert_int64", seconds, ints.bytes, ints.values.size(), "value");
+
+	seconds = BestOf(options.repeat, [&]() {
+		for (auto &value : doubles.values) {
+			double result;
+			if (ConvertToDouble(value.data, value.len, result, nullptr, "Price")) {
+				checksum += static_cast<uint64_t>(result);
+			}
+		}
+	});
+	Report("convert_double", seconds, doubles.bytes, doubles.values.size(), "value");
+
+	seconds = BestOf(options.repeat, [&]() {
+		for (auto &value : timestamps.values) {
+			timestamp_t result;
+			if (ConvertToTimestamp(value.data, value.len, result, nullptr, "SendingTime")) {
+				checksum += static_cast<uint64_t>(result.value);
+			}
+		}
+	});
+	Report("convert_timestamp", seconds, timestamps.bytes, timestamps.values.size(), "value");
+
+	// The same, collecting error records as when parse_error is projected
+	FixConversionErrors errors;
+	seconds = BestOf(options.repeat, [&]() {
+		for (auto &value : timestamps.values) {
+			timestamp_t result;
+			errors.Clear();
+			if (ConvertToTimestamp(value.data, value.len, result, &errors, "SendingTime")) {
+				checksum += static_cast<uint64_t>(result.value);
+			}
+		}
+	});
+	Report("convert_timestamp_errors", seconds, timestamps.bytes, timestamps.values.size(), "value");
+}
+
+// Group parsing over messages tokenized up front, with the compiled embedded FIX 4.4 dictionary
+void BenchGroups(const Options &options, const std::vector<Line> &lines) {
+	auto dictionary = BuildFixDictionary(GetEmbeddedFix44Tables());
+	FixGroupLayout layout(dictionary);
+
+	// Keeping every tag list in memory is expensive, a sample of up to 200000 messages is enough
+	std::vector<ParsedFixMessage> messages;
+	uint64_t bytes = 0;
+	FixParseOptions parse_options;
+	parse_options.delimiter = options.delimiter;
+	ParsedFixMessage parsed;
+	for (auto &line : lines) {
+		if (messages.size() >= 200000) {
+			break;
+		}
+		if (FixTokenizer::Parse(line.data, line.len, parsed, parse_options)) {
+			messages.push_back(parsed);
+			bytes += line.len;
+		}
+	}
+	if (messages.empty()) {
+		return;
+	}
+
+	FixParsedGroups groups;
+	uint64_t instances = 0;
+	auto run_groups = [&]() {
+		instances = 0;
+		for (auto &message : messages) {
+			FixGroupParser::ParseGroups(message, layout, groups);
+			instances += groups.instances.size();
+		}
+	};
+	auto seconds = BestOf(options.repeat, run_groups);
+	checksum += instances;
+	Report("group_parse", seconds, bytes, messages.size(), "msg");
+	printf("%-24s %10llu group instances\n", "", static_cast<unsigned long long>(instances));
+	ReportAllocations(messages.size(), run_groups);
+}
+
+int Usage() {
+	fprintf(stderr, "usage: quackfix_bench_parser <log file> [--delimiter pipe|soh] [--repeat 5] [--max-mb 512]\n");
+	return 1;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg.rfind("--", 0) != 0) {
+			options.file = arg;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			return Usage();
+		}
+		const char *value = argv[++i];
+		if (arg == "--delimiter") {
+			if (strcmp(value, "soh") == 0) {
+				options.delimiter = '\x01';
+			} else if (strcmp(value, "pipe") == 0) {
+				options.delimiter = '|';
+			} else {
+				return Usage();
+			}
+		} else if (arg == "--repeat") {
+			options.repeat = atoi(value);
+		} else if (arg == "--max-mb") {
+			options.max_bytes = static_cast<size_t>(atoll(value)) << 20;
+		} else {
+			return Usage();
+		}
+	}
+	if (options.file.empty() || options.repeat <= 0 || options.max_bytes == 0) {
+		return Usage();
+	}
+
+	auto data = LoadFile(options);
+	auto lines = SplitLines(data);
+	if (lines.empty()) {
+		fprintf(stderr, "%s has no messages\n", options.file.c_str());
+		return 1;
+	}
+	printf("%s: %zu messages, %.1f MB, best of %d runs\n\n", options.file.c_str(), lines.size(),
+	       static_cast<double>(data.size()) / (1 << 20), options.repeat);
+
+	BenchTokenizer(options, lines, data.size());
+	BenchConverters(options, lines);
+	BenchGroups(options, lines);
+
+	printf("\nchecksum %llu\n", static_cast<unsigned long long>(checksum));
+	return 0;
+}
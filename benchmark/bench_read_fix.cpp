@@ -0,0 +1,139 @@
+// End-to-end read_fix query benchmarks, run for each thread count
+// Reports MB/s and rows/s of the whole query and MB/s per thread, the best of --repeat runs
+//
+// Usage: quackfix_bench_read_fix <files> [--delimiter pipe|soh] [--threads 1,2,4,8] [--repeat 3] [--query name]
+
+#include "duckdb.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "quackfix_extension.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace duckdb;
+
+namespace {
+
+struct BenchQuery {
+	const char *name;
+	// %s is replaced by the read_fix call
+	const char *sql;
+};
+
+const BenchQuery QUERIES[] = {
+    {"count", "SELECT COUNT(*) FROM %s"},
+    {"hot_columns", "SELECT MsgType, COUNT(*), SUM(Price), SUM(LastQty), MAX(SendingTime) FROM %s GROUP BY MsgType"},
+    {"filter_msgtype", "SELECT Symbol, SUM(LastQty * LastPx) FROM %s WHERE MsgType = '8' GROUP BY Symbol"},
+    {"tags_map", "SELECT COUNT(tags[60]) FROM %s"},
+    {"groups", "SELECT SUM(len(groups[268])) FROM %s"},
+    {"parse_error", "SELECT COUNT(parse_error) FROM %s"},
+    {"raw_message", "SELECT SUM(length(raw_message)) FROM %s"},
+};
+
+struct Options {
+	std::string files;
+	std::string delimiter = "|";
+	std::vector<int> threads = {1, 2, 4, 8};
+	int repeat = 3;
+	std::string query;
+};
+
+unique_ptr<MaterializedQueryResult> Run(Connection &con, const std::string &sql) {
+	auto result = con.Query(sql);
+	if (result->HasError()) {
+		fprintf(stderr, "%s\n%s\n", sql.c_str(), result->GetError().c_str());
+		exit(1);
+	}
+	return result;
+}
+
+int Usage() {
+	fprintf(stderr, "usage: quackfix_bench_read_fix <files> [--delimiter pipe|soh] [--threads 1,2,4,8] [--repeat 3] "
+	                "[--query name]\n");
+	return 1;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg.rfind("--", 0) != 0) {
+			options.files = arg;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			return Usage();
+		}
+		std::string value = argv[++i];
+		if (arg == "--delimiter") {
+			if (value == "soh") {
+				options.delimiter = "\\x01";
+			} else if (value == "pipe") {
+				options.delimiter = "|";
+			} else {
+				return Usage();
+			}
+		} else if (arg == "--threads") {
+			options.threads.clear();
+			for (auto &count : StringUtil::Split(value, ',')) {
+				auto threads = atoi(count.c_str());
+				if (threads <= 0) {
+					return Usage();
+				}
+				options.threads.push_back(threads);
+			}
+		} else if (arg == "--repeat") {
+			options.repeat = atoi(value.c_str());
+		} else if (arg == "--query") {
+			options.query = value;
+		} else {
+			return Usage();
+		}
+	}
+	if (options.files.empty() || options.threads.empty() || options.repeat <= 0) {
+		return Usage();
+	}
+
+	DuckDB db(nullptr);
+	db.LoadStaticExtension<QuackfixExtension>();
+	Connection con(db);
+
+	auto files = KeywordHelper::WriteQuoted(options.files, '\'');
+	auto source = "read_fix(" + files + ", delimiter := " + KeywordHelper::WriteQuoted(options.delimiter, '\'') + ")";
+	// read_blob does not read the contents when only the size is projected
+	auto bytes = Run(con, "SELECT SUM(size) FROM read_blob(" + files + ")")->GetValue(0, 0).GetValue<int64_t>();
+	auto rows = Run(con, "SELECT COUNT(*) FROM " + source)->GetValue(0, 0).GetValue<int64_t>();
+	printf("%s: %lld messages, %.1f MB, best of %d runs\n\n", options.files.c_str(), static_cast<long long>(rows),
+	       static_cast<double>(bytes) / (1 << 20), options.repeat);
+	printf("%-16s %8s %10s %12s %14s %14s\n", "query", "threads", "seconds", "MB/s", "rows/s", "MB/s/thread");
+
+	for (auto &query : QUERIES) {
+		if (!options.query.empty() && options.query != query.name) {
+			continue;
+		}
+		auto sql = StringUtil::Format(query.sql, source);
+		for (auto threads : options.threads) {
+			Run(con, "SET threads = " + std::to_string(threads));
+			double best = 0;
+			for (int i = 0; i < options.repeat; i++) {
+				auto start = std::chrono::steady_clock::now();
+				Run(con, sql);
+				std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+				if (i == 0 || elapsed.count() < best) {
+					best = elapsed.count();
+				}
+			}
+			auto mb_per_second = static_cast<double>(bytes) / (1 << 20) / best;
+			printf("%-16s %8d %10.3f %12.1f %14.0f %14.1f\n", query.name, threads, best, mb_per_second,
+			       static_cast<double>(rows) / best, mb_per_second / threads);
+		}
+	}
+	return 0;
+}
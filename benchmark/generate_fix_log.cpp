@@ -0,0 +1,630 @@
+// Deterministic generator of synthetic FIX 4.4 logs for the benchmarks
+// The same arguments produce the same bytes on every platform: the random numbers come from splitmix64
+// rather than <random>, whose distributions are implementation defined
+//
+// Usage: quackfix_generate_log <output> [--size 1GB] [--seed 42] [--delimiter pipe|soh]
+//                                       [--mix mixed|orders|marketdata] [--malformed 0.001] [--sessions 8]
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+class Rng {
+public:
+	explicit Rng(uint64_t seed) : state_(seed) {
+	}
+
+	uint64_t Next() {
+		uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	// Uniform in [0, n)
+	uint64_t Below(uint64_t n) {
+		return Next() % n;
+	}
+
+	// Uniform in [low, high]
+	int64_t Range(int64_t low, int64_t high) {
+		return low + static_cast<int64_t>(Below(static_cast<uint64_t>(high - low + 1)));
+	}
+
+	bool Chance(double p) {
+		return static_cast<double>(Next() >> 11) * (1.0 / 9007199254740992.0) < p;
+	}
+
+private:
+	uint64_t state_;
+};
+
+struct Options {
+	std::string output;
+	uint64_t size = 1ULL << 30;
+	uint64_t seed = 42;
+	char delimiter = '|';
+	std::string mix = "mixed";
+	double malformed = 0.001;
+	int sessions = 8;
+};
+
+// Kinds of malformed content, one is picked for a message with probability Options::malformed
+enum class Corruption { NONE, BAD_TIMESTAMP, BAD_SEQ_NUM, NO_EQUALS, BAD_TAG };
+
+struct Symbol {
+	const char *name;
+	int64_t base_ticks; // Price in cents
+};
+
+const Symbol SYMBOLS[] = {{"AAPL", 19050},  {"MSFT", 37425},  {"GOOGL", 13480}, {"AMZN", 14755}, {"TSLA", 25110},
+                          {"META", 33420},  {"NVDA", 48890},  {"JPM", 16985},   {"V", 25870},    {"JNJ", 15610},
+                          {"WMT", 16040},   {"PG", 14915},    {"XOM", 10025},   {"BAC", 3210},   {"KO", 5880},
+                          {"PFE", 2895},    {"DIS", 9130},    {"CSCO", 5010},   {"INTC", 4720},  {"ORCL", 10640},
+                          {"NFLX", 48720},  {"ADBE", 60120},  {"CRM", 25990},   {"AMD", 13830},  {"QCOM", 14250},
+                          {"IBM", 16150},   {"GS", 37580},    {"MS", 8930},     {"C", 5110},     {"WFC", 4860},
+                          {"T", 1650},      {"VZ", 3790},     {"CVX", 14830},   {"MRK", 10740},  {"ABBV", 15490},
+                          {"PEP", 16920},   {"COST", 64120},  {"MCD", 28710},   {"NKE", 10850},  {"SBUX", 9560},
+                          {"BA", 25320},    {"CAT", 28940},   {"GE", 12480},    {"MMM", 10550},  {"HON", 20130},
+                          {"UPS", 15720},   {"LMT", 45210},   {"SPY", 46980},   {"QQQ", 40550},  {"IWM", 19780}};
+constexpr size_t SYMBOL_COUNT = sizeof(SYMBOLS) / sizeof(SYMBOLS[0]);
+
+// Builds one message: header fields, then body fields, then BodyLength and CheckSum around them
+class MessageWriter {
+public:
+	explicit MessageWriter(char delimiter) : delimiter_(delimiter) {
+	}
+
+	void Begin(const char *msg_type, const std::string &sender, const std::string &target, int64_t seq_num,
+	           const std::string &sending_time, Corruption corruption) {
+		body_.clear();
+		corruption_ = corruption;
+		Field(35, msg_type);
+		Field(49, sender);
+		Field(56, target);
+		if (corruption == Corruption::BAD_SEQ_NUM) {
+			Field(34, std::to_string(seq_num) + "a");
+		} else {
+			Field(34, seq_num);
+		}
+		if (corruption == Corruption::BAD_TIMESTAMP) {
+			// Month 13, hour 25
+			auto bad = sending_time;
+			bad[4] = '1';
+			bad[5] = '3';
+			bad[9] = '2';
+			bad[10] = '5';
+			Field(52, bad);
+		} else {
+			Field(52, sending_time);
+		}
+	}
+
+	void Field(int tag, const char *value, size_t len) {
+		AppendInt(body_, tag);
+		body_ += '=';
+		body_.append(value, len);
+		body_ += delimiter_;
+	}
+
+	void Field(int tag, const char *value) {
+		Field(tag, value, strlen(value));
+	}
+
+	void Field(int tag, const std::string &value) {
+		Field(tag, value.data(), value.size());
+	}
+
+	void Field(int tag, int64_t value) {
+		AppendInt(body_, tag);
+		body_ += '=';
+		AppendInt(body_, value);
+		body_ += delimiter_;
+	}
+
+	// Price in cents, written with two decimals
+	void Price(int tag, int64_t ticks) {
+		AppendInt(body_, tag);
+		body_ += '=';
+		AppendInt(body_, ticks / 100);
+		body_ += '.';
+		body_ += static_cast<char>('0' + (ticks / 10) % 10);
+		body_ += static_cast<char>('0' + ticks % 10);
+		body_ += delimiter_;
+	}
+
+	// Append the finished message and a line break to out
+	void Finish(std::string &out) {
+		if (corruption_ == Corruption::NO_EQUALS) {
+			body_ += "garbage";
+			body_ += delimiter_;
+		} else if (corruption_ == Corruption::BAD_TAG) {
+			body_ += "x58=bad tag";
+			body_ += delimiter_;
+		}
+		auto start = out.size();
+		out += "8=FIX.4.4";
+		out += delimiter_;
+		out += "9=";
+		AppendInt(out, static_cast<int64_t>(body_.size()));
+		out += delimiter_;
+		out += body_;
+		unsigned checksum = 0;
+		for (auto i = start; i < out.size(); i++) {
+			checksum += static_cast<unsigned char>(out[i]);
+		}
+		checksum %= 256;
+		out += "10=";
+		out += static_cast<char>('0' + checksum / 100);
+		out += static_cast<char>('0' + (checksum / 10) % 10);
+		out += static_cast<char>('0' + checksum % 10);
+		out += delimiter_;
+		out += '\n';
+	}
+
+private:
+	static void AppendInt(std::string &out, int64_t value) {
+		char buffer[24];
+		auto end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+		out.append(buffer, static_cast<size_t>(end - buffer));
+	}
+
+	char delimiter_;
+	std::string body_;
+	Corruption corruption_ = Corruption::NONE;
+};
+
+// Milliseconds since 2023-12-15 00:00:00 to a FIX UTCTimestamp
+std::string FormatTimestamp(int64_t millis) {
+	// Civil date from days since 1970-01-01 (Howard Hinnant's algorithm)
+	int64_t days = 19706 + millis / 86400000;
+	int64_t ms_of_day = millis % 86400000;
+	days += 719468;
+	int64_t era = days / 146097;
+	int64_t doe = days - era * 146097;
+	int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	int64_t mp = (5 * doy + 2) / 153;
+	int64_t day = doy - (153 * mp + 2) / 5 + 1;
+	int64_t month = mp < 10 ? mp + 3 : mp - 9;
+	int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+	char buffer[64];
+	snprintf(buffer, sizeof(buffer), "%04lld%02lld%02lld-%02lld:%02lld:%02lld.%03lld", static_cast<long long>(year),
+	         static_cast<long long>(month), static_cast<long long>(day),
+	         static_cast<long long>(ms_of_day / 3600000), static_cast<long long>(ms_of_day / 60000 % 60),
+	         static_cast<long long>(ms_of_day / 1000 % 60), static_cast<long long>(ms_of_day % 1000));
+	return buffer;
+}
+
+// One direction of a FIX connection, with its own sequence numbers
+struct Session {
+	std::string sender;
+	std::string target;
+	int64_t next_seq = 1;
+};
+
+struct Order {
+	std::string cl_ord_id;
+	std::string order_id;
+	size_t symbol;
+	char side;
+	int64_t qty;
+	int64_t price;
+	int64_t cum_qty = 0;
+	int64_t notional = 0; // Sum of fill qty * price in cents, for AvgPx
+	size_t client;
+};
+
+class LogGenerator {
+public:
+	explicit LogGenerator(const Options &options) : options_(options), rng_(options.seed), writer_(options.delimiter) {
+		for (int i = 0; i < options.sessions; i++) {
+			auto client = "CLIENT" + std::to_string(i + 1);
+			to_broker_.push_back({client, "BROKER", 1});
+			from_broker_.push_back({"BROKER", client, 1});
+			market_data_.push_back({"MDFEED", client, 1});
+		}
+		for (size_t i = 0; i < SYMBOL_COUNT; i++) {
+			prices_.push_back(SYMBOLS[i].base_ticks);
+		}
+	}
+
+	// Append the messages of the next event to out, returns the number of messages
+	size_t NextEvent(std::string &out) {
+		if (!logged_on_) {
+			logged_on_ = true;
+			size_t count = 0;
+			for (auto sessions : {&to_broker_, &from_broker_, &market_data_}) {
+				for (auto &session : *sessions) {
+					Begin("A", session);
+					writer_.Field(98, static_cast<int64_t>(0));
+					writer_.Field(108, static_cast<int64_t>(30));
+					Finish(out);
+					count++;
+				}
+			}
+			return count;
+		}
+		AdvanceClock();
+
+		double orders_weight = 0.5, market_data_weight = 0.42;
+		if (options_.mix == "orders") {
+			orders_weight = 0.95;
+			market_data_weight = 0;
+		} else if (options_.mix == "marketdata") {
+			orders_weight = 0;
+			market_data_weight = 0.95;
+		}
+		auto pick = static_cast<double>(rng_.Below(1000000)) / 1000000.0;
+		if (pick < orders_weight) {
+			return OrderEvent(out);
+		}
+		if (pick < orders_weight + market_data_weight) {
+			return MarketDataEvent(out);
+		}
+		return AdminEvent(out);
+	}
+
+private:
+	void AdvanceClock() {
+		auto step = rng_.Range(0, 3);
+		if (step > 0) {
+			clock_ += step;
+			now_ = FormatTimestamp(clock_);
+		}
+	}
+
+	Corruption PickCorruption() {
+		if (options_.malformed <= 0 || !rng_.Chance(options_.malformed)) {
+			return Corruption::NONE;
+		}
+		return static_cast<Corruption>(1 + rng_.Below(4));
+	}
+
+	void Begin(const char *msg_type, Session &session) {
+		writer_.Begin(msg_type, session.sender, session.target, session.next_seq++, now_, PickCorruption());
+	}
+
+	void Finish(std::string &out) {
+		writer_.Finish(out);
+	}
+
+	// Random walk of the symbol's price, in cents
+	int64_t MovePrice(size_t symbol) {
+		auto &price = prices_[symbol];
+		price += rng_.Range(-3, 3);
+		if (price < 100) {
+			price = 100;
+		}
+		return price;
+	}
+
+	void Parties(const Order &order) {
+		writer_.Field(453, static_cast<int64_t>(2));
+		writer_.Field(448, to_broker_[order.client].sender);
+		writer_.Field(447, "D");
+		writer_.Field(452, static_cast<int64_t>(3));
+		writer_.Field(448, "DESK" + std::to_string(order.client % 3 + 1));
+		writer_.Field(447, "D");
+		writer_.Field(452, static_cast<int64_t>(11));
+	}
+
+	void OrderFields(const Order &order) {
+		writer_.Field(11, order.cl_ord_id);
+		writer_.Field(1, "ACC" + std::to_string(order.client + 1));
+		writer_.Field(55, SYMBOLS[order.symbol].name);
+		writer_.Field(54, &order.side, 1);
+		writer_.Field(38, order.qty);
+		writer_.Field(40, "2");
+		writer_.Price(44, order.price);
+		writer_.Field(59, "0");
+		writer_.Field(60, now_);
+	}
+
+	void ExecutionReport(std::string &out, const Order &order, const char *exec_type, const char *ord_status,
+	                     int64_t last_qty, int64_t last_px) {
+		Begin("8", from_broker_[order.client]);
+		writer_.Field(37, order.order_id);
+		writer_.Field(11, order.cl_ord_id);
+		writer_.Field(17, "E" + std::to_string(++exec_ids_));
+		writer_.Field(150, exec_type);
+		writer_.Field(39, ord_status);
+		writer_.Field(55, SYMBOLS[order.symbol].name);
+		writer_.Field(54, &order.side, 1);
+		writer_.Field(38, order.qty);
+		writer_.Price(44, order.price);
+		if (last_qty > 0) {
+			writer_.Price(31, last_px);
+			writer_.Field(32, last_qty);
+		}
+		writer_.Field(14, order.cum_qty);
+		bool done = strcmp(ord_status, "2") == 0 || strcmp(ord_status, "4") == 0;
+		writer_.Field(151, done ? 0 : order.qty - order.cum_qty);
+		writer_.Price(6, order.cum_qty > 0 ? order.notional / order.cum_qty : 0);
+		writer_.Field(60, now_);
+		if (last_qty > 0 && rng_.Chance(0.3)) {
+			writer_.Field(382, static_cast<int64_t>(1));
+			writer_.Field(375, "CB" + std::to_string(rng_.Range(1, 20)));
+			writer_.Field(437, last_qty);
+		}
+		Finish(out);
+	}
+
+	size_t NewOrder(std::string &out) {
+		Order order;
+		order.cl_ord_id = "C" + std::to_string(++order_ids_);
+		order.order_id = "O" + std::to_string(order_ids_);
+		order.symbol = rng_.Below(SYMBOL_COUNT);
+		order.side = rng_.Chance(0.5) ? '1' : '2';
+		order.qty = rng_.Range(1, 50) * 100;
+		order.price = MovePrice(order.symbol) + (order.side == '1' ? -rng_.Range(0, 5) : rng_.Range(0, 5));
+		order.client = rng_.Below(to_broker_.size());
+
+		Begin("D", to_broker_[order.client]);
+		OrderFields(order);
+		Parties(order);
+		Finish(out);
+
+		ExecutionReport(out, order, "0", "0", 0, 0);
+		open_orders_.push_back(std::move(order));
+		return 2;
+	}
+
+	void CloseOrder(size_t index) {
+		open_orders_[index] = std::move(open_orders_.back());
+		open_orders_.pop_back();
+	}
+
+	size_t OrderEvent(std::string &out) {
+		// Keep a working set of open orders, most events act on one of them
+		if (open_orders_.size() < 64 || rng_.Chance(0.3)) {
+			return NewOrder(out);
+		}
+		auto index = rng_.Below(open_orders_.size());
+		auto &order = open_orders_[index];
+		auto action = rng_.Below(100);
+		if (action < 70) {
+			// Partial or full fill
+			auto remaining = order.qty - order.cum_qty;
+			auto lots = remaining / 100;
+			auto last_qty = lots <= 1 || rng_.Chance(0.4) ? remaining : rng_.Range(1, lots) * 100;
+			auto last_px = order.price;
+			order.cum_qty += last_qty;
+			order.notional += last_qty * last_px;
+			bool filled = order.cum_qty == order.qty;
+			ExecutionReport(out, order, "F", filled ? "2" : "1", last_qty, last_px);
+			if (filled) {
+				CloseOrder(index);
+			}
+			return 1;
+		}
+		if (action < 85) {
+			// Cancel/replace to a new price
+			auto orig = order.cl_ord_id;
+			order.cl_ord_id = "C" + std::to_string(++order_ids_);
+			order.price = MovePrice(order.symbol);
+			Begin("G", to_broker_[order.client]);
+			writer_.Field(41, orig);
+			writer_.Field(37, order.order_id);
+			OrderFields(order);
+			Finish(out);
+			ExecutionReport(out, order, "5", order.cum_qty > 0 ? "1" : "0", 0, 0);
+			return 2;
+		}
+		// Cancel, rejected now and then
+		auto orig = order.cl_ord_id;
+		auto cancel_id = "C" + std::to_string(++order_ids_);
+		Begin("F", to_broker_[order.client]);
+		writer_.Field(41, orig);
+		writer_.Field(37, order.order_id);
+		writer_.Field(11, cancel_id);
+		writer_.Field(55, SYMBOLS[order.symbol].name);
+		writer_.Field(54, &order.side, 1);
+		writer_.Field(38, order.qty);
+		writer_.Field(60, now_);
+		Finish(out);
+		if (rng_.Chance(0.1)) {
+			Begin("9", from_broker_[order.client]);
+			writer_.Field(37, order.order_id);
+			writer_.Field(11, cancel_id);
+			writer_.Field(41, orig);
+			writer_.Field(39, order.cum_qty > 0 ? "1" : "0");
+			writer_.Field(434, "1");
+			writer_.Field(58, "Too late to cancel");
+			Finish(out);
+			return 2;
+		}
+		order.cl_ord_id = cancel_id;
+		ExecutionReport(out, order, "4", "4", 0, 0);
+		CloseOrder(index);
+		return 2;
+	}
+
+	// Snapshots carry 5-20 book levels, incremental refreshes 1-5 updates
+	size_t MarketDataEvent(std::string &out) {
+		auto &session = market_data_[rng_.Below(market_data_.size())];
+		auto symbol = rng_.Below(SYMBOL_COUNT);
+		auto mid = MovePrice(symbol);
+		if (rng_.Chance(0.2)) {
+			Begin("W", session);
+			writer_.Field(262, "MD" + std::to_string(++md_req_ids_));
+			writer_.Field(55, SYMBOLS[symbol].name);
+			auto levels = rng_.Range(5, 20);
+			writer_.Field(268, levels);
+			for (int64_t i = 0; i < levels; i++) {
+				bool bid = i % 2 == 0;
+				writer_.Field(269, bid ? "0" : "1");
+				writer_.Price(270, mid + (bid ? -(i / 2 + 1) : i / 2 + 1));
+				writer_.Field(271, rng_.Range(1, 100) * 100);
+				writer_.Field(290, i / 2 + 1);
+			}
+			Finish(out);
+			return 1;
+		}
+		Begin("X", session);
+		writer_.Field(262, "MD" + std::to_string(++md_req_ids_));
+		auto updates = rng_.Range(1, 5);
+		writer_.Field(268, updates);
+		for (int64_t i = 0; i < updates; i++) {
+			auto entry_type = rng_.Below(3);
+			writer_.Field(279, static_cast<int64_t>(rng_.Below(3)));
+			writer_.Field(269, static_cast<int64_t>(entry_type));
+			writer_.Field(55, SYMBOLS[symbol].name);
+			writer_.Price(270, mid + (entry_type == 0 ? -rng_.Range(1, 5) : rng_.Range(0, 5)));
+			writer_.Field(271, rng_.Range(1, 100) * 100);
+		}
+		Finish(out);
+		return 1;
+	}
+
+	// Heartbeats, test requests and now and then a resend with PossDupFlag
+	size_t AdminEvent(std::string &out) {
+		auto &session = to_broker_[rng_.Below(to_broker_.size())];
+		auto action = rng_.Below(100);
+		if (action < 80) {
+			Begin("0", session);
+			Finish(out);
+		} else if (action < 95) {
+			Begin("1", session);
+			writer_.Field(112, "T" + std::to_string(clock_));
+			Finish(out);
+		} else {
+			// Resend of an earlier message
+			auto seq = session.next_seq > 10 ? session.next_seq - rng_.Range(1, 10) : session.next_seq;
+			writer_.Begin("0", session.sender, session.target, seq, now_, PickCorruption());
+			writer_.Field(43, "Y");
+			writer_.Field(122, FormatTimestamp(clock_ - rng_.Range(1000, 5000)));
+			Finish(out);
+		}
+		return 1;
+	}
+
+	const Options &options_;
+	Rng rng_;
+	MessageWriter writer_;
+	std::vector<Session> to_broker_;
+	std::vector<Session> from_broker_;
+	std::vector<Session> market_data_;
+	std::vector<int64_t> prices_;
+	std::vector<Order> open_orders_;
+	// Starts at 08:00:00
+	int64_t clock_ = 8LL * 3600 * 1000;
+	std::string now_ = FormatTimestamp(clock_);
+	int64_t order_ids_ = 0;
+	int64_t exec_ids_ = 0;
+	int64_t md_req_ids_ = 0;
+	bool logged_on_ = false;
+};
+
+// 100, 64KB, 512MB, 2GB
+bool ParseSize(const char *text, uint64_t &result) {
+	char *end;
+	auto value = strtod(text, &end);
+	if (end == text || value <= 0) {
+		return false;
+	}
+	std::string unit(end);
+	uint64_t multiplier = 1;
+	if (unit == "KB" || unit == "K") {
+		multiplier = 1ULL << 10;
+	} else if (unit == "MB" || unit == "M") {
+		multiplier = 1ULL << 20;
+	} else if (unit == "GB" || unit == "G") {
+		multiplier = 1ULL << 30;
+	} else if (!unit.empty() && unit != "B") {
+		return false;
+	}
+	result = static_cast<uint64_t>(value * static_cast<double>(multiplier));
+	return true;
+}
+
+int Usage() {
+	fprintf(stderr, "usage: quackfix_generate_log <output> [--size 1GB] [--seed 42] [--delimiter pipe|soh]\n"
+	                "       [--mix mixed|orders|marketdata] [--malformed 0.001] [--sessions 8]\n");
+	return 1;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg.rfind("--", 0) != 0) {
+			if (!options.output.empty()) {
+				return Usage();
+			}
+			options.output = arg;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			return Usage();
+		}
+		const char *value = argv[++i];
+		if (arg == "--size") {
+			if (!ParseSize(value, options.size)) {
+				return Usage();
+			}
+		} else if (arg == "--seed") {
+			options.seed = strtoull(value, nullptr, 10);
+		} else if (arg == "--delimiter") {
+			if (strcmp(value, "soh") == 0) {
+				options.delimiter = '\x01';
+			} else if (strcmp(value, "pipe") == 0) {
+				options.delimiter = '|';
+			} else {
+				return Usage();
+			}
+		} else if (arg == "--mix") {
+			options.mix = value;
+			if (options.mix != "mixed" && options.mix != "orders" && options.mix != "marketdata") {
+				return Usage();
+			}
+		} else if (arg == "--malformed") {
+			options.malformed = strtod(value, nullptr);
+		} else if (arg == "--sessions") {
+			options.sessions = atoi(value);
+			if (options.sessions <= 0) {
+				return Usage();
+			}
+		} else {
+			return Usage();
+		}
+	}
+	if (options.output.empty()) {
+		return Usage();
+	}
+
+	auto file = fopen(options.output.c_str(), "wb");
+	if (!file) {
+		fprintf(stderr, "cannot open %s\n", options.output.c_str());
+		return 1;
+	}
+	LogGenerator generator(options);
+	std::string buffer;
+	uint64_t written = 0;
+	uint64_t messages = 0;
+	while (written < options.size) {
+		buffer.clear();
+		while (buffer.size() < (1 << 20) && written + buffer.size() < options.size) {
+			messages += generator.NextEvent(buffer);
+		}
+		if (fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+			fprintf(stderr, "write to %s failed\n", options.output.c_str());
+			fclose(file);
+			return 1;
+		}
+		written += buffer.size();
+	}
+	fclose(file);
+	fprintf(stderr, "%s: %llu messages, %llu bytes\n", options.output.c_str(),
+	        static_cast<unsigned long long>(messages), static_cast<unsigned long long>(written));
+	return 0;
+}
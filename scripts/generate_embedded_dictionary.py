@@ -1,78 +1,299 @@
 #!/usr/bin/env python3
 """
-Generate embedded FIX dictionary as a byte array.
+Compile a QuickFIX XML dictionary into static C++ tables.
 
-This script converts the FIX dictionary XML into a C++ byte array to avoid
-MSVC's 16KB string literal limitation while remaining cross-platform compatible.
+The generated source defines a FixDictionaryTables instance (see
+src/dictionary/fix_dictionary_tables.hpp) and an accessor function returning it.
+BuildFixDictionary() turns the tables into a FixDictionary without parsing XML.
+
+The tables reproduce FixDictionaryLoader exactly, including the order in which
+entries are inserted into the dictionary's maps, so a compiled dictionary and
+the same XML loaded at runtime give identical results.
+
+The build uses this script for the embedded FIX 4.4 dictionary; it can also be
+run offline to precompile venue dictionaries:
+
+    generate_embedded_dictionary.py <dictionary.xml> <output.cpp> [accessor_name]
 """
 
-import sys
 import os
+import sys
+import xml.etree.ElementTree as ET
+
+DEFAULT_ACCESSOR = 'GetEmbeddedFix44Tables'
+
+
+class Group:
+    def __init__(self):
+        self.count_tag = 0
+        self.field_tags = []
+        self.subgroups = {}  # count tag -> group index, in first insertion order
+        self.component_refs = []
+        self.leading_tag = 0
+        self.leading_component = None
+
+
+class Component:
+    def __init__(self, name):
+        self.name = name
+        self.field_tags = []
+        self.groups = {}
+        self.component_refs = []
+        self.leading_tag = 0
+        self.leading_component = None
+
+
+class Message:
+    def __init__(self, name, msg_type):
+        self.name = name
+        self.msg_type = msg_type
+        self.required_fields = []
+        self.optional_fields = []
+        self.groups = {}
+        self.component_refs = []
+
+
+class Dictionary:
+    """Mirror of FixDictionaryLoader; dicts keep the loader's map insertion order."""
+
+    def __init__(self):
+        self.fields = {}  # tag -> (name, type, [(enum, description)])
+        self.name_to_tag = {}
+        self.groups = []  # every loaded group, referenced by index
+        self.components = {}
+        self.messages = {}
+
+    def tag_of(self, name):
+        # std::unordered_map::operator[] inserts missing names with tag 0
+        return self.name_to_tag.setdefault(name, 0)
+
+    def load_fields(self, fields_root):
+        for field in fields_root.findall('field'):
+            tag = int(field.get('number', '0'))
+            name = field.get('name')
+            enums = [(value.get('enum'), value.get('description')) for value in field.findall('value')]
+            self.name_to_tag[name] = tag
+            self.fields[tag] = (name, field.get('type'), enums)
+
+    def load_leading_child(self, parent, target):
+        children = list(parent)
+        if not children or children[0].get('name') is None:
+            return
+        first = children[0]
+        if first.tag == 'component':
+            target.leading_component = first.get('name')
+        elif first.get('name') in self.name_to_tag:
+            target.leading_tag = self.name_to_tag[first.get('name')]
+
+    def load_group(self, element):
+        name = element.get('name')
+        if name is None:
+            raise ValueError('Group node missing name attr')
+        group = Group()
+        group.count_tag = self.tag_of(name)
+        for field in element.findall('field'):
+            group.field_tags.append(self.tag_of(field.get('name')))
+        for sub in element.findall('group'):
+            sub_idx = self.load_group(sub)
+            group.subgroups[self.groups[sub_idx].count_tag] = sub_idx
+        for comp in element.findall('component'):
+            if comp.get('name') is not None:
+                group.component_refs.append(comp.get('name'))
+        self.load_leading_child(element, group)
+        self.groups.append(group)
+        return len(self.groups) - 1
+
+    def load_components(self, components_root):
+        for element in components_root.findall('component'):
+            comp = Component(element.get('name'))
+            for field in element.findall('field'):
+                if field.get('name') is not None:
+                    comp.field_tags.append(self.tag_of(field.get('name')))
+            for group_element in element.findall('group'):
+                group_idx = self.load_group(group_element)
+                comp.groups[self.groups[group_idx].count_tag] = group_idx
+            for ref in element.findall('component'):
+                if ref.get('name') is not None:
+                    comp.component_refs.append(ref.get('name'))
+            self.load_leading_child(element, comp)
+            self.components[comp.name] = comp
+
+    def expand_component(self, msg, ref):
+        name = ref.get('name')
+        if name is None or name not in self.components:
+            return
+        comp = self.components[name]
+        target = msg.required_fields if ref.get('required') == 'Y' else msg.optional_fields
+        target.extend(comp.field_tags)
+        for count_tag in sorted(comp.groups):
+            msg.groups[count_tag] = comp.groups[count_tag]
+
+    def load_messages(self, messages_root):
+        for element in messages_root.findall('message'):
+            msg = Message(element.get('name'), element.get('msgtype'))
+            for child in element:
+                if child.tag == 'field':
+                    tag = self.tag_of(child.get('name'))
+                    if child.get('required') == 'Y':
+                        msg.required_fields.append(tag)
+                    else:
+                        msg.optional_fields.append(tag)
+                elif child.tag == 'group':
+                    group_idx = self.load_group(child)
+                    msg.groups[self.groups[group_idx].count_tag] = group_idx
+                elif child.tag == 'component':
+                    self.expand_component(msg, child)
+                    if child.get('name') is not None:
+                        msg.component_refs.append(child.get('name'))
+            self.messages[msg.msg_type] = msg
+
+    def load(self, xml_path):
+        root = ET.parse(xml_path).getroot()
+        for section, loader in (('fields', self.load_fields), ('components', self.load_components),
+                                ('messages', self.load_messages)):
+            element = root.find(section)
+            if element is not None:
+                loader(element)
+
+
+def cpp_string(value):
+    if value is None:
+        return 'nullptr'
+    out = []
+    for byte in value.encode('utf-8'):
+        char = chr(byte)
+        if char in '\\"':
+            out.append('\\' + char)
+        elif 32 <= byte < 127:
+            out.append(char)
+        else:
+            out.append('\\%03o' % byte)
+    return '"' + ''.join(out) + '"'
+
+
+class Pools:
+    """Shared arrays that the tables index into."""
+
+    def __init__(self):
+        self.tags = []
+        self.group_refs = []
+        self.names = []
+
+    def add_tags(self, tags):
+        begin = len(self.tags)
+        self.tags.extend(tags)
+        return begin, len(tags)
+
+    def add_group_refs(self, groups):
+        begin = len(self.group_refs)
+        self.group_refs.extend(groups.items())
+        return begin, len(groups)
+
+    def add_names(self, names):
+        begin = len(self.names)
+        self.names.extend(names)
+        return begin, len(names)
+
+
+def write_array(f, type_name, name, rows):
+    f.write(f'static constexpr {type_name} {name}[] = {{\n')
+    for row in rows:
+        f.write(f'    {row},\n')
+    if not rows:
+        # Zero-length arrays are not valid C++
+        f.write('    {},\n')
+    f.write('};\n\n')
+
+
+def generate_cpp(dictionary, xml_name, accessor, output_path):
+    pools = Pools()
+
+    enums = []
+    field_rows = []
+    for tag in sorted(dictionary.fields):
+        name, field_type, field_enums = dictionary.fields[tag]
+        enum_begin = len(enums)
+        enums.extend(field_enums)
+        field_rows.append(f'{{{tag}, {cpp_string(name)}, {cpp_string(field_type)}, {enum_begin}, {len(field_enums)}}}')
+    enum_rows = [f'{{{cpp_string(value)}, {cpp_string(description)}}}' for value, description in enums]
+
+    group_rows = []
+    for group in dictionary.groups:
+        fields = pools.add_tags(group.field_tags)
+        subgroups = pools.add_group_refs(group.subgroups)
+        refs = pools.add_names(group.component_refs)
+        group_rows.append(f'{{{group.count_tag}, {fields[0]}, {fields[1]}, {subgroups[0]}, {subgroups[1]}, '
+                          f'{refs[0]}, {refs[1]}, {group.leading_tag}, {cpp_string(group.leading_component)}}}')
+
+    component_rows = []
+    for comp in dictionary.components.values():
+        fields = pools.add_tags(comp.field_tags)
+        groups = pools.add_group_refs(comp.groups)
+        refs = pools.add_names(comp.component_refs)
+        component_rows.append(f'{{{cpp_string(comp.name)}, {fields[0]}, {fields[1]}, {groups[0]}, {groups[1]}, '
+                              f'{refs[0]}, {refs[1]}, {comp.leading_tag}, {cpp_string(comp.leading_component)}}}')
+
+    message_rows = []
+    for msg in dictionary.messages.values():
+        required = pools.add_tags(msg.required_fields)
+        optional = pools.add_tags(msg.optional_fields)
+        groups = pools.add_group_refs(msg.groups)
+        refs = pools.add_names(msg.component_refs)
+        message_rows.append(f'{{{cpp_string(msg.name)}, {cpp_string(msg.msg_type)}, {required[0]}, {required[1]}, '
+                            f'{optional[0]}, {optional[1]}, {groups[0]}, {groups[1]}, {refs[0]}, {refs[1]}}}')
+
+    name_rows = [f'{{{cpp_string(name)}, {tag}}}' for name, tag in dictionary.name_to_tag.items()]
 
-def read_dictionary_xml(xml_path):
-    """Read the XML content from file."""
-    with open(xml_path, 'r', encoding='utf-8') as f:
-        xml_content = f.read()
-    return xml_content
-
-def generate_byte_array_cpp(xml_content, output_path):
-    """Generate C++ source file with byte array."""
-    
-    # Convert string to bytes
-    xml_bytes = xml_content.encode('utf-8')
-    
     with open(output_path, 'w', encoding='utf-8') as f:
         f.write('// Auto-generated file - DO NOT EDIT\n')
-        f.write('// Generated from FIX 4.4 dictionary XML\n')
-        f.write('// This file is generated at build time by scripts/generate_embedded_dictionary.py\n\n')
-        f.write('#include "dictionary/embedded_fix44_dictionary.hpp"\n')
-        f.write('#include <string>\n\n')
+        f.write(f'// Compiled from {xml_name} by scripts/generate_embedded_dictionary.py\n\n')
+        f.write('#include "dictionary/fix_dictionary_tables.hpp"\n\n')
         f.write('namespace duckdb {\n\n')
-        f.write('// Embedded FIX 4.4 dictionary as byte array\n')
-        f.write('static const unsigned char embedded_fix44_dict_data[] = {\n')
-        
-        # Write bytes in groups of 12 per line
-        bytes_per_line = 12
-        for i in range(0, len(xml_bytes), bytes_per_line):
-            chunk = xml_bytes[i:i+bytes_per_line]
-            hex_values = ', '.join(f'0x{b:02x}' for b in chunk)
-            f.write(f'    {hex_values}')
-            if i + bytes_per_line < len(xml_bytes):
-                f.write(',\n')
-            else:
-                f.write('\n')
-        
+        write_array(f, 'FixTableField', 'FIELDS', field_rows)
+        write_array(f, 'FixTableEnum', 'ENUMS', enum_rows)
+        write_array(f, 'FixTableGroup', 'GROUPS', group_rows)
+        write_array(f, 'FixTableComponent', 'COMPONENTS', component_rows)
+        write_array(f, 'FixTableMessage', 'MESSAGES', message_rows)
+        write_array(f, 'FixTableNameTag', 'NAMES', name_rows)
+        write_array(f, 'int', 'TAGS', [str(tag) for tag in pools.tags])
+        write_array(f, 'FixTableGroupRef', 'GROUP_REFS', [f'{{{tag}, {idx}}}' for tag, idx in pools.group_refs])
+        write_array(f, 'const char *', 'COMPONENT_REFS', [cpp_string(name) for name in pools.names])
+
+        counts = [len(field_rows), len(enum_rows), len(group_rows), len(component_rows), len(message_rows),
+                  len(name_rows)]
+        f.write('static constexpr FixDictionaryTables TABLES = {\n')
+        f.write(f'    FIELDS, {counts[0]}, ENUMS, {counts[1]}, GROUPS, {counts[2]}, COMPONENTS, {counts[3]},\n')
+        f.write(f'    MESSAGES, {counts[4]}, NAMES, {counts[5]}, TAGS, GROUP_REFS, COMPONENT_REFS,\n')
         f.write('};\n\n')
-        f.write(f'static const size_t embedded_fix44_dict_size = {len(xml_bytes)};\n\n')
-        
-        # Generate accessor function
-        f.write('std::string GetEmbeddedFix44Dictionary() {\n')
-        f.write('    return std::string(\n')
-        f.write('        reinterpret_cast<const char*>(embedded_fix44_dict_data),\n')
-        f.write('        embedded_fix44_dict_size\n')
-        f.write('    );\n')
+        f.write(f'const FixDictionaryTables &{accessor}() {{\n')
+        f.write('    return TABLES;\n')
         f.write('}\n\n')
         f.write('} // namespace duckdb\n')
+    return counts
+
 
 def main():
-    if len(sys.argv) != 3:
-        print("Usage: generate_embedded_dictionary.py <input_header> <output_cpp>")
+    if len(sys.argv) not in (3, 4):
+        print("Usage: generate_embedded_dictionary.py <dictionary_xml> <output_cpp> [accessor_name]")
         sys.exit(1)
-    
-    input_header = sys.argv[1]
+
+    input_xml = sys.argv[1]
     output_cpp = sys.argv[2]
-    
-    if not os.path.exists(input_header):
-        print(f"Error: Input file not found: {input_header}")
+    accessor = sys.argv[3] if len(sys.argv) == 4 else DEFAULT_ACCESSOR
+
+    if not os.path.exists(input_xml):
+        print(f"Error: Input file not found: {input_xml}")
         sys.exit(1)
-    
-    print(f"Reading dictionary from: {input_header}")
-    xml_content = read_dictionary_xml(input_header)
-    print(f"Dictionary size: {len(xml_content)} characters")
-    
-    print(f"Generating byte array in: {output_cpp}")
-    generate_byte_array_cpp(xml_content, output_cpp)
+
+    print(f"Reading dictionary from: {input_xml}")
+    dictionary = Dictionary()
+    dictionary.load(input_xml)
+
+    print(f"Generating dictionary tables in: {output_cpp}")
+    counts = generate_cpp(dictionary, os.path.basename(input_xml), accessor, output_cpp)
+    print(f"Fields: {counts[0]}, groups: {counts[2]}, components: {counts[3]}, messages: {counts[4]}")
     print("Done!")
 
+
 if __name__ == '__main__':
     main()
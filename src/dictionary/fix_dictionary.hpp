@@ -29,6 +29,9 @@ struct FixGroupDef {
 	int count_tag;                                                   // e.g. 268 = NoMDEntries
 	std::vector<int> field_tags;                                     // tags within group
 	std::unordered_map<int, std::shared_ptr<FixGroupDef>> subgroups; // nested groups
+	std::vector<std::string> component_refs;                         // components used in the group
+	int leading_tag = 0;                                             // first child: a field or a nested group
+	std::string leading_component;                                   // first child: a component
 };
 
 // -------------------------------
@@ -42,6 +45,7 @@ struct FixMessageDef {
 	std::vector<int> optional_fields;
 
 	std::unordered_map<int, std::shared_ptr<FixGroupDef>> groups;
+	std::vector<std::string> component_refs; // components used in the message (already expanded one level)
 };
 
 // -------------------------------
@@ -51,6 +55,9 @@ struct FixComponentDef {
 	std::string name;
 	std::vector<int> field_tags;
 	std::unordered_map<int, std::shared_ptr<FixGroupDef>> groups;
+	std::vector<std::string> component_refs; // components used in the component
+	int leading_tag = 0;                     // first child: a field or a group
+	std::string leading_component;           // first child: a component
 };
 
 // -------------------------------
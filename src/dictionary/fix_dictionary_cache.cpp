@@ -0,0 +1,102 @@
+#include "fix_dictionary_cache.hpp"
+#include "xml_loader.hpp"
+#include "dictionary/embedded_fix44_dictionary.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+namespace duckdb {
+
+// Cache key prefix, file dictionaries are keyed by prefix + path
+static constexpr const char *FIX_DICTIONARY_CACHE_PREFIX = "quackfix_dictionary:";
+static constexpr const char *FIX_EMBEDDED_DICTIONARY_KEY = "quackfix_dictionary";
+
+class FixDictionaryCacheEntry : public ObjectCacheEntry {
+public:
+	FixDictionaryCacheEntry(shared_ptr<const FixDictionary> dictionary_p, idx_t file_size_p, int64_t modified_p)
+	    : dictionary(std::move(dictionary_p)), group_layout(std::make_shared<FixGroupLayout>(*dictionary)),
+	      file_size(file_size_p), modified(modified_p) {
+	}
+
+	shared_ptr<const FixDictionary> dictionary;
+	// Compiled from dictionary, shared by every scan that uses it
+	std::shared_ptr<const FixGroupLayout> group_layout;
+	// Size and modification time of the file the dictionary was parsed from
+	idx_t file_size;
+	int64_t modified;
+
+	static string ObjectType() {
+		return "quackfix_dictionary";
+	}
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	// Not accounted against the object cache size
+	optional_idx GetEstimatedCacheMemory() const override {
+		return optional_idx();
+	}
+};
+
+// File systems report modification times as timestamp_t or time_t depending on the DuckDB version
+static int64_t ModifiedValue(timestamp_t modified) {
+	return modified.value;
+}
+
+static int64_t ModifiedValue(time_t modified) {
+	return static_cast<int64_t>(modified);
+}
+
+static shared_ptr<const FixDictionary> ParseEmbedded() {
+	return make_shared_ptr<FixDictionary>(BuildFixDictionary(GetEmbeddedFix44Tables()));
+}
+
+void FixDictionaryCache::LoadEmbedded(DatabaseInstance &db) {
+	auto &cache = db.GetObjectCache();
+	if (!cache.Get<FixDictionaryCacheEntry>(FIX_EMBEDDED_DICTIONARY_KEY)) {
+		cache.Put(FIX_EMBEDDED_DICTIONARY_KEY, make_shared_ptr<FixDictionaryCacheEntry>(ParseEmbedded(), 0, 0));
+	}
+}
+
+shared_ptr<const FixDictionary> FixDictionaryCache::Get(ClientContext &context, const string &path) {
+	std::shared_ptr<const FixGroupLayout> group_layout;
+	return Get(context, path, group_layout);
+}
+
+shared_ptr<const FixDictionary> FixDictionaryCache::Get(ClientContext &context, const string &path,
+                                                        std::shared_ptr<const FixGroupLayout> &group_layout) {
+	auto &cache = ObjectCache::GetObjectCache(context);
+	if (path.empty()) {
+		auto entry = cache.Get<FixDictionaryCacheEntry>(FIX_EMBEDDED_DICTIONARY_KEY);
+		if (!entry) {
+			entry = make_shared_ptr<FixDictionaryCacheEntry>(ParseEmbedded(), 0, 0);
+			cache.Put(FIX_EMBEDDED_DICTIONARY_KEY, entry);
+		}
+		group_layout = entry->group_layout;
+		return entry->dictionary;
+	}
+
+	// A cached dictionary is used while the file still has the size and modification time it was parsed with
+	idx_t file_size;
+	int64_t modified;
+	{
+		auto &fs = FileSystem::GetFileSystem(context);
+		auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_READ);
+		file_size = fs.GetFileSize(*handle);
+		modified = ModifiedValue(fs.GetLastModifiedTime(*handle));
+	}
+	auto key = FIX_DICTIONARY_CACHE_PREFIX + path;
+	auto entry = cache.Get<FixDictionaryCacheEntry>(key);
+	if (!entry || entry->file_size != file_size || entry->modified != modified) {
+		// Concurrent misses may parse the same file twice; either result is valid
+		auto dictionary = make_shared_ptr<FixDictionary>(FixDictionaryLoader::LoadBase(context, path));
+		entry = make_shared_ptr<FixDictionaryCacheEntry>(std::move(dictionary), file_size, modified);
+		cache.Put(key, entry);
+	}
+	group_layout = entry->group_layout;
+	return entry->dictionary;
+}
+
+} // namespace duckdb
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "dictionary/fix_dictionary.hpp"
+#include "parser/fix_group_layout.hpp"
+
+#include <memory>
+
+namespace duckdb {
+
+class DatabaseInstance;
+
+// Parsed dictionaries shared by all queries of a database, held in its ObjectCache
+// Dictionary files are keyed by path and re-parsed only when their size or modification time changes;
+// the embedded FIX 4.4 dictionary is parsed once, when the extension is loaded
+class FixDictionaryCache {
+public:
+	// The dictionary at path, or the embedded FIX 4.4 dictionary if path is empty
+	// Throws if the dictionary can not be read or parsed
+	static shared_ptr<const FixDictionary> Get(ClientContext &context, const string &path);
+	// Same, also returning the dictionary's groups compiled for FixGroupParser and the tokenizer, built once per
+	// cached dictionary
+	static shared_ptr<const FixDictionary> Get(ClientContext &context, const string &path,
+	                                           std::shared_ptr<const FixGroupLayout> &group_layout);
+
+	// Parse the embedded dictionary into the cache of db
+	static void LoadEmbedded(DatabaseInstance &db);
+};
+
+} // namespace duckdb
@@ -0,0 +1,83 @@
+#include "fix_dictionary_tables.hpp"
+
+namespace duckdb {
+
+static std::vector<int> TableTags(const FixDictionaryTables &tables, uint32_t begin, uint32_t count) {
+	return std::vector<int>(tables.tags + begin, tables.tags + begin + count);
+}
+
+static std::vector<std::string> TableComponentRefs(const FixDictionaryTables &tables, uint32_t begin, uint32_t count) {
+	return std::vector<std::string>(tables.component_refs + begin, tables.component_refs + begin + count);
+}
+
+FixDictionary BuildFixDictionary(const FixDictionaryTables &tables) {
+	FixDictionary dict;
+
+	for (size_t i = 0; i < tables.field_count; i++) {
+		auto &field = tables.fields[i];
+		FixFieldDef def;
+		def.tag = field.tag;
+		def.name = field.name;
+		def.type = field.type;
+		def.enums.reserve(field.enum_count);
+		for (uint32_t e = field.enum_begin; e < field.enum_begin + field.enum_count; e++) {
+			def.enums.push_back({tables.enums[e].value, tables.enums[e].description});
+		}
+		dict.fields.emplace(def.tag, std::move(def));
+	}
+	for (size_t i = 0; i < tables.name_count; i++) {
+		dict.name_to_tag.emplace(tables.names[i].name, tables.names[i].tag);
+	}
+
+	// Groups only reference groups loaded before them, so one pass in table order resolves every subgroup
+	std::vector<std::shared_ptr<FixGroupDef>> groups(tables.group_count);
+	for (size_t i = 0; i < tables.group_count; i++) {
+		auto &group = tables.groups[i];
+		auto def = std::make_shared<FixGroupDef>();
+		def->count_tag = group.count_tag;
+		def->field_tags = TableTags(tables, group.field_begin, group.field_count);
+		for (uint32_t s = group.subgroup_begin; s < group.subgroup_begin + group.subgroup_count; s++) {
+			def->subgroups[tables.group_refs[s].count_tag] = groups[tables.group_refs[s].group];
+		}
+		def->component_refs = TableComponentRefs(tables, group.component_begin, group.component_count);
+		def->leading_tag = group.leading_tag;
+		if (group.leading_component) {
+			def->leading_component = group.leading_component;
+		}
+		groups[i] = std::move(def);
+	}
+
+	for (size_t i = 0; i < tables.component_count; i++) {
+		auto &component = tables.components[i];
+		FixComponentDef def;
+		def.name = component.name;
+		def.field_tags = TableTags(tables, component.field_begin, component.field_count);
+		for (uint32_t g = component.group_begin; g < component.group_begin + component.group_count; g++) {
+			def.groups[tables.group_refs[g].count_tag] = groups[tables.group_refs[g].group];
+		}
+		def.component_refs = TableComponentRefs(tables, component.component_begin, component.component_count);
+		def.leading_tag = component.leading_tag;
+		if (component.leading_component) {
+			def.leading_component = component.leading_component;
+		}
+		dict.components.emplace(def.name, std::move(def));
+	}
+
+	for (size_t i = 0; i < tables.message_count; i++) {
+		auto &message = tables.messages[i];
+		FixMessageDef def;
+		def.name = message.name;
+		def.msg_type = message.msg_type;
+		def.required_fields = TableTags(tables, message.required_begin, message.required_count);
+		def.optional_fields = TableTags(tables, message.optional_begin, message.optional_count);
+		for (uint32_t g = message.group_begin; g < message.group_begin + message.group_count; g++) {
+			def.groups[tables.group_refs[g].count_tag] = groups[tables.group_refs[g].group];
+		}
+		def.component_refs = TableComponentRefs(tables, message.component_begin, message.component_count);
+		dict.messages.emplace(def.msg_type, std::move(def));
+	}
+
+	return dict;
+}
+
+} // namespace duckdb
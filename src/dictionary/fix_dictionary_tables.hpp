@@ -0,0 +1,97 @@
+#pragma once
+
+#include "dictionary/fix_dictionary.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace duckdb {
+
+// A FIX dictionary compiled into static tables by scripts/generate_embedded_dictionary.py
+// Ranges (begin, count) index the shared TAGS, GROUP_REFS and COMPONENT_REFS arrays; groups are referenced by
+// their index in the groups table. Messages, components, group maps and names are listed in the order
+// FixDictionaryLoader inserts them, so that the built dictionary iterates exactly like a loaded one
+
+struct FixTableField {
+	int tag;
+	const char *name;
+	const char *type;
+	uint32_t enum_begin;
+	uint32_t enum_count;
+};
+
+struct FixTableEnum {
+	const char *value;
+	const char *description;
+};
+
+// {count tag, group index}
+struct FixTableGroupRef {
+	int count_tag;
+	uint32_t group;
+};
+
+struct FixTableGroup {
+	int count_tag;
+	uint32_t field_begin;
+	uint32_t field_count;
+	uint32_t subgroup_begin;
+	uint32_t subgroup_count;
+	uint32_t component_begin;
+	uint32_t component_count;
+	int leading_tag;
+	const char *leading_component; // nullptr if the group does not start with a component
+};
+
+struct FixTableComponent {
+	const char *name;
+	uint32_t field_begin;
+	uint32_t field_count;
+	uint32_t group_begin;
+	uint32_t group_count;
+	uint32_t component_begin;
+	uint32_t component_count;
+	int leading_tag;
+	const char *leading_component;
+};
+
+struct FixTableMessage {
+	const char *name;
+	const char *msg_type;
+	uint32_t required_begin;
+	uint32_t required_count;
+	uint32_t optional_begin;
+	uint32_t optional_count;
+	uint32_t group_begin;
+	uint32_t group_count;
+	uint32_t component_begin;
+	uint32_t component_count;
+};
+
+struct FixTableNameTag {
+	const char *name;
+	int tag;
+};
+
+struct FixDictionaryTables {
+	// Sorted by tag
+	const FixTableField *fields;
+	size_t field_count;
+	const FixTableEnum *enums;
+	size_t enum_count;
+	const FixTableGroup *groups;
+	size_t group_count;
+	const FixTableComponent *components;
+	size_t component_count;
+	const FixTableMessage *messages;
+	size_t message_count;
+	const FixTableNameTag *names;
+	size_t name_count;
+	const int *tags;
+	const FixTableGroupRef *group_refs;
+	const char *const *component_refs;
+};
+
+// Build a dictionary from compiled tables, without parsing XML
+FixDictionary BuildFixDictionary(const FixDictionaryTables &tables);
+
+} // namespace duckdb
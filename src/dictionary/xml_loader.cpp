@@ -125,6 +125,24 @@ void FixDictionaryLoader::LoadFields(FixDictionary &dict, tinyxml2::XMLElement *
 // ===========================================================
 // GROUP LOADER (recursive)
 // ===========================================================
+// The first child of a group (or of a component starting one) starts every instance: record its tag,
+// or the component it comes from
+void FixDictionaryLoader::LoadLeadingChild(FixDictionary &dict, tinyxml2::XMLElement *parent, int &leading_tag,
+                                           std::string &leading_component) {
+	auto *first = parent->FirstChildElement();
+	if (!first || !first->Attribute("name")) {
+		return;
+	}
+	if (strcmp(first->Name(), "component") == 0) {
+		leading_component = first->Attribute("name");
+		return;
+	}
+	auto it = dict.name_to_tag.find(first->Attribute("name"));
+	if (it != dict.name_to_tag.end()) {
+		leading_tag = it->second;
+	}
+}
+
 FixGroupDef FixDictionaryLoader::LoadGroup(FixDictionary &dict, tinyxml2::XMLElement *group) {
 	FixGroupDef g;
 
@@ -150,6 +168,15 @@ FixGroupDef FixDictionaryLoader::LoadGroup(FixDictionary &dict, tinyxml2::XMLEle
 		g.subgroups[sub_def.count_tag] = std::make_shared<FixGroupDef>(sub_def);
 	}
 
+	// components used in the group, resolved by name when the dictionary is compiled
+	for (tinyxml2::XMLElement *comp = group->FirstChildElement("component"); comp != nullptr;
+	     comp = comp->NextSiblingElement("component")) {
+		if (const char *comp_name = comp->Attribute("name")) {
+			g.component_refs.push_back(comp_name);
+		}
+	}
+	LoadLeadingChild(dict, group, g.leading_tag, g.leading_component);
+
 	return g;
 }
 
@@ -178,6 +205,15 @@ void FixDictionaryLoader::LoadComponents(FixDictionary &dict, tinyxml2::XMLEleme
 			c.groups[g.count_tag] = std::make_shared<FixGroupDef>(g);
 		}
 
+		// components used in component (may be defined later in the file)
+		for (tinyxml2::XMLElement *ref = comp->FirstChildElement("component"); ref != nullptr;
+		     ref = ref->NextSiblingElement("component")) {
+			if (const char *ref_name = ref->Attribute("name")) {
+				c.component_refs.push_back(ref_name);
+			}
+		}
+		LoadLeadingChild(dict, comp, c.leading_tag, c.leading_component);
+
 		dict.components[c.name] = c;
 	}
 }
@@ -253,6 +289,9 @@ void FixDictionaryLoader::LoadMessages(FixDictionary &dict, tinyxml2::XMLElement
 			} else if (strcmp(child_name, "component") == 0) {
 				// Component reference - expand it
 				ExpandComponent(dict, m, child);
+				if (const char *comp_name = child->Attribute("name")) {
+					m.component_refs.push_back(comp_name);
+				}
 			}
 		}
 
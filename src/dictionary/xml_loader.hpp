@@ -21,5 +21,7 @@ private:
 	static void LoadComponents(FixDictionary &dict, tinyxml2::XMLElement *components_root);
 	static void LoadMessages(FixDictionary &dict, tinyxml2::XMLElement *messages_root);
 	static FixGroupDef LoadGroup(FixDictionary &dict, tinyxml2::XMLElement *group);
+	static void LoadLeadingChild(FixDictionary &dict, tinyxml2::XMLElement *parent, int &leading_tag,
+	                             std::string &leading_component);
 	static void ExpandComponent(FixDictionary &dict, FixMessageDef &msg, tinyxml2::XMLElement *comp_ref);
 };
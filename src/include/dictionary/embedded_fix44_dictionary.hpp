@@ -1,16 +1,15 @@
 #pragma once
 
-#include <string>
+#include "dictionary/fix_dictionary_tables.hpp"
 
 // Embedded FIX 4.4 dictionary
 // This allows the extension to work without requiring external dictionary files
-// The actual data is generated at build time from the XML and stored as a byte array
-// to avoid MSVC's 16KB string literal limitation.
+// The dictionary is compiled at build time from the XML into static tables, so loading it does not parse XML
 namespace duckdb {
 
-// Returns the embedded FIX 4.4 dictionary XML as a string
+// Returns the tables of the embedded FIX 4.4 dictionary, build it with BuildFixDictionary()
 // The implementation is in src/dictionary/embedded_fix44_dictionary.cpp
 // which is auto-generated at build time
-std::string GetEmbeddedFix44Dictionary();
+const FixDictionaryTables &GetEmbeddedFix44Tables();
 
 } // namespace duckdb
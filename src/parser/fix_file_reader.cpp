@@ -1,100 +1,555 @@
 #include "fix_file_reader.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/limits.hpp"
+#include <cstring>
 #include <mutex>
 
 namespace duckdb {
 
-FixFileReader::FixFileReader() : line_number_(0), buffer_offset_(0), file_done_(false) {
+FixRangeScheduler::FixRangeScheduler(const vector<string> &files, idx_t range_size, FileCompressionType compression)
+    : files_(files), range_size_(range_size), compression_(compression), start_offset_(0),
+      end_offset_(NumericLimits<idx_t>::Maximum()), file_index_(0), file_active_(false), active_file_index_(0),
+      active_file_splittable_(false), active_file_size_(0), next_range_start_(0), use_index_(false),
+      index_delimiter_('|'), active_file_indexed_(false), next_index_range_(0), skipped_bytes_(0),
+      next_batch_index_(0) {
 }
 
-bool FixFileReader::OpenNextFile(FileSystem &fs, const vector<string> &files, idx_t &file_index, std::mutex &lock) {
+void FixRangeScheduler::SetBounds(idx_t start_offset, idx_t end_offset) {
+	start_offset_ = start_offset;
+	end_offset_ = end_offset;
+}
+
+void FixRangeScheduler::UseIndex(char delimiter, FixBlockPredicate predicate) {
+	use_index_ = true;
+	index_delimiter_ = delimiter;
+	block_predicate_ = std::move(predicate);
+}
+
+bool FixRangeScheduler::LoadIndexRanges(FileSystem &fs) {
+	FixSparseIndex index;
+	if (!FixSparseIndex::TryLoad(fs, files_[active_file_index_], *pending_handle_, index) ||
+	    index.delimiter != index_delimiter_) {
+		return false;
+	}
+	pending_handle_->Seek(0);
+
+	// Blocks that may match, adjacent ones merged into ranges of up to range_size bytes
+	index_ranges_.clear();
+	next_index_range_ = 0;
+	idx_t kept_bytes = 0;
+	for (idx_t block_idx = 0; block_idx < index.blocks.size(); block_idx++) {
+		if (block_predicate_ && !block_predicate_(index, block_idx)) {
+			continue;
+		}
+		auto &block = index.blocks[block_idx];
+		auto start = MaxValue<idx_t>(block.start, start_offset_);
+		auto end = MinValue<idx_t>(block.end, active_file_size_);
+		if (start >= end) {
+			continue;
+		}
+		kept_bytes += end - start;
+		if (!index_ranges_.empty() && index_ranges_.back().second == start &&
+		    end - index_ranges_.back().first <= range_size_) {
+			index_ranges_.back().second = end;
+		} else {
+			index_ranges_.emplace_back(start, end);
+		}
+	}
+	skipped_bytes_ += active_file_size_ - start_offset_ - kept_bytes;
+	return true;
+}
+
+bool FixRangeScheduler::Next(FileSystem &fs, FixFileRange &range) {
+	std::lock_guard<std::mutex> guard(lock_);
+
+	while (true) {
+		if (!file_active_) {
+			if (file_index_ >= files_.size()) {
+				return false; // No more files
+			}
+
+			// Open file using DuckDB FileSystem API (supports S3, HTTP, etc.)
+			// The handle is reused by the thread that gets the first range of the file
+			// Compressed files are decompressed while reading and cannot seek, so they are scanned as one range
+			active_file_index_ = file_index_++;
+			pending_handle_ = fs.OpenFile(files_[active_file_index_], FileFlags::FILE_FLAGS_READ | compression_);
+			next_range_start_ = start_offset_;
+			file_active_ = true;
+
+			active_file_splittable_ = pending_handle_->CanSeek();
+			if (!active_file_splittable_) {
+				// Not splittable - scan the whole stream as one range
+				if (start_offset_ > 0) {
+					throw IOException("read_fix: cannot start at an offset in \"%s\", it is compressed or not seekable",
+					                  files_[active_file_index_]);
+				}
+				active_file_size_ = end_offset_;
+			} else {
+				active_file_size_ = MinValue<idx_t>(pending_handle_->GetFileSize(), end_offset_);
+				if (active_file_size_ <= start_offset_) {
+					// Empty file, or nothing after the start offset - nothing to scan
+					pending_handle_.reset();
+					file_active_ = false;
+					continue;
+				}
+			}
+			active_file_indexed_ = active_file_splittable_ && use_index_ && LoadIndexRanges(fs);
+		}
+
+		if (active_file_indexed_) {
+			if (next_index_range_ >= index_ranges_.size()) {
+				// Every remaining block was skipped
+				pending_handle_.reset();
+				file_active_ = false;
+				continue;
+			}
+			range.file_index = active_file_index_;
+			range.start = index_ranges_[next_index_range_].first;
+			range.end = index_ranges_[next_index_range_].second;
+			range.batch_index = next_batch_index_++;
+			range.handle = std::move(pending_handle_);
+			next_index_range_++;
+			if (next_index_range_ >= index_ranges_.size()) {
+				file_active_ = false;
+			}
+			return true;
+		}
+
+		range.file_index = active_file_index_;
+		range.start = next_range_start_;
+		if (!active_file_splittable_ || active_file_size_ - next_range_start_ <= range_size_) {
+			range.end = active_file_size_;
+		} else {
+			range.end = next_range_start_ + range_size_;
+		}
+		range.batch_index = next_batch_index_++;
+		range.handle = std::move(pending_handle_);
+
+		next_range_start_ = range.end;
+		if (next_range_start_ >= active_file_size_) {
+			file_active_ = false;
+		}
+		return true;
+	}
+}
+
+FixFileReader::FixFileReader(idx_t buffer_size, FixPrefetchMode prefetch)
+    : line_offset_(0), range_end_(0), batch_index_(0), skip_partial_line_(false), buffer_capacity_(buffer_size),
+      line_in_buffer_(false), buffer_size_(0), buffer_offset_(0), buffer_file_offset_(0), read_offset_(0),
+      file_done_(false), bytes_read_(0), framing_(FixFraming::LINES), delimiter_('|'), carry_pos_(0), prev_byte_('\n'),
+      prefetch_mode_(prefetch), prefetch_(false) {
+#ifndef DUCKDB_NO_THREADS
+	prefetch_offset_ = 0;
+#endif
+}
+
+FixFileReader::~FixFileReader() {
+	// A background read must not outlive the file handle it reads from
+	CancelPrefetch();
+}
+
+bool FixFileReader::OpenNextRange(FileSystem &fs, FixRangeScheduler &scheduler) {
 	// Close any existing file
 	Close();
 
-	// Get next file with lock
-	std::lock_guard<std::mutex> guard(lock);
+	FixFileRange range;
+	if (!scheduler.Next(fs, range)) {
+		return false; // No more ranges
+	}
 
-	if (file_index >= files.size()) {
-		return false; // No more files
+	current_file_ = scheduler.GetFile(range.file_index);
+	if (range.handle) {
+		file_handle_ = std::move(range.handle);
+	} else {
+		file_handle_ = fs.OpenFile(current_file_, FileFlags::FILE_FLAGS_READ | scheduler.GetCompression());
 	}
 
-	current_file_ = files[file_index];
-	file_index++;
+#ifndef DUCKDB_NO_THREADS
+	prefetch_ = prefetch_mode_ == FixPrefetchMode::ALWAYS ||
+	            (prefetch_mode_ == FixPrefetchMode::AUTO && !file_handle_->OnDiskFile());
+#endif
 
-	// Open file using DuckDB FileSystem API (supports S3, HTTP, etc.)
-	file_handle_ = fs.OpenFile(current_file_, FileOpenFlags::FILE_FLAGS_READ);
-	line_number_ = 0;
+	range_end_ = range.end;
+	batch_index_ = range.batch_index;
 	file_done_ = false;
-	buffer_.clear();
+	buffer_size_ = 0;
 	buffer_offset_ = 0;
+	carry_.clear();
+	carry_pos_ = 0;
+	prev_byte_ = '\n';
+
+	if (range.start > 0) {
+		// Start one byte early: if that byte is a newline, the range starts on a line boundary
+		read_offset_ = range.start - 1;
+		file_handle_->Seek(read_offset_);
+		skip_partial_line_ = true;
+	} else {
+		read_offset_ = 0;
+		skip_partial_line_ = false;
+	}
+	buffer_file_offset_ = read_offset_;
+
+	return true;
+}
 
+idx_t FixFileReader::NextReadSize() const {
+	// Read up to the range end; past it only the remainder of the last line is needed
+	if (read_offset_ >= range_end_) {
+		return MinValue<idx_t>(buffer_capacity_, TAIL_READ_SIZE);
+	}
+	return MinValue<idx_t>(buffer_capacity_, MaxValue<idx_t>(range_end_ - read_offset_, TAIL_READ_SIZE));
+}
+
+buffer_ptr<FixReadBuffer> FixFileReader::TakeFreeBuffer() {
+	// Lines of a buffer may still be referenced by an output vector, those buffers are left to it
+	buffer_ptr<FixReadBuffer> result;
+	if (spare_buffer_ && spare_buffer_.use_count() == 1) {
+		result = std::move(spare_buffer_);
+	}
+	spare_buffer_.reset();
+	if (!result) {
+		result = make_buffer<FixReadBuffer>(buffer_capacity_);
+	}
+	return result;
+}
+
+void FixFileReader::StartPrefetch() {
+#ifndef DUCKDB_NO_THREADS
+	prefetch_buffer_ = TakeFreeBuffer();
+	prefetch_offset_ = read_offset_;
+	auto handle = file_handle_.get();
+	auto data = prefetch_buffer_->data.get();
+	auto size = NextReadSize();
+	// The handle is only used by the background read until FillBuffer or CancelPrefetch waits for it
+	prefetch_read_ = std::async(std::launch::async, [handle, data, size]() -> idx_t {
+		return static_cast<idx_t>(handle->Read(data, size));
+	});
+#endif
+}
+
+void FixFileReader::CancelPrefetch() {
+#ifndef DUCKDB_NO_THREADS
+	if (prefetch_read_.valid()) {
+		try {
+			prefetch_read_.get();
+		} catch (...) {
+			// The data was never used, neither is the error
+		}
+		spare_buffer_ = std::move(prefetch_buffer_);
+	}
+#endif
+}
+
+bool FixFileReader::FillBuffer() {
+	idx_t bytes_read;
+#ifndef DUCKDB_NO_THREADS
+	if (prefetch_read_.valid()) {
+		// Errors of the background read surface here, as they would for a direct read
+		bytes_read = prefetch_read_.get();
+		spare_buffer_ = std::move(buffer_);
+		buffer_ = std::move(prefetch_buffer_);
+		buffer_file_offset_ = prefetch_offset_;
+	} else
+#endif
+	{
+		// Lines of the current buffer may still be referenced by an output vector
+		if (!buffer_ || buffer_.use_count() > 1) {
+			buffer_ = TakeFreeBuffer();
+		}
+		bytes_read = file_handle_->Read((void *)buffer_->data.get(), NextReadSize());
+		buffer_file_offset_ = read_offset_;
+	}
+	read_offset_ = buffer_file_offset_ + bytes_read;
+	buffer_size_ = bytes_read;
+	bytes_read_ += bytes_read;
+	buffer_offset_ = 0;
+
+	if (bytes_read == 0) {
+		file_done_ = true;
+		return false;
+	}
+	// Read ahead while the range has data left; lines crossing the range end only need a short tail read
+	if (prefetch_ && read_offset_ < range_end_) {
+		StartPrefetch();
+	}
 	return true;
 }
 
-bool FixFileReader::ReadLine(string &line) {
+bool FixFileReader::ReadLine(const char *&line, idx_t &line_len) {
 	if (!file_handle_) {
 		return false; // No file open
 	}
+	if (framing_ == FixFraming::BODY_LENGTH) {
+		return ReadFramedMessage(line, line_len);
+	}
 
-	line.clear();
-	bool found_line = false;
+	// Resync: discard everything up to and including the first newline at or after range start - 1
+	while (skip_partial_line_) {
+		if (buffer_offset_ >= buffer_size_ && (file_done_ || !FillBuffer())) {
+			return false;
+		}
+		auto start = buffer_->data.get() + buffer_offset_;
+		auto newline = static_cast<const char *>(memchr(start, '\n', buffer_size_ - buffer_offset_));
+		if (newline) {
+			buffer_offset_ += (newline - start) + 1;
+			skip_partial_line_ = false;
+		} else {
+			buffer_offset_ = buffer_size_;
+		}
+	}
 
-	while (!file_done_) {
-		// Check if we need to read more data into buffer
-		if (buffer_offset_ >= buffer_.size()) {
-			// Read next chunk
-			buffer_.resize(BUFFER_SIZE);
-			idx_t bytes_read = file_handle_->Read((void *)buffer_.data(), BUFFER_SIZE);
+	if (buffer_offset_ >= buffer_size_ && (file_done_ || !FillBuffer())) {
+		return false; // End of file, no more lines
+	}
 
-			if (bytes_read == 0) {
-				// End of file
-				file_done_ = true;
-				if (!line.empty()) {
-					found_line = true;
-					line_number_++;
-				}
+	// Lines starting at or after the range end belong to the next range
+	if (buffer_file_offset_ + buffer_offset_ >= range_end_) {
+		return false;
+	}
+
+	line_offset_ = buffer_file_offset_ + buffer_offset_;
+	auto start = buffer_->data.get() + buffer_offset_;
+	auto newline = static_cast<const char *>(memchr(start, '\n', buffer_size_ - buffer_offset_));
+	if (newline) {
+		// Fast path: the whole line is inside the buffer
+		line = start;
+		line_len = newline - start;
+		buffer_offset_ += line_len + 1;
+		line_in_buffer_ = true;
+	} else {
+		// The line crosses the buffer boundary - assemble it in the carry buffer
+		carry_.assign(start, buffer_size_ - buffer_offset_);
+		buffer_offset_ = buffer_size_;
+		while (FillBuffer()) {
+			auto data = buffer_->data.get();
+			newline = static_cast<const char *>(memchr(data, '\n', buffer_size_));
+			if (newline) {
+				idx_t len = newline - data;
+				carry_.append(data, len);
+				buffer_offset_ = len + 1;
 				break;
 			}
+			carry_.append(data, buffer_size_);
+			buffer_offset_ = buffer_size_;
+		}
+		line = carry_.data();
+		line_len = carry_.size();
+		line_in_buffer_ = false;
+	}
+
+	// Remove trailing carriage return if present (for Windows line endings)
+	if (line_len > 0 && line[line_len - 1] == '\r') {
+		line_len--;
+	}
+
+	return true;
+}
 
-			buffer_.resize(bytes_read);
-			buffer_offset_ = 0;
+idx_t FixFileReader::Window(idx_t need, const char *&data) {
+	if (carry_pos_ >= carry_.size()) {
+		// Nothing carried over, read straight from the buffer while it holds enough
+		carry_.clear();
+		carry_pos_ = 0;
+		if (buffer_offset_ >= buffer_size_ && (file_done_ || !FillBuffer())) {
+			return 0;
+		}
+		idx_t available = buffer_size_ - buffer_offset_;
+		data = buffer_->data.get() + buffer_offset_;
+		if (available >= need) {
+			return available;
+		}
+		carry_.assign(data, available);
+		buffer_offset_ = buffer_size_;
+	} else if (carry_pos_ > 0) {
+		carry_.erase(0, carry_pos_);
+		carry_pos_ = 0;
+	}
+	// Gather the bytes in the carry buffer, a bit more than needed so a short shortfall does not repeat
+	while (carry_.size() < need) {
+		if (buffer_offset_ >= buffer_size_ && (file_done_ || !FillBuffer())) {
+			break;
 		}
+		auto take =
+		    MinValue<idx_t>(buffer_size_ - buffer_offset_, MaxValue<idx_t>(need - carry_.size(), MIN_CARRY_READ));
+		carry_.append(buffer_->data.get() + buffer_offset_, take);
+		buffer_offset_ += take;
+	}
+	data = carry_.data();
+	return carry_.size();
+}
+
+void FixFileReader::Consume(const char *data, idx_t count) {
+	prev_byte_ = data[count - 1];
+	if (carry_pos_ < carry_.size()) {
+		carry_pos_ += count;
+	} else {
+		buffer_offset_ += count;
+	}
+}
+
+idx_t FixFileReader::UnreadOffset() const {
+	return buffer_file_offset_ + buffer_offset_ - (carry_.size() - carry_pos_);
+}
+
+// Bytes to look at before deciding how a message is framed, enough for any 8=...<d>9=...<d> header
+static constexpr idx_t FIX_HEADER_PEEK = 64;
+
+static inline bool IsLineBreak(char c) {
+	return c == '\n' || c == '\r';
+}
 
-		// Find newline in buffer
-		size_t newline_pos = buffer_.find('\n', buffer_offset_);
-		if (newline_pos != string::npos) {
-			// Found newline
-			line.append(buffer_, buffer_offset_, newline_pos - buffer_offset_);
-			buffer_offset_ = newline_pos + 1;
-			found_line = true;
-			line_number_++;
+// End of the CheckSum field whose value starts at pos: after its delimiter, or at a line break once its three
+// digits have been seen (line breaks before that wrap the field); 0 if that is not within the available bytes
+// and more may follow
+static idx_t FindChecksumEnd(const char *data, idx_t pos, idx_t available, bool at_end, char delimiter) {
+	idx_t digits = 0;
+	for (; pos < available; pos++) {
+		if (data[pos] == delimiter) {
+			return pos + 1;
+		}
+		if (!IsLineBreak(data[pos])) {
+			digits++;
+		} else if (digits >= 3) {
+			return pos;
+		}
+	}
+	return at_end ? available : 0;
+}
+
+// End of a message without a usable BodyLength: after the next CheckSum field, or where the next message
+// starts (8= after a delimiter or a line break); 0 if that is not within the available bytes and more may follow
+static idx_t ScanFixMessageEnd(const char *data, idx_t available, bool at_end, char delimiter) {
+	for (idx_t pos = 2; pos < available; pos++) {
+		auto prev = data[pos - 1];
+		if (prev != delimiter && !IsLineBreak(prev)) {
+			continue;
+		}
+		if (pos + 3 > available) {
 			break;
-		} else {
-			// No newline in current buffer, append all remaining data
-			line.append(buffer_, buffer_offset_, buffer_.size() - buffer_offset_);
-			buffer_offset_ = buffer_.size();
+		}
+		if (data[pos] == '8' && data[pos + 1] == '=') {
+			return pos;
+		}
+		if (memcmp(data + pos, "10=", 3) == 0) {
+			return FindChecksumEnd(data, pos + 3, available, at_end, delimiter);
 		}
 	}
+	return at_end ? available : 0;
+}
 
-	if (!found_line) {
-		return false; // End of file, no more lines
+// Length of the message at the start of data (which starts with 8=)
+// Returns 0 and sets need if more bytes are needed
+static idx_t FrameFixMessage(const char *data, idx_t available, bool at_end, char delimiter, idx_t max_message,
+                             idx_t &need) {
+	need = available + 1;
+	if (available < FIX_HEADER_PEEK && !at_end) {
+		need = FIX_HEADER_PEEK;
+		return 0;
+	}
+	// 8=<BeginString><d>9=<BodyLength><d>, BodyLength counts the bytes up to the CheckSum field
+	auto header_end = MinValue<idx_t>(available, FIX_HEADER_PEEK);
+	auto begin_string_end = static_cast<const char *>(memchr(data, delimiter, header_end));
+	idx_t pos = begin_string_end ? idx_t(begin_string_end - data) + 1 : header_end;
+	if (pos + 2 < header_end && data[pos] == '9' && data[pos + 1] == '=') {
+		idx_t body_length = 0;
+		idx_t digits_end = pos + 2;
+		while (digits_end < header_end && digits_end - pos < 11 && data[digits_end] >= '0' &&
+		       data[digits_end] <= '9') {
+			body_length = body_length * 10 + idx_t(data[digits_end] - '0');
+			digits_end++;
+		}
+		if (digits_end > pos + 2 && digits_end < header_end && data[digits_end] == delimiter &&
+		    body_length <= max_message) {
+			// The CheckSum field follows the delimiter that ends the body
+			auto checksum = digits_end + 1 + body_length;
+			if (checksum + 3 > available) {
+				if (!at_end) {
+					need = checksum + 7; // 10=xxx<d>
+					return 0;
+				}
+			} else if (data[checksum - 1] == delimiter && memcmp(data + checksum, "10=", 3) == 0) {
+				return FindChecksumEnd(data, checksum + 3, available, at_end, delimiter);
+			}
+		}
 	}
+	// BodyLength is missing or does not match the message
+	return ScanFixMessageEnd(data, available, at_end, delimiter);
+}
 
-	// Remove trailing carriage return if present (for Windows line endings)
-	if (!line.empty() && line.back() == '\r') {
-		line.pop_back();
+bool FixFileReader::ReadFramedMessage(const char *&line, idx_t &line_len) {
+	const char *data;
+	if (skip_partial_line_) {
+		// The byte before the range start decides whether a message starts right at it
+		if (Window(1, data) == 0) {
+			return false;
+		}
+		Consume(data, 1);
+		skip_partial_line_ = false;
+	}
+
+	// Skip to the next message start: 8= after a delimiter, a line break or at the start of the file
+	while (true) {
+		auto available = Window(2, data);
+		if (available < 2 || UnreadOffset() >= range_end_) {
+			return false; // Messages starting at or after the range end belong to the next range
+		}
+		if (data[0] == '8' && data[1] == '=' && (prev_byte_ == delimiter_ || IsLineBreak(prev_byte_))) {
+			break;
+		}
+		auto next = static_cast<const char *>(memchr(data + 1, '8', available - 1));
+		Consume(data, next ? idx_t(next - data) : available);
 	}
+	line_offset_ = UnreadOffset();
 
+	idx_t need = 1;
+	idx_t length;
+	while (true) {
+		auto available = Window(need, data);
+		length = FrameFixMessage(data, available, available < need, delimiter_, buffer_capacity_, need);
+		if (length > 0) {
+			break;
+		}
+		need = MaxValue<idx_t>(need, available + MaxValue<idx_t>(available / 2, MIN_CARRY_READ));
+	}
+
+	// A message wrapped across lines is joined back together
+	bool wrapped = memchr(data, '\n', length) || memchr(data, '\r', length);
+	if (!wrapped && carry_pos_ >= carry_.size()) {
+		// Fast path: the whole message is inside the read buffer
+		line = data;
+		line_len = length;
+		line_in_buffer_ = true;
+	} else {
+		message_.clear();
+		for (idx_t i = 0; i < length; i++) {
+			if (!wrapped || !IsLineBreak(data[i])) {
+				message_.push_back(data[i]);
+			}
+		}
+		line = message_.data();
+		line_len = message_.size();
+		line_in_buffer_ = false;
+	}
+	Consume(data, length);
 	return true;
 }
 
 void FixFileReader::Close() {
+	CancelPrefetch();
 	file_handle_.reset();
 	current_file_.clear();
-	line_number_ = 0;
-	buffer_.clear();
+	line_offset_ = 0;
+	range_end_ = 0;
+	skip_partial_line_ = false;
+	line_in_buffer_ = false;
+	buffer_size_ = 0;
 	buffer_offset_ = 0;
+	buffer_file_offset_ = 0;
+	read_offset_ = 0;
 	file_done_ = false;
+	carry_.clear();
+	carry_pos_ = 0;
+	prefetch_ = false;
 }
 
 } // namespace duckdb
@@ -1,34 +1,186 @@
 #pragma once
 
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/types/vector_buffer.hpp"
+#include "parser/fix_sparse_index.hpp"
+#include <functional>
 #include <string>
 #include <mutex>
+#ifndef DUCKDB_NO_THREADS
+#include <future>
+#endif
 
 namespace duckdb {
 
+// Default size of the byte ranges a file is split into for parallel scanning
+static constexpr idx_t DEFAULT_FIX_RANGE_SIZE = 32ULL * 1024ULL * 1024ULL;
+
+// Default size of the per-thread read buffer
+static constexpr idx_t DEFAULT_FIX_BUFFER_SIZE = 8ULL * 1024ULL * 1024ULL;
+
+// A contiguous byte range [start, end) of one input file, scanned by a single thread
+// A line belongs to the range its first byte falls into, so the last line of a range
+// may extend past end and the first partial line of a range is skipped
+struct FixFileRange {
+	idx_t file_index = 0;
+	idx_t start = 0;
+	idx_t end = 0;
+	// Sequential across all ranges of a scan, used to preserve insertion order
+	idx_t batch_index = 0;
+	// Handle opened while sizing the file, handed to whichever thread gets the first range
+	unique_ptr<FileHandle> handle;
+};
+
+// Decides from a file's sparse index whether one of its blocks can contain matching rows
+typedef std::function<bool(const FixSparseIndex &index, idx_t block)> FixBlockPredicate;
+
+// Splits the input files into byte ranges and hands them out to scan threads
+// Files that cannot seek (pipes, compressed streams) are handed out as a single range
+class FixRangeScheduler {
+public:
+	// Files are opened with the given compression, AUTO_DETECT decompresses by file extension
+	FixRangeScheduler(const vector<string> &files, idx_t range_size,
+	                  FileCompressionType compression = FileCompressionType::UNCOMPRESSED);
+
+	// Use the sidecar index of each file when there is a valid one (built with the same delimiter):
+	// ranges then follow block boundaries and blocks the predicate rejects are not scanned at all
+	void UseIndex(char delimiter, FixBlockPredicate predicate);
+
+	// Only scan the lines that start within [start_offset, end_offset) of each file
+	void SetBounds(idx_t start_offset, idx_t end_offset);
+
+	// Get the next range to scan
+	// Returns true on success, false if all ranges of all files have been handed out
+	bool Next(FileSystem &fs, FixFileRange &range);
+
+	const string &GetFile(idx_t file_index) const {
+		return files_[file_index];
+	}
+
+	FileCompressionType GetCompression() const {
+		return compression_;
+	}
+
+	// Number of ranges handed out so far
+	idx_t GetRangeCount() {
+		std::lock_guard<std::mutex> guard(lock_);
+		return next_batch_index_;
+	}
+
+	// Bytes of the files opened so far that their index let the scan skip
+	idx_t GetSkippedBytes() const {
+		std::lock_guard<std::mutex> guard(lock_);
+		return skipped_bytes_;
+	}
+
+private:
+	// Load the index of the active file and compute its ranges, false if it has no usable index
+	bool LoadIndexRanges(FileSystem &fs);
+
+	mutable std::mutex lock_;
+	const vector<string> &files_;
+	idx_t range_size_;
+	FileCompressionType compression_;
+	idx_t start_offset_;
+	idx_t end_offset_;
+
+	// Next file to open
+	idx_t file_index_;
+	// State of the file currently being split
+	bool file_active_;
+	idx_t active_file_index_;
+	bool active_file_splittable_;
+	idx_t active_file_size_;
+	idx_t next_range_start_;
+	unique_ptr<FileHandle> pending_handle_;
+
+	// Sparse index usage
+	bool use_index_;
+	char index_delimiter_;
+	FixBlockPredicate block_predicate_;
+	// Ranges of the active file taken from its index, [start, end) each
+	bool active_file_indexed_;
+	vector<pair<idx_t, idx_t>> index_ranges_;
+	idx_t next_index_range_;
+	idx_t skipped_bytes_;
+
+	idx_t next_batch_index_;
+};
+
+// When a FixFileReader reads the next buffer in the background while the current one is parsed
+// AUTO prefetches for files that are not on local disk (S3, HTTP, ...), where each read waits on the network
+enum class FixPrefetchMode : uint8_t { AUTO, ALWAYS, NEVER };
+
+// How a FixFileReader finds message boundaries
+// LINES: one message per line
+// BODY_LENGTH: messages are found from their header (8=...<d>9=<BodyLength><d>) and end after the CheckSum field
+// (10=xxx<d>), so they do not need line breaks; BodyLength jumps straight to the CheckSum field, without it (or when
+// it is wrong) the message ends after the next CheckSum field or where the next message starts
+// Line breaks inside a message (logs that wrap long messages) are removed
+enum class FixFraming : uint8_t { LINES, BODY_LENGTH };
+
+// Read buffer of a FixFileReader
+// Output vectors can reference lines in place by keeping the buffer alive (StringVector::AddBuffer);
+// the reader then reads into a new buffer instead of overwriting it
+class FixReadBuffer : public VectorBuffer {
+public:
+	explicit FixReadBuffer(idx_t capacity) : VectorBuffer(VectorBufferType::OPAQUE_BUFFER), data(new char[capacity]) {
+	}
+
+	unique_ptr<char[]> data;
+};
+
 // Helper class for reading FIX log files line by line
 // Handles buffering and various line ending formats (\n, \r\n, \r)
+// Lines are returned as views into a large refillable buffer; only lines that cross
+// a buffer boundary are copied (into a separate carry buffer)
+// With prefetching, the next buffer of the range is read on a background thread (double buffering)
 class FixFileReader {
 public:
-	FixFileReader();
+	explicit FixFileReader(idx_t buffer_size = DEFAULT_FIX_BUFFER_SIZE,
+	                       FixPrefetchMode prefetch = FixPrefetchMode::AUTO);
+	~FixFileReader();
 
-	// Open a file for reading
-	// Returns true on success, false if no more files available
-	bool OpenNextFile(FileSystem &fs, const vector<string> &files, idx_t &file_index, std::mutex &lock);
+	// Open the next byte range handed out by the scheduler
+	// Returns true on success, false if no more ranges are available
+	bool OpenNextRange(FileSystem &fs, FixRangeScheduler &scheduler);
 
-	// Read the next line from the current file
-	// Returns true if a line was read, false if end of file reached
+	// Find messages by their BodyLength instead of line breaks (delimiter is the field delimiter)
+	void SetFraming(FixFraming framing, char delimiter) {
+		framing_ = framing;
+		delimiter_ = delimiter;
+	}
+
+	// Read the next line (or framed message) from the current range
+	// Returns true if a line was read, false if the end of the range was reached
 	// Line endings (\n, \r\n, \r) are automatically stripped
-	bool ReadLine(string &line);
+	// The returned view is valid until the next call to ReadLine or Close
+	bool ReadLine(const char *&line, idx_t &line_len);
+
+	// The read buffer holding the last line, nullptr if the line crossed a buffer boundary (it is then
+	// only valid until the next ReadLine); a vector holding a reference keeps the line valid
+	const buffer_ptr<FixReadBuffer> &GetLineBuffer() const {
+		return line_in_buffer_ ? buffer_ : no_buffer_;
+	}
 
 	// Get current file path
 	const string &GetCurrentFile() const {
 		return current_file_;
 	}
 
-	// Get current line number (1-indexed)
-	idx_t GetLineNumber() const {
-		return line_number_;
+	// File offset of the first byte of the last line read
+	idx_t GetLineOffset() const {
+		return line_offset_;
+	}
+
+	// Batch index of the last range opened (kept after Close for partition data)
+	idx_t GetBatchIndex() const {
+		return batch_index_;
+	}
+
+	// Bytes read from files so far, over all ranges (after decompression)
+	idx_t GetBytesRead() const {
+		return bytes_read_;
 	}
 
 	// Close current file
@@ -40,22 +192,85 @@ public:
 	}
 
 private:
+	// Refill the read buffer, returns false at end of file
+	bool FillBuffer();
+	// Bytes the next read asks for, starting at read_offset_
+	idx_t NextReadSize() const;
+	// A buffer to read into that no output vector references
+	buffer_ptr<FixReadBuffer> TakeFreeBuffer();
+	// Start reading the next buffer in the background
+	void StartPrefetch();
+	// Wait for a background read that is no longer needed
+	void CancelPrefetch();
+
+	// BODY_LENGTH framing
+	bool ReadFramedMessage(const char *&line, idx_t &line_len);
+	// Point data at the unread bytes, at least need of them contiguous unless the file ends first
+	// Bytes that continue past the read buffer are gathered in carry_; returns the number of bytes available
+	idx_t Window(idx_t need, const char *&data);
+	// Mark count bytes of the window at data as read
+	void Consume(const char *data, idx_t count);
+	// File offset of the next unread byte
+	idx_t UnreadOffset() const;
+
 	// File handle
 	unique_ptr<FileHandle> file_handle_;
 
 	// Current file path
 	string current_file_;
 
-	// Line number counter (1-indexed)
-	idx_t line_number_;
+	// File offset of the last line read
+	idx_t line_offset_;
+
+	// End of the byte range being scanned
+	idx_t range_end_;
+	idx_t batch_index_;
+	// True until the partial line preceding the range start has been skipped
+	bool skip_partial_line_;
 
-	// Read buffer
-	string buffer_;
+	// Read buffer (allocated on first use, reused across ranges unless a vector still references it)
+	idx_t buffer_capacity_;
+	buffer_ptr<FixReadBuffer> buffer_;
+	buffer_ptr<FixReadBuffer> no_buffer_;
+	// Previous buffer, reused once no output vector references it
+	buffer_ptr<FixReadBuffer> spare_buffer_;
+	bool line_in_buffer_;
+	idx_t buffer_size_;
 	idx_t buffer_offset_;
+	// File offset of buffer_[0]
+	idx_t buffer_file_offset_;
+	// File offset the next read starts at
+	idx_t read_offset_;
 	bool file_done_;
+	// Bytes read over all ranges
+	idx_t bytes_read_;
+
+	// Holds the current line when it crosses a buffer boundary
+	string carry_;
+
+	FixFraming framing_;
+	char delimiter_;
+	// BODY_LENGTH framing: carry_[carry_pos_, end) are unread bytes that precede buffer_[buffer_offset_, end)
+	idx_t carry_pos_;
+	// The byte before the next unread one, a message only starts after a delimiter or a line break
+	char prev_byte_;
+	// Framed messages that are not a view into the read buffer
+	string message_;
+
+	FixPrefetchMode prefetch_mode_;
+	// Prefetching is enabled for the current range
+	bool prefetch_;
+#ifndef DUCKDB_NO_THREADS
+	// Background read of the next buffer: its buffer, file offset and result (bytes read)
+	buffer_ptr<FixReadBuffer> prefetch_buffer_;
+	idx_t prefetch_offset_;
+	std::future<idx_t> prefetch_read_;
+#endif
 
-	// Buffer size for file reads
-	static constexpr idx_t BUFFER_SIZE = 8192;
+	// Read size once the range end has been passed (only the rest of the last line is needed)
+	static constexpr idx_t TAIL_READ_SIZE = 64ULL * 1024ULL;
+	// Least number of bytes gathered at once when a framed message crosses the read buffer
+	static constexpr idx_t MIN_CARRY_READ = 4096;
 };
 
 } // namespace duckdb
@@ -0,0 +1,176 @@
+#include "fix_group_layout.hpp"
+
+namespace duckdb {
+
+bool FixCompiledGroup::HasSparseField(int tag) const {
+	return std::find(sparse_fields.begin(), sparse_fields.end(), tag) != sparse_fields.end();
+}
+
+void FixGroupLayout::SetBit(std::vector<uint64_t> &bits, int tag) {
+	auto word = static_cast<size_t>(tag) / 64;
+	if (word >= bits.size()) {
+		bits.resize(word + 1, 0);
+	}
+	bits[word] |= static_cast<uint64_t>(1) << (tag % 64);
+}
+
+void FixGroupLayout::ResolveComponents(const FixDictionary &dict, const std::vector<std::string> &refs,
+                                       std::vector<int> &fields, GroupDefMap &groups, int depth) {
+	if (depth >= MAX_COMPONENT_DEPTH) {
+		return;
+	}
+	for (auto &ref : refs) {
+		auto comp = dict.components.find(ref);
+		if (comp == dict.components.end()) {
+			continue;
+		}
+		fields.insert(fields.end(), comp->second.field_tags.begin(), comp->second.field_tags.end());
+		for (auto &group : comp->second.groups) {
+			groups.emplace(group.first, group.second.get());
+		}
+		ResolveComponents(dict, comp->second.component_refs, fields, groups, depth + 1);
+	}
+}
+
+int FixGroupLayout::ResolveLeadingTag(const FixDictionary &dict, int leading_tag, const std::string &leading_component,
+                                      int depth) {
+	if (leading_component.empty()) {
+		return leading_tag;
+	}
+	auto comp = dict.components.find(leading_component);
+	if (comp == dict.components.end() || depth >= MAX_COMPONENT_DEPTH) {
+		return 0;
+	}
+	return ResolveLeadingTag(dict, comp->second.leading_tag, comp->second.leading_component, depth + 1);
+}
+
+FixGroupLayout::FixGroupLayout(const FixDictionary &dict) : short_ids_(1 << 16, NO_MESSAGE) {
+	for (auto &entry : dict.messages) {
+		auto &msg_type = entry.first;
+
+		// Groups of the message and of the components nested in its components
+		GroupDefMap group_defs;
+		for (auto &group : entry.second.groups) {
+			group_defs.emplace(group.first, group.second.get());
+		}
+		std::vector<int> unused_fields;
+		ResolveComponents(dict, entry.second.component_refs, unused_fields, group_defs, 0);
+
+		FixCompiledMessage message;
+		for (auto &group : group_defs) {
+			if (!group.second) {
+				continue;
+			}
+			// Groups without fields can never have instances
+			auto group_id = AddGroup(dict, *group.second);
+			if (groups_[group_id].Empty()) {
+				continue;
+			}
+			message.groups.emplace_back(group.first, group_id);
+			if (group.first >= 0 && group.first <= MAX_DENSE_TAG) {
+				SetBit(count_tag_bits_, group.first);
+			} else {
+				has_sparse_count_tags_ = true;
+			}
+		}
+		if (message.groups.empty() || msg_type.empty() || messages_.size() >= NO_MESSAGE) {
+			continue;
+		}
+		std::sort(message.groups.begin(), message.groups.end());
+
+		auto id = static_cast<uint16_t>(messages_.size());
+		messages_.push_back(std::move(message));
+		if (msg_type.size() <= 2) {
+			auto key = static_cast<unsigned char>(msg_type[0]) << 8;
+			if (msg_type.size() == 2) {
+				key |= static_cast<unsigned char>(msg_type[1]);
+			}
+			short_ids_[key] = id;
+		} else {
+			long_ids_.emplace_back(msg_type, id);
+		}
+	}
+}
+
+uint32_t FixGroupLayout::AddGroup(const FixDictionary &dict, const FixGroupDef &def) {
+	auto existing = group_ids_.find(&def);
+	if (existing != group_ids_.end()) {
+		return existing->second;
+	}
+	// The id is taken before nested groups are compiled, so a group that (wrongly) contains itself terminates
+	auto id = static_cast<uint32_t>(groups_.size());
+	groups_.emplace_back();
+	group_ids_.emplace(&def, id);
+
+	std::vector<int> fields(def.field_tags.begin(), def.field_tags.end());
+	GroupDefMap subgroup_defs;
+	for (auto &sub : def.subgroups) {
+		subgroup_defs.emplace(sub.first, sub.second.get());
+	}
+	ResolveComponents(dict, def.component_refs, fields, subgroup_defs, 0);
+
+	FixCompiledGroup group;
+	group.count_tag = def.count_tag;
+	group.first_field = ResolveLeadingTag(dict, def.leading_tag, def.leading_component, 0);
+	if (group.first_field == 0 && !fields.empty()) {
+		group.first_field = fields[0];
+	}
+	for (auto &sub : subgroup_defs) {
+		if (!sub.second) {
+			continue;
+		}
+		auto sub_id = AddGroup(dict, *sub.second);
+		if (groups_[sub_id].Empty()) {
+			continue;
+		}
+		group.subgroups.emplace_back(sub.first, sub_id);
+		fields.push_back(sub.first);
+	}
+	std::sort(group.subgroups.begin(), group.subgroups.end());
+	for (auto tag : fields) {
+		if (tag >= 0 && tag <= MAX_DENSE_TAG) {
+			SetBit(group.field_bits, tag);
+		} else if (!group.HasField(tag)) {
+			group.sparse_fields.push_back(tag);
+		}
+	}
+
+	groups_[id] = std::move(group);
+	return id;
+}
+
+bool FixGroupLayout::IsGroupField(uint16_t message_id, int tag) const {
+	// Groups shared between parents, or (wrongly) nested in themselves, are checked once
+	std::vector<bool> visited(groups_.size(), false);
+	std::vector<uint32_t> pending;
+	for (auto &group : messages_[message_id].groups) {
+		pending.push_back(group.second);
+	}
+	while (!pending.empty()) {
+		auto id = pending.back();
+		pending.pop_back();
+		if (visited[id]) {
+			continue;
+		}
+		visited[id] = true;
+		auto &group = groups_[id];
+		if (group.HasField(tag)) {
+			return true;
+		}
+		for (auto &sub : group.subgroups) {
+			pending.push_back(sub.second);
+		}
+	}
+	return false;
+}
+
+uint16_t FixGroupLayout::GetLongMessageId(const char *msg_type, size_t len) const {
+	for (auto &entry : long_ids_) {
+		if (entry.first.size() == len && entry.first.compare(0, len, msg_type, len) == 0) {
+			return entry.second;
+		}
+	}
+	return NO_MESSAGE;
+}
+
+} // namespace duckdb
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "dictionary/fix_dictionary.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace duckdb {
+
+// One repeating group of a compiled dictionary
+// Fields and nested groups of the components used in the group are resolved into it
+struct FixCompiledGroup {
+	int count_tag = 0;
+	// First field of the group, it starts every instance
+	int first_field = 0;
+	// Membership of tags up to FixGroupLayout::MAX_DENSE_TAG, one bit per tag
+	// Count tags of nested groups are members too
+	std::vector<uint64_t> field_bits;
+	// Member tags beyond the dense range
+	std::vector<int> sparse_fields;
+	// Nested groups, sorted by count tag
+	std::vector<std::pair<int, uint32_t>> subgroups; // {count tag, group id}
+
+	bool Empty() const {
+		return field_bits.empty() && sparse_fields.empty();
+	}
+
+	inline bool HasField(int tag) const {
+		if (tag >= 0 && static_cast<size_t>(tag) / 64 < field_bits.size()) {
+			return (field_bits[tag / 64] >> (tag % 64)) & 1;
+		}
+		return HasSparseField(tag);
+	}
+
+private:
+	bool HasSparseField(int tag) const;
+};
+
+// Groups of one message type, sorted by count tag
+struct FixCompiledMessage {
+	std::vector<std::pair<int, uint32_t>> groups; // {count tag, group id}
+};
+
+// Group id of a count tag in a sorted {count tag, group id} list, FIX_NO_GROUP if it is not there
+static constexpr uint32_t FIX_NO_GROUP = 0xFFFFFFFF;
+inline uint32_t FindFixGroup(const std::vector<std::pair<int, uint32_t>> &groups, int count_tag) {
+	auto entry = std::lower_bound(groups.begin(), groups.end(), count_tag,
+	                              [](const std::pair<int, uint32_t> &group, int tag) { return group.first < tag; });
+	return entry != groups.end() && entry->first == count_tag ? entry->second : FIX_NO_GROUP;
+}
+
+// Dictionary groups compiled for per-message lookups, built once per query
+// Message types get dense ids (one array lookup for one and two character types), every group is a
+// membership bitset, and a bitset of all count tags lets the group parser find groups in a single pass
+// over a message's tags
+class FixGroupLayout {
+public:
+	static constexpr uint16_t NO_MESSAGE = 0xFFFF;
+	// Tags up to this number are kept in bitsets, larger ones in short lists
+	static constexpr int MAX_DENSE_TAG = 65535;
+
+	// Components may nest this deep, deeper references are ignored
+	static constexpr int MAX_COMPONENT_DEPTH = 16;
+
+	explicit FixGroupLayout(const FixDictionary &dict);
+
+	// Dense id of a message type, NO_MESSAGE if the dictionary has no groups for it
+	inline uint16_t GetMessageId(const char *msg_type, size_t len) const {
+		if (len == 1) {
+			return short_ids_[static_cast<unsigned char>(msg_type[0]) << 8];
+		}
+		if (len == 2) {
+			return short_ids_[(static_cast<unsigned char>(msg_type[0]) << 8) | static_cast<unsigned char>(msg_type[1])];
+		}
+		return GetLongMessageId(msg_type, len);
+	}
+
+	const FixCompiledMessage &GetMessage(uint16_t id) const {
+		return messages_[id];
+	}
+
+	const FixCompiledGroup &GetGroup(uint32_t id) const {
+		return groups_[id];
+	}
+
+	// Number of message ids, message ids are below this
+	uint16_t MessageCount() const {
+		return static_cast<uint16_t>(messages_.size());
+	}
+
+	// True if tag is a field of one of the message's groups or of the groups nested in them
+	// Such a tag may occur more than once in a message
+	bool IsGroupField(uint16_t message_id, int tag) const;
+
+	// False if no message type has a group with this count tag
+	inline bool MayBeCountTag(int tag) const {
+		if (tag >= 0 && static_cast<size_t>(tag) / 64 < count_tag_bits_.size()) {
+			return (count_tag_bits_[tag / 64] >> (tag % 64)) & 1;
+		}
+		return tag > MAX_DENSE_TAG && has_sparse_count_tags_;
+	}
+
+	typedef std::unordered_map<int, const FixGroupDef *> GroupDefMap;
+
+	// Fields and groups of the components used by a group or message, following nested components
+	static void ResolveComponents(const FixDictionary &dict, const std::vector<std::string> &refs,
+	                              std::vector<int> &fields, GroupDefMap &groups, int depth);
+
+private:
+	uint16_t GetLongMessageId(const char *msg_type, size_t len) const;
+	uint32_t AddGroup(const FixDictionary &dict, const FixGroupDef &def);
+	// Tag of the first field of a group or component, following a leading component
+	static int ResolveLeadingTag(const FixDictionary &dict, int leading_tag, const std::string &leading_component,
+	                             int depth);
+	static void SetBit(std::vector<uint64_t> &bits, int tag);
+
+	// Message id of each one (second byte 0) and two character message type
+	std::vector<uint16_t> short_ids_;
+	// Message types of three or more characters
+	std::vector<std::pair<std::string, uint16_t>> long_ids_;
+	std::vector<FixCompiledMessage> messages_;
+	std::vector<FixCompiledGroup> groups_;
+	// Group id of each dictionary group, groups shared through components are compiled once
+	std::unordered_map<const FixGroupDef *, uint32_t> group_ids_;
+	std::vector<uint64_t> count_tag_bits_;
+	bool has_sparse_count_tags_ = false;
+};
+
+} // namespace duckdb
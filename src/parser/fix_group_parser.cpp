@@ -1,166 +1,198 @@
 #include "fix_group_parser.hpp"
-#include "duckdb/common/types/value.hpp"
-#include "duckdb/common/types.hpp"
 #include <algorithm>
 
 namespace duckdb {
 
-bool FixGroupParser::IsGroupField(int tag, const std::vector<int> &group_field_tags) {
-	for (int gf : group_field_tags) {
-		if (tag == gf) {
-			return true;
-		}
+size_t FixGroupParser::ParseGroupCount(const ParsedFixMessage::TagValue &value) {
+	// A count is a plain positive integer; each instance needs a tag, so larger counts only mean fewer
+	// instances than announced
+	if (value.data == nullptr || value.len == 0 || value.len > 9) {
+		return 0;
 	}
-	return false;
-}
-
-int FixGroupParser::GetGroupCount(const std::unordered_map<int, ParsedFixMessage::TagValue> &other_tags,
-                                  int count_tag) {
-	auto tag_it = other_tags.find(count_tag);
-	if (tag_it == other_tags.end()) {
-		return 0; // Group not present
-	}
-
-	try {
-		std::string count_str(tag_it->second.data, tag_it->second.len);
-		int count = std::stoi(count_str);
-
-		// Sanity check: reject invalid or excessive counts
-		if (count <= 0 || count > 100) {
+	size_t count = 0;
+	for (size_t i = 0; i < value.len; i++) {
+		unsigned digit = static_cast<unsigned char>(value.data[i]) - '0';
+		if (digit > 9) {
 			return 0;
 		}
-
-		return count;
-	} catch (...) {
-		return 0; // Invalid count
+		count = count * 10 + digit;
 	}
+	return count;
 }
 
-size_t FixGroupParser::FindCountTagPosition(const std::vector<std::pair<int, ParsedFixMessage::TagValue>> &ordered_tags,
-                                            int count_tag) {
-	for (size_t i = 0; i < ordered_tags.size(); i++) {
-		if (ordered_tags[i].first == count_tag) {
-			return i;
-		}
+void FixGroupParser::EnterGroup(uint32_t group_id, uint32_t parent, const ParsedFixMessage::TagValue &count,
+                                FixParsedGroups &result) {
+	auto group_count = ParseGroupCount(count);
+	if (group_count == 0) {
+		return; // Invalid count, the group is not parsed
 	}
-	return ordered_tags.size(); // Not found
+	result.stack.push_back({group_id, group_count, 0, parent, FIX_NO_GROUP, FIX_NO_GROUP});
 }
 
-vector<Value>
-FixGroupParser::ParseGroupInstances(const std::vector<std::pair<int, ParsedFixMessage::TagValue>> &ordered_tags,
-                                    size_t start_pos, int group_count, const std::vector<int> &group_field_tags) {
-	vector<Value> group_instances;
-	size_t pos = start_pos;
-
-	for (int instance = 0; instance < group_count && pos < ordered_tags.size(); instance++) {
-		// Parse one group instance
-		vector<Value> instance_map_entries;
-
-		// Collect tags that belong to this group instance
-		while (pos < ordered_tags.size()) {
-			int tag = ordered_tags[pos].first;
-
-			// Check if this tag belongs to the current group
-			if (!IsGroupField(tag, group_field_tags)) {
-				// Not a group field - either another group starts or non-group tag
+void FixGroupParser::StartInstance(const FixGroupLayout &layout, FixParsedGroups &result) {
+	auto &frame = result.stack.back();
+	if (frame.span == FIX_NO_GROUP) {
+		// All instances of a count tag in one parent go to one group
+		auto count_tag = layout.GetGroup(frame.group_id).count_tag;
+		auto &first = frame.parent == FIX_NO_GROUP ? result.first_group : result.found[frame.parent].first_group;
+		auto &last = frame.parent == FIX_NO_GROUP ? result.last_group : result.found[frame.parent].last_group;
+		for (auto g = first; g != FIX_NO_GROUP; g = result.found_groups[g].next) {
+			if (result.found_groups[g].count_tag == count_tag) {
+				frame.span = g;
 				break;
 			}
-
-			// Add this tag to the instance
-			auto &tag_value = ordered_tags[pos].second;
-			child_list_t<Value> map_entry;
-			map_entry.push_back(make_pair("key", Value::INTEGER(tag)));
-			map_entry.push_back(make_pair("value", Value(std::string(tag_value.data, tag_value.len))));
-			instance_map_entries.push_back(Value::STRUCT(map_entry));
-
-			pos++;
-
-			// Check if we've seen the first field again (marks next instance)
-			if (pos < ordered_tags.size() && !group_field_tags.empty() &&
-			    ordered_tags[pos].first == group_field_tags[0]) {
-				break;
+		}
+		if (frame.span == FIX_NO_GROUP) {
+			frame.span = static_cast<uint32_t>(result.found_groups.size());
+			result.found_groups.push_back({count_tag, FIX_NO_GROUP, FIX_NO_GROUP, FIX_NO_GROUP});
+			if (first == FIX_NO_GROUP) {
+				first = frame.span;
+			} else {
+				result.found_groups[last].next = frame.span;
 			}
+			last = frame.span;
 		}
+	}
+	auto instance = static_cast<uint32_t>(result.found.size());
+	auto &group = result.found_groups[frame.span];
+	if (group.first_instance == FIX_NO_GROUP) {
+		group.first_instance = instance;
+	} else {
+		result.found[group.last_instance].next = instance;
+	}
+	group.last_instance = instance;
+	frame.instance = instance;
+	frame.started++;
+	result.found.push_back({0, FIX_NO_GROUP, FIX_NO_GROUP, FIX_NO_GROUP});
+}
 
-		if (!instance_map_entries.empty()) {
-			// Create MAP for this instance
-			auto instance_map_type = LogicalType::MAP(LogicalType::INTEGER, LogicalType::VARCHAR);
-			auto instance_child_type = ListType::GetChildType(instance_map_type);
-			group_instances.push_back(Value::MAP(instance_child_type, instance_map_entries));
+void FixGroupParser::Finish(size_t tag_count, FixParsedGroups &result) {
+	// Breadth first, so that the groups of the message and those nested in each instance are contiguous, and the
+	// instances of each group too
+	result.group_order.clear();
+	for (auto g = result.first_group; g != FIX_NO_GROUP; g = result.found_groups[g].next) {
+		result.group_order.push_back(g);
+	}
+	result.message_group_count = result.group_order.size();
+	result.instance_order.resize(result.found.size());
+	for (size_t i = 0; i < result.group_order.size(); i++) {
+		auto &found_group = result.found_groups[result.group_order[i]];
+		result.groups.push_back({found_group.count_tag, result.instances.size(), 0});
+		for (auto f = found_group.first_instance; f != FIX_NO_GROUP; f = result.found[f].next) {
+			auto &found = result.found[f];
+			result.instance_order[f] = static_cast<uint32_t>(result.instances.size());
+			// end holds the number of tags until the fields are placed
+			FixGroupInstance instance {0, found.tag_count, result.group_order.size(), 0};
+			for (auto g = found.first_group; g != FIX_NO_GROUP; g = result.found_groups[g].next) {
+				result.group_order.push_back(g);
+				instance.group_count++;
+			}
+			result.instances.push_back(instance);
+			result.groups[i].instance_count++;
 		}
 	}
 
-	return group_instances;
+	// The tags of each instance are contiguous in fields; end counts up from begin as fields are placed
+	size_t field_offset = 0;
+	for (auto &instance : result.instances) {
+		auto tag_total = instance.end;
+		instance.begin = instance.end = field_offset;
+		field_offset += tag_total;
+	}
+	result.fields.resize(field_offset);
+	for (size_t pos = 0; pos < tag_count; pos++) {
+		auto owner = result.tag_owner[pos];
+		if (owner != FIX_NO_GROUP) {
+			result.fields[result.instances[result.instance_order[owner]].end++] = static_cast<uint32_t>(pos);
+		}
+	}
 }
 
-Value FixGroupParser::ParseGroups(const ParsedFixMessage &parsed, const FixDictionary &dict, bool needs_groups) {
-	// Early exit optimization - groups not requested
-	if (!needs_groups) {
-		return Value(); // NULL
-	}
+bool FixGroupParser::ParseGroups(const ParsedFixMessage &parsed, const FixGroupLayout &layout,
+                                 FixParsedGroups &result) {
+	result.clear();
 
 	// Validate prerequisites
-	if (parsed.all_tags_ordered.empty() || parsed.msg_type == nullptr || parsed.msg_type_len == 0) {
-		return Value(); // NULL
+	auto &msg_type = parsed.Hot<FixHotTags::MSG_TYPE>();
+	if (parsed.all_tags_ordered.empty() || msg_type.data == nullptr || msg_type.len == 0) {
+		return false;
 	}
 
-	// Look up message type in dictionary
-	std::string msg_type_str(parsed.msg_type, parsed.msg_type_len);
-	auto msg_it = dict.messages.find(msg_type_str);
-
-	if (msg_it == dict.messages.end()) {
-		// Message type not in dictionary - no groups to parse
-		return Value();
+	// Message type not in dictionary or without groups - no groups to parse
+	auto message_id = layout.GetMessageId(msg_type.data, msg_type.len);
+	if (message_id == FixGroupLayout::NO_MESSAGE) {
+		return false;
 	}
-
-	const auto &message_def = msg_it->second;
-	vector<Value> outer_map_entries;
-
-	// Iterate through all groups defined for this message type
-	for (const auto &[count_tag, group_def] : message_def.groups) {
-		// Check if this group exists in the message
-		int group_count = GetGroupCount(parsed.other_tags, count_tag);
-		if (group_count == 0) {
-			continue; // Group not present or invalid count
+	auto &message = layout.GetMessage(message_id);
+
+	auto &ordered_tags = parsed.all_tags_ordered;
+	result.stack.clear();
+	result.found_groups.clear();
+	result.found.clear();
+	result.first_group = result.last_group = FIX_NO_GROUP;
+	result.seen.assign(message.groups.size(), 0);
+	result.tag_owner.assign(ordered_tags.size(), FIX_NO_GROUP);
+
+	for (size_t pos = 0; pos < ordered_tags.size(); pos++) {
+		int tag = ordered_tags[pos].first;
+
+		// Leave the groups the tag does not belong to, innermost first
+		while (!result.stack.empty()) {
+			auto &frame = result.stack.back();
+			auto &group = layout.GetGroup(frame.group_id);
+			if (!group.HasField(tag)) {
+				// Not a group field - either an enclosing group continues or a non-group tag
+				result.stack.pop_back();
+				continue;
+			}
+			// The first field starts the next instance
+			if (frame.instance == FIX_NO_GROUP || tag == group.first_field) {
+				if (frame.started == frame.count) {
+					result.stack.pop_back();
+					continue;
+				}
+				StartInstance(layout, result);
+			}
+			break;
 		}
 
-		// Get field tags from dictionary (dereference shared_ptr)
-		const std::vector<int> &group_field_tags = group_def->field_tags;
-		if (group_field_tags.empty()) {
-			continue; // No fields defined for this group
+		if (!result.stack.empty()) {
+			auto &frame = result.stack.back();
+			result.tag_owner[pos] = frame.instance;
+			result.found[frame.instance].tag_count++;
+			// A nested group's count tag is a field of the instance and opens the nested group
+			auto &group = layout.GetGroup(frame.group_id);
+			if (!group.subgroups.empty()) {
+				auto sub_id = FindFixGroup(group.subgroups, tag);
+				if (sub_id != FIX_NO_GROUP) {
+					EnterGroup(sub_id, frame.instance, ordered_tags[pos].second, result);
+				}
+			}
+			continue;
 		}
 
-		// Find the position of the count tag in ordered list
-		size_t count_tag_pos = FindCountTagPosition(parsed.all_tags_ordered, count_tag);
-		if (count_tag_pos >= parsed.all_tags_ordered.size()) {
-			continue; // Count tag not found in ordered list
+		// Message level: only the first occurrence of a count tag of this message type starts a group
+		if (!layout.MayBeCountTag(tag)) {
+			continue;
 		}
-
-		// Parse group instances from ordered tags starting after count tag
-		auto group_instances =
-		    ParseGroupInstances(parsed.all_tags_ordered, count_tag_pos + 1, group_count, group_field_tags);
-
-		if (!group_instances.empty()) {
-			// Create outer map entry for this group
-			child_list_t<Value> outer_struct;
-			outer_struct.push_back(make_pair("key", Value::INTEGER(count_tag)));
-
-			// Create LIST value with the correct child type
-			auto instance_map_type = LogicalType::MAP(LogicalType::INTEGER, LogicalType::VARCHAR);
-			outer_struct.push_back(make_pair("value", Value::LIST(instance_map_type, group_instances)));
-			outer_map_entries.push_back(Value::STRUCT(outer_struct));
+		auto entry = std::lower_bound(message.groups.begin(), message.groups.end(), tag,
+		                              [](const std::pair<int, uint32_t> &group, int t) { return group.first < t; });
+		if (entry == message.groups.end() || entry->first != tag) {
+			continue; // Count tag of another message type
 		}
+		auto group_idx = static_cast<size_t>(entry - message.groups.begin());
+		if (result.seen[group_idx]) {
+			continue;
+		}
+		result.seen[group_idx] = 1;
+		EnterGroup(entry->second, FIX_NO_GROUP, ordered_tags[pos].second, result);
 	}
 
-	if (outer_map_entries.empty()) {
-		return Value(); // NULL if no groups found
+	if (result.found.empty()) {
+		return false;
 	}
-
-	// Create final nested MAP
-	auto outer_map_type = LogicalType::MAP(
-	    LogicalType::INTEGER, LogicalType::LIST(LogicalType::MAP(LogicalType::INTEGER, LogicalType::VARCHAR)));
-	auto outer_child_type = ListType::GetChildType(outer_map_type);
-	return Value::MAP(outer_child_type, outer_map_entries);
+	Finish(ordered_tags.size(), result);
+	return true;
 }
 
 } // namespace duckdb
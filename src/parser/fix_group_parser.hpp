@@ -1,35 +1,119 @@
 #pragma once
 
-#include "duckdb/common/types/value.hpp"
 #include "parser/fix_message.hpp"
-#include "dictionary/fix_dictionary.hpp"
+#include "parser/fix_group_layout.hpp"
 #include <string>
+#include <vector>
 
 namespace duckdb {
 
+// One instance of a repeating group: its tags are fields[begin, end) of FixParsedGroups, in message order
+// The groups nested in it are groups[group_begin, group_begin + group_count); their count tags are tags of the
+// instance, their instances' tags are not
+struct FixGroupInstance {
+	size_t begin;
+	size_t end;
+	size_t group_begin;
+	size_t group_count;
+};
+
+// One repeating group of a message or of an instance
+// Its instances are instances[instance_begin, instance_begin + instance_count)
+struct FixGroupSpan {
+	int count_tag;
+	size_t instance_begin;
+	size_t instance_count;
+};
+
+// Repeating groups of one message, described as offsets into its ordered tag list
+// The message's groups come first, then the groups nested in each instance, instance by instance
+// Reused across messages so that steady-state parsing does not allocate
+struct FixParsedGroups {
+	std::vector<FixGroupSpan> groups;
+	// Groups of the message itself, groups[0, message_group_count)
+	size_t message_group_count = 0;
+	std::vector<FixGroupInstance> instances;
+	// Positions in the ordered tag list of the tags of each instance
+	std::vector<uint32_t> fields;
+
+	// Scratch space of the parser
+	struct Frame {
+		uint32_t group_id;
+		// Instances announced by the count tag and started so far
+		size_t count;
+		size_t started;
+		// Found instance holding the count tag (FIX_NO_GROUP at message level)
+		uint32_t parent;
+		// Found group (FIX_NO_GROUP until the first instance starts) and open instance
+		uint32_t span;
+		uint32_t instance;
+	};
+	// Groups and instances in the order they start, linked into lists so that layout does not allocate
+	struct FoundGroup {
+		int count_tag;
+		// Next group of the same parent, first and last instance
+		uint32_t next;
+		uint32_t first_instance;
+		uint32_t last_instance;
+	};
+	struct FoundInstance {
+		uint32_t tag_count;
+		// Next instance of the same group, first and last nested group
+		uint32_t next;
+		uint32_t first_group;
+		uint32_t last_group;
+	};
+	std::vector<Frame> stack;
+	// Count tags of the message's groups already seen, only the first occurrence of a count tag is used
+	std::vector<uint8_t> seen;
+	// Instance owning each tag of the message (FIX_NO_GROUP for tags outside groups)
+	std::vector<uint32_t> tag_owner;
+	std::vector<FoundGroup> found_groups;
+	std::vector<FoundInstance> found;
+	// First and last group of the message itself
+	uint32_t first_group;
+	uint32_t last_group;
+	// Found groups in layout order, and the position in instances of each found instance
+	std::vector<uint32_t> group_order;
+	std::vector<uint32_t> instance_order;
+
+	void clear() {
+		groups.clear();
+		message_group_count = 0;
+		instances.clear();
+		fields.clear();
+	}
+
+	bool empty() const {
+		return groups.empty();
+	}
+};
+
 // Parser for FIX repeating groups
-// Extracts repeating group instances from ordered tag list using dictionary definitions
+// Extracts repeating group instances from ordered tag list using a compiled dictionary
 class FixGroupParser {
 public:
-	// Parse all groups for a message and return MAP value
-	// Returns NULL if no groups found or groups not needed
-	static Value ParseGroups(const ParsedFixMessage &parsed, const FixDictionary &dict, bool needs_groups);
+	// Find all groups of a message, nested groups included, result is cleared first
+	// A single pass over the message's tags with a stack of the groups it is in
+	// A nested group belongs to the instance its count tag is in; the groups of a message or of an instance are
+	// returned in the order their first instance appears in the message
+	// Returns false if no groups were found
+	static bool ParseGroups(const ParsedFixMessage &parsed, const FixGroupLayout &layout, FixParsedGroups &result);
 
 private:
-	// Parse instances of a single group
-	static vector<Value>
-	ParseGroupInstances(const std::vector<std::pair<int, ParsedFixMessage::TagValue>> &ordered_tags, size_t start_pos,
-	                    int group_count, const std::vector<int> &group_field_tags);
+	// Group count from the value of a count tag, 0 if it is invalid
+	static size_t ParseGroupCount(const ParsedFixMessage::TagValue &value);
 
-	// Check if a tag belongs to a group's field list
-	static bool IsGroupField(int tag, const std::vector<int> &group_field_tags);
+	// Push a group announced by a count tag onto the stack, if its count is valid
+	// parent is the instance holding the count tag, FIX_NO_GROUP at message level
+	static void EnterGroup(uint32_t group_id, uint32_t parent, const ParsedFixMessage::TagValue &count,
+	                       FixParsedGroups &result);
 
-	// Get group count from other_tags map
-	static int GetGroupCount(const std::unordered_map<int, ParsedFixMessage::TagValue> &other_tags, int count_tag);
+	// Start a new instance of the group on top of the stack
+	static void StartInstance(const FixGroupLayout &layout, FixParsedGroups &result);
 
-	// Find position of count tag in ordered list
-	static size_t FindCountTagPosition(const std::vector<std::pair<int, ParsedFixMessage::TagValue>> &ordered_tags,
-	                                   int count_tag);
+	// Lay out the found groups breadth first and their instances group by group
+	static void Finish(size_t tag_count, FixParsedGroups &result);
 };
 
 } // namespace duckdb
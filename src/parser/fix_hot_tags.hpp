@@ -5,8 +5,8 @@
 namespace duckdb {
 
 // Centralized hot tag definitions for FIX protocol
-// These 19 tags are hardcoded for performance-critical parsing
-// All other tags are routed through the dictionary-driven other_tags map
+// These 19 tags always have direct-indexed value slots (see FixTagLayout)
+// All other tags are looked up in the message's ordered tag list, unless a query promotes them to slots
 namespace FixHotTags {
 
 // Hot tag constants - the 19 most commonly used FIX tags
@@ -37,33 +37,19 @@ constexpr int ALL_TAGS[] = {MSG_TYPE, SENDER_COMP_ID, TARGET_COMP_ID, MSG_SEQ_NU
 
 constexpr size_t NUM_HOT_TAGS = 19;
 
-// Helper function to check if a tag number is a hot tag
-// Uses efficient switch statement for O(1) lookup
-inline bool IsHotTag(int tag) {
-	switch (tag) {
-	case MSG_TYPE:
-	case SENDER_COMP_ID:
-	case TARGET_COMP_ID:
-	case MSG_SEQ_NUM:
-	case SENDING_TIME:
-	case CL_ORD_ID:
-	case ORDER_ID:
-	case EXEC_ID:
-	case SYMBOL:
-	case SIDE:
-	case EXEC_TYPE:
-	case ORD_STATUS:
-	case PRICE:
-	case ORDER_QTY:
-	case CUM_QTY:
-	case LEAVES_QTY:
-	case LAST_PX:
-	case LAST_QTY:
-	case TEXT:
-		return true;
-	default:
-		return false;
+// Value slot of a hot tag in ParsedFixMessage: its position in ALL_TAGS, which is also its column index
+constexpr size_t HotSlot(int tag) {
+	for (size_t i = 0; i < NUM_HOT_TAGS; i++) {
+		if (ALL_TAGS[i] == tag) {
+			return i;
+		}
 	}
+	return NUM_HOT_TAGS;
+}
+
+// Whether a tag is one of the hot tags
+constexpr bool IsHotTag(int tag) {
+	return HotSlot(tag) < NUM_HOT_TAGS;
 }
 
 } // namespace FixHotTags
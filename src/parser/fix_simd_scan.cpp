@@ -0,0 +1,159 @@
+#include "fix_simd_scan.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define QUACKFIX_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+// MSVC allows AVX2 intrinsics in any function
+#define QUACKFIX_TARGET_AVX2
+#else
+#define QUACKFIX_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define QUACKFIX_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Portable fallback, one byte at a time
+static uint64_t ClassifyScalar(const char *block, char delimiter) {
+	uint64_t mask = 0;
+	for (size_t i = 0; i < FIX_SCAN_BLOCK_SIZE; i++) {
+		char c = block[i];
+		mask |= static_cast<uint64_t>(c == delimiter || c == '=') << i;
+	}
+	return mask;
+}
+
+#ifdef QUACKFIX_SIMD_X86
+// SSE2 is part of the x86-64 baseline, four 16-byte compares per block
+static uint64_t ClassifySSE2(const char *block, char delimiter) {
+	const __m128i delim = _mm_set1_epi8(delimiter);
+	const __m128i equals = _mm_set1_epi8('=');
+	uint64_t mask = 0;
+	for (size_t i = 0; i < FIX_SCAN_BLOCK_SIZE; i += 16) {
+		__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+		__m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, delim), _mm_cmpeq_epi8(bytes, equals));
+		mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(hits))) << i;
+	}
+	return mask;
+}
+
+// AVX2, two 32-byte compares per block (only called after the CPU check)
+QUACKFIX_TARGET_AVX2 static uint64_t ClassifyAVX2(const char *block, char delimiter) {
+	const __m256i delim = _mm256_set1_epi8(delimiter);
+	const __m256i equals = _mm256_set1_epi8('=');
+	__m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+	__m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+	__m256i lo_hits = _mm256_or_si256(_mm256_cmpeq_epi8(lo, delim), _mm256_cmpeq_epi8(lo, equals));
+	__m256i hi_hits = _mm256_or_si256(_mm256_cmpeq_epi8(hi, delim), _mm256_cmpeq_epi8(hi, equals));
+	uint64_t lo_mask = static_cast<uint32_t>(_mm256_movemask_epi8(lo_hits));
+	uint64_t hi_mask = static_cast<uint32_t>(_mm256_movemask_epi8(hi_hits));
+	return lo_mask | (hi_mask << 32);
+}
+
+static bool CPUSupportsAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	__cpuid(info, 1);
+	// The OS must save the YMM registers (OSXSAVE + XCR0 bits 1 and 2)
+	bool os_saves_ymm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+	if (!os_saves_ymm) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	// Also checks that the OS has enabled the AVX state
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#ifdef QUACKFIX_SIMD_NEON
+// NEON: compare 4x16 bytes, then fold the byte masks into 64 bits with pairwise adds
+static uint64_t ClassifyNEON(const char *block, char delimiter) {
+	static const uint8_t BIT_WEIGHTS[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+	                                        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+	const uint8x16_t weights = vld1q_u8(BIT_WEIGHTS);
+	const uint8x16_t delim = vdupq_n_u8(static_cast<uint8_t>(delimiter));
+	const uint8x16_t equals = vdupq_n_u8('=');
+	auto bytes = reinterpret_cast<const uint8_t *>(block);
+
+	uint8x16_t hits[4];
+	for (int i = 0; i < 4; i++) {
+		uint8x16_t chunk = vld1q_u8(bytes + 16 * i);
+		hits[i] = vandq_u8(vorrq_u8(vceqq_u8(chunk, delim), vceqq_u8(chunk, equals)), weights);
+	}
+	uint8x16_t sum = vpaddq_u8(vpaddq_u8(hits[0], hits[1]), vpaddq_u8(hits[2], hits[3]));
+	sum = vpaddq_u8(sum, sum);
+	return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+}
+#endif
+
+FixClassifyFunction FixSimdScan::GetClassifier(FixSimdLevel level) {
+	switch (level) {
+	case FixSimdLevel::SCALAR:
+		return ClassifyScalar;
+#ifdef QUACKFIX_SIMD_X86
+	case FixSimdLevel::SSE2:
+		return ClassifySSE2;
+	case FixSimdLevel::AVX2:
+		return CPUSupportsAVX2() ? ClassifyAVX2 : nullptr;
+#endif
+#ifdef QUACKFIX_SIMD_NEON
+	case FixSimdLevel::NEON:
+		return ClassifyNEON;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+static FixSimdLevel DetectLevel() {
+#if defined(QUACKFIX_SIMD_X86)
+	return CPUSupportsAVX2() ? FixSimdLevel::AVX2 : FixSimdLevel::SSE2;
+#elif defined(QUACKFIX_SIMD_NEON)
+	return FixSimdLevel::NEON;
+#else
+	return FixSimdLevel::SCALAR;
+#endif
+}
+
+FixSimdLevel FixSimdScan::GetLevel() {
+	static const FixSimdLevel level = DetectLevel();
+	return level;
+}
+
+FixClassifyFunction FixSimdScan::GetClassifier() {
+	static const FixClassifyFunction classify = GetClassifier(GetLevel());
+	return classify;
+}
+
+const char *FixSimdScan::GetLevelName(FixSimdLevel level) {
+	switch (level) {
+	case FixSimdLevel::SSE2:
+		return "sse2";
+	case FixSimdLevel::AVX2:
+		return "avx2";
+	case FixSimdLevel::NEON:
+		return "neon";
+	default:
+		return "scalar";
+	}
+}
+
+uint64_t FixSimdScan::ClassifyTail(FixClassifyFunction classify, const char *data, size_t len, char delimiter) {
+	if (len == 0) {
+		return 0;
+	}
+	// Copy into a padded block so the kernel never reads past the end of the buffer
+	char block[FIX_SCAN_BLOCK_SIZE];
+	memset(block, 0, FIX_SCAN_BLOCK_SIZE);
+	memcpy(block, data, len);
+	return classify(block, delimiter) & ((static_cast<uint64_t>(1) << len) - 1);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Vectorized byte classification for the FIX tokenizer
+// A classifier marks every byte of a 64-byte block that is the field delimiter or '=',
+// so the tokenizer can find all tag/value boundaries in one pass over the message
+// Kernels exist for SSE2 and AVX2 (x86-64), NEON (ARM64) and plain C++; the best kernel the
+// host CPU supports is picked at runtime, so a single binary runs everywhere
+
+enum class FixSimdLevel : uint8_t { SCALAR = 0, SSE2 = 1, AVX2 = 2, NEON = 3 };
+
+// Returns a bitmask with bit i set if block[i] is delimiter or '='
+// block must have FIX_SCAN_BLOCK_SIZE readable bytes
+typedef uint64_t (*FixClassifyFunction)(const char *block, char delimiter);
+
+static constexpr size_t FIX_SCAN_BLOCK_SIZE = 64;
+
+class FixSimdScan {
+public:
+	// Best kernel supported by the host CPU (detected once)
+	static FixClassifyFunction GetClassifier();
+
+	// Kernel for a specific level, nullptr if it is not compiled in or not supported by the CPU
+	static FixClassifyFunction GetClassifier(FixSimdLevel level);
+
+	// Best level supported by the host CPU (detected once)
+	static FixSimdLevel GetLevel();
+
+	static const char *GetLevelName(FixSimdLevel level);
+
+	// Classify the remaining len (< FIX_SCAN_BLOCK_SIZE) bytes at the end of a buffer
+	// Bytes past len are never read and their bits are always clear
+	static uint64_t ClassifyTail(FixClassifyFunction classify, const char *data, size_t len, char delimiter);
+
+	// Index of the lowest set bit, mask must not be zero
+	static inline unsigned CountTrailingZeros(uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_ARM64))
+		unsigned long index;
+		_BitScanForward64(&index, mask);
+		return static_cast<unsigned>(index);
+#elif defined(_MSC_VER) && !defined(__clang__)
+		unsigned index = 0;
+		while (!(mask & 1)) {
+			mask >>= 1;
+			index++;
+		}
+		return index;
+#else
+		return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+	}
+};
@@ -0,0 +1,287 @@
+#include "fix_sparse_index.hpp"
+#include "fix_type_conversions.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+
+// File magic, the last byte is the format version
+static const char FIX_INDEX_MAGIC[8] = {'Q', 'F', 'I', 'D', 'X', '\0', '\0', '\1'};
+
+// Bytes hashed at each end of a file for its stamp
+static constexpr idx_t FIX_INDEX_STAMP_BYTES = 4096;
+
+int64_t FixIndexValueSet::Find(const char *data, size_t len) const {
+	for (idx_t i = 0; i < values.size(); i++) {
+		if (values[i].size() == len && memcmp(values[i].data(), data, len) == 0) {
+			return static_cast<int64_t>(i);
+		}
+	}
+	return -1;
+}
+
+uint64_t FixSparseIndex::ComputeStamp(FileHandle &handle, idx_t file_size) {
+	auto sample_size = MinValue<idx_t>(file_size, FIX_INDEX_STAMP_BYTES);
+	auto sample = unique_ptr<char[]>(new char[sample_size > 0 ? sample_size : 1]);
+	hash_t stamp = Hash(static_cast<uint64_t>(file_size));
+	if (sample_size > 0) {
+		handle.Read(sample.get(), sample_size, 0);
+		stamp = CombineHash(stamp, Hash(sample.get(), sample_size));
+		handle.Read(sample.get(), sample_size, file_size - sample_size);
+		stamp = CombineHash(stamp, Hash(sample.get(), sample_size));
+	}
+	return stamp;
+}
+
+bool FixSparseIndex::TryLoad(FileSystem &fs, const string &file, FileHandle &handle, FixSparseIndex &result) {
+	// The index is only an accelerator: a missing, unreadable or stale sidecar means a full scan
+	try {
+		auto index_path = GetIndexPath(file);
+		if (!fs.FileExists(index_path)) {
+			return false;
+		}
+		auto index_handle = fs.OpenFile(index_path, FileOpenFlags::FILE_FLAGS_READ);
+		auto index_size = index_handle->GetFileSize();
+		string data(index_size, '\0');
+		index_handle->Read(&data[0], index_size);
+		if (!Deserialize(data, result)) {
+			return false;
+		}
+		auto file_size = handle.GetFileSize();
+		return result.file_size == file_size && result.stamp == ComputeStamp(handle, file_size);
+	} catch (const std::exception &) {
+		return false;
+	}
+}
+
+template <class T>
+static void WriteValue(string &out, T value) {
+	out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+string FixSparseIndex::Serialize() const {
+	string out(FIX_INDEX_MAGIC, sizeof(FIX_INDEX_MAGIC));
+	WriteValue<uint8_t>(out, static_cast<uint8_t>(delimiter));
+	WriteValue<uint64_t>(out, block_lines);
+	WriteValue<uint64_t>(out, file_size);
+	WriteValue<uint64_t>(out, stamp);
+
+	WriteValue<uint64_t>(out, blocks.size());
+	for (auto &block : blocks) {
+		WriteValue<uint64_t>(out, block.start);
+		WriteValue<uint64_t>(out, block.end);
+		WriteValue<uint64_t>(out, block.line_count);
+		for (auto zone : {&block.seq_num, &block.sending_time}) {
+			WriteValue<uint8_t>(out, zone->has_values);
+			WriteValue<int64_t>(out, zone->min);
+			WriteValue<int64_t>(out, zone->max);
+		}
+	}
+
+	for (auto &set : sets) {
+		WriteValue<uint8_t>(out, set.indexed);
+		if (!set.indexed) {
+			continue;
+		}
+		WriteValue<uint64_t>(out, set.values.size());
+		for (auto &value : set.values) {
+			WriteValue<uint32_t>(out, static_cast<uint32_t>(value.size()));
+			out += value;
+		}
+		WriteValue<uint64_t>(out, set.words_per_block);
+		for (auto word : set.bits) {
+			WriteValue<uint64_t>(out, word);
+		}
+	}
+	return out;
+}
+
+// Bounds-checked reads from a serialized index
+struct FixIndexReader {
+	const string &data;
+	idx_t pos = 0;
+	bool ok = true;
+
+	explicit FixIndexReader(const string &data_p) : data(data_p) {
+	}
+
+	template <class T>
+	T Read() {
+		T value {};
+		if (!ok || data.size() - pos < sizeof(T)) {
+			ok = false;
+			return value;
+		}
+		memcpy(&value, data.data() + pos, sizeof(T));
+		pos += sizeof(T);
+		return value;
+	}
+
+	// Element counts are checked against the remaining bytes before anything is allocated
+	bool CanRead(uint64_t count, idx_t element_size) {
+		ok = ok && count <= (data.size() - pos) / element_size;
+		return ok;
+	}
+};
+
+bool FixSparseIndex::Deserialize(const string &data, FixSparseIndex &result) {
+	if (data.size() < sizeof(FIX_INDEX_MAGIC) || memcmp(data.data(), FIX_INDEX_MAGIC, sizeof(FIX_INDEX_MAGIC)) != 0) {
+		return false;
+	}
+	FixIndexReader reader(data);
+	reader.pos = sizeof(FIX_INDEX_MAGIC);
+	result.delimiter = static_cast<char>(reader.Read<uint8_t>());
+	result.block_lines = reader.Read<uint64_t>();
+	result.file_size = reader.Read<uint64_t>();
+	result.stamp = reader.Read<uint64_t>();
+
+	// start, end, line_count and two zones
+	static constexpr idx_t BLOCK_BYTES = 3 * sizeof(uint64_t) + 2 * (1 + 2 * sizeof(int64_t));
+	auto block_count = reader.Read<uint64_t>();
+	if (!reader.CanRead(block_count, BLOCK_BYTES)) {
+		return false;
+	}
+	result.blocks.resize(block_count);
+	idx_t previous_end = 0;
+	for (auto &block : result.blocks) {
+		block.start = reader.Read<uint64_t>();
+		block.end = reader.Read<uint64_t>();
+		block.line_count = reader.Read<uint64_t>();
+		for (auto zone : {&block.seq_num, &block.sending_time}) {
+			zone->has_values = reader.Read<uint8_t>() != 0;
+			zone->min = reader.Read<int64_t>();
+			zone->max = reader.Read<int64_t>();
+		}
+		// Blocks are in file order and do not overlap
+		if (block.start < previous_end || block.start > block.end || block.end > result.file_size) {
+			return false;
+		}
+		previous_end = block.end;
+	}
+
+	for (auto &set : result.sets) {
+		set = FixIndexValueSet();
+		set.indexed = reader.Read<uint8_t>() != 0;
+		if (!set.indexed) {
+			continue;
+		}
+		auto value_count = reader.Read<uint64_t>();
+		if (!reader.CanRead(value_count, sizeof(uint32_t))) {
+			return false;
+		}
+		set.values.resize(value_count);
+		for (auto &value : set.values) {
+			auto len = reader.Read<uint32_t>();
+			if (!reader.CanRead(len, 1)) {
+				return false;
+			}
+			value.assign(data.data() + reader.pos, len);
+			reader.pos += len;
+		}
+		set.words_per_block = reader.Read<uint64_t>();
+		if (set.words_per_block != (value_count + 63) / 64 ||
+		    !reader.CanRead(block_count * set.words_per_block, sizeof(uint64_t))) {
+			return false;
+		}
+		set.bits.resize(block_count * set.words_per_block);
+		for (auto &word : set.bits) {
+			word = reader.Read<uint64_t>();
+		}
+	}
+	return reader.ok && reader.pos == data.size();
+}
+
+FixSparseIndexBuilder::FixSparseIndexBuilder(char delimiter, idx_t block_lines) {
+	index_.delimiter = delimiter;
+	index_.block_lines = block_lines;
+}
+
+void FixSparseIndexBuilder::AddValue(idx_t set_idx, const ParsedFixMessage::TagValue &value) {
+	auto &set = index_.sets[set_idx];
+	if (!set.indexed || value.data == nullptr || value.len == 0) {
+		return;
+	}
+	auto &ids = value_ids_[set_idx];
+	auto entry = ids.find(string(value.data, value.len));
+	uint32_t id;
+	if (entry != ids.end()) {
+		id = entry->second;
+	} else {
+		if (set.values.size() >= FixIndexValueSet::MAX_VALUES) {
+			// Too many distinct values to be selective
+			set.indexed = false;
+			set.values.clear();
+			ids.clear();
+			block_values_[set_idx].clear();
+			return;
+		}
+		id = static_cast<uint32_t>(set.values.size());
+		set.values.emplace_back(value.data, value.len);
+		ids.emplace(set.values.back(), id);
+	}
+	// Blocks hold few distinct values, a linear search keeps each id once
+	auto &block_ids = block_values_[set_idx].back();
+	if (std::find(block_ids.begin(), block_ids.end(), id) == block_ids.end()) {
+		block_ids.push_back(id);
+	}
+}
+
+void FixSparseIndexBuilder::AddLine(idx_t offset, const ParsedFixMessage &parsed) {
+	if (line_count_ % index_.block_lines == 0) {
+		if (!index_.blocks.empty()) {
+			index_.blocks.back().end = offset;
+		}
+		index_.blocks.emplace_back();
+		index_.blocks.back().start = offset;
+		for (idx_t set_idx = 0; set_idx < FixSparseIndex::SET_COLUMN_COUNT; set_idx++) {
+			if (index_.sets[set_idx].indexed) {
+				block_values_[set_idx].emplace_back();
+			}
+		}
+	}
+	line_count_++;
+
+	// Values are converted exactly as read_fix converts its columns
+	auto &block = index_.blocks.back();
+	block.line_count++;
+	auto &seq_num = parsed.Hot<FixHotTags::MSG_SEQ_NUM>();
+	int64_t seq_num_value;
+	if (ConvertToInt64(seq_num.data, seq_num.len, seq_num_value, nullptr, nullptr)) {
+		block.seq_num.Add(seq_num_value);
+	}
+	auto &sending_time = parsed.Hot<FixHotTags::SENDING_TIME>();
+	timestamp_t sending_time_value;
+	if (ConvertToTimestamp(sending_time.data, sending_time.len, sending_time_value, nullptr, nullptr)) {
+		block.sending_time.Add(sending_time_value.value);
+	}
+
+	AddValue(FixSparseIndex::MSG_TYPE, parsed.Hot<FixHotTags::MSG_TYPE>());
+	AddValue(FixSparseIndex::SENDER_COMP_ID, parsed.Hot<FixHotTags::SENDER_COMP_ID>());
+	AddValue(FixSparseIndex::TARGET_COMP_ID, parsed.Hot<FixHotTags::TARGET_COMP_ID>());
+}
+
+FixSparseIndex FixSparseIndexBuilder::Finish(idx_t file_size, uint64_t stamp) {
+	index_.file_size = file_size;
+	index_.stamp = stamp;
+	if (!index_.blocks.empty()) {
+		index_.blocks.back().end = file_size;
+	}
+
+	for (idx_t set_idx = 0; set_idx < FixSparseIndex::SET_COLUMN_COUNT; set_idx++) {
+		auto &set = index_.sets[set_idx];
+		if (!set.indexed) {
+			continue;
+		}
+		set.words_per_block = (set.values.size() + 63) / 64;
+		set.bits.assign(index_.blocks.size() * set.words_per_block, 0);
+		for (idx_t block = 0; block < block_values_[set_idx].size(); block++) {
+			for (auto id : block_values_[set_idx][block]) {
+				set.bits[block * set.words_per_block + id / 64] |= static_cast<uint64_t>(1) << (id % 64);
+			}
+		}
+	}
+	return std::move(index_);
+}
+
+} // namespace duckdb
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "duckdb/common/file_system.hpp"
+#include "parser/fix_message.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace duckdb {
+
+// Sparse index of a FIX log, stored in a sidecar file next to it (<log>.qfidx)
+// The log is cut into blocks of block_lines lines; each block records its byte range, min/max MsgSeqNum
+// and SendingTime, and which MsgType / SenderCompID / TargetCompID values occur in it
+// read_fix splits files along block boundaries and skips blocks that cannot match the pushed filters
+// A sidecar is only used while the log still has the size and head/tail bytes it was built from
+
+// Min/max of the non-NULL values of an integer column in one block
+struct FixIndexZone {
+	bool has_values = false;
+	int64_t min = 0;
+	int64_t max = 0;
+
+	void Add(int64_t value) {
+		if (!has_values) {
+			min = max = value;
+			has_values = true;
+		} else {
+			min = MinValue(min, value);
+			max = MaxValue(max, value);
+		}
+	}
+};
+
+struct FixIndexBlock {
+	// Byte range [start, end) of the block, start is the first byte of a line
+	idx_t start = 0;
+	idx_t end = 0;
+	idx_t line_count = 0;
+	FixIndexZone seq_num;
+	// Microseconds since epoch
+	FixIndexZone sending_time;
+};
+
+// Distinct values of a VARCHAR column and a bitset per block of the values that occur in it
+// Columns with more than MAX_VALUES distinct values are not indexed
+struct FixIndexValueSet {
+	static constexpr idx_t MAX_VALUES = 1024;
+
+	bool indexed = true;
+	vector<string> values;
+	// words_per_block words per block
+	idx_t words_per_block = 0;
+	vector<uint64_t> bits;
+
+	// Index of value in values, -1 if it never occurs in the file
+	int64_t Find(const char *data, size_t len) const;
+
+	bool BlockHas(idx_t block, idx_t value_idx) const {
+		return (bits[block * words_per_block + value_idx / 64] >> (value_idx % 64)) & 1;
+	}
+};
+
+class FixSparseIndex {
+public:
+	static constexpr idx_t DEFAULT_BLOCK_LINES = 4096;
+
+	// Value set columns, by hot tag
+	enum SetColumn : uint8_t { MSG_TYPE = 0, SENDER_COMP_ID = 1, TARGET_COMP_ID = 2, SET_COLUMN_COUNT = 3 };
+
+	char delimiter = '|';
+	idx_t block_lines = DEFAULT_BLOCK_LINES;
+	idx_t file_size = 0;
+	uint64_t stamp = 0;
+	vector<FixIndexBlock> blocks;
+	FixIndexValueSet sets[SET_COLUMN_COUNT];
+
+	static string GetIndexPath(const string &file) {
+		return file + ".qfidx";
+	}
+
+	// Fingerprint of a file: its size and a hash of its first and last bytes
+	static uint64_t ComputeStamp(FileHandle &handle, idx_t file_size);
+
+	// Load the sidecar of file, returns false if there is none or it does not match the file
+	// handle must be an open, seekable handle of file
+	static bool TryLoad(FileSystem &fs, const string &file, FileHandle &handle, FixSparseIndex &result);
+
+	string Serialize() const;
+	static bool Deserialize(const string &data, FixSparseIndex &result);
+};
+
+// Builds the sparse index of one file from its lines, in file order
+class FixSparseIndexBuilder {
+public:
+	FixSparseIndexBuilder(char delimiter, idx_t block_lines);
+
+	// Add a line and the message parsed from it (parsed with the same delimiter)
+	void AddLine(idx_t offset, const ParsedFixMessage &parsed);
+
+	// Finish the index of a file of file_size bytes with the given stamp
+	FixSparseIndex Finish(idx_t file_size, uint64_t stamp);
+
+	idx_t LineCount() const {
+		return line_count_;
+	}
+
+private:
+	void AddValue(idx_t set, const ParsedFixMessage::TagValue &value);
+
+	FixSparseIndex index_;
+	idx_t line_count_ = 0;
+	// Value id of each distinct value of each set column
+	std::unordered_map<string, uint32_t> value_ids_[FixSparseIndex::SET_COLUMN_COUNT];
+	// Value ids of each set column seen in each block so far
+	vector<vector<uint32_t>> block_values_[FixSparseIndex::SET_COLUMN_COUNT];
+};
+
+} // namespace duckdb
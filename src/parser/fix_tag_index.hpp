@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Small open-addressing table that de-duplicates the tags of one message
+// Maps each distinct tag to the position of its last occurrence in the ordered tag list
+// Reused across messages: generation stamps make Reset O(1) and the table never shrinks
+class FixTagIndex {
+public:
+	// Prepare for a message with up to max_tags tags
+	void Reset(size_t max_tags) {
+		size_t needed = 16;
+		while (needed < max_tags * 2) {
+			needed <<= 1;
+		}
+		if (needed > slots_.size()) {
+			slots_.assign(needed, Slot());
+			generation_ = 0;
+		}
+		generation_++;
+		if (generation_ == 0) {
+			// Stamps wrapped around - invalidate every slot explicitly
+			for (auto &slot : slots_) {
+				slot.generation = 0;
+			}
+			generation_ = 1;
+		}
+		mask_ = slots_.size() - 1;
+		positions_.clear();
+	}
+
+	// Record an occurrence of tag at position, a repeated tag keeps its place but takes the new position
+	void Insert(int tag, uint32_t position) {
+		size_t idx = (static_cast<uint32_t>(tag) * 2654435761U) & mask_;
+		while (true) {
+			auto &slot = slots_[idx];
+			if (slot.generation != generation_) {
+				slot.generation = generation_;
+				slot.tag = tag;
+				slot.unique_idx = static_cast<uint32_t>(positions_.size());
+				positions_.push_back(position);
+				return;
+			}
+			if (slot.tag == tag) {
+				positions_[slot.unique_idx] = position;
+				return;
+			}
+			idx = (idx + 1) & mask_;
+		}
+	}
+
+	// Position of the last occurrence of each distinct tag, in order of first appearance
+	const std::vector<uint32_t> &Positions() const {
+		return positions_;
+	}
+
+private:
+	struct Slot {
+		uint32_t generation = 0;
+		int tag = 0;
+		uint32_t unique_idx = 0;
+	};
+
+	std::vector<Slot> slots_;
+	std::vector<uint32_t> positions_;
+	uint32_t generation_ = 0;
+	size_t mask_ = 0;
+};
@@ -0,0 +1,40 @@
+#include "fix_tag_layout.hpp"
+
+FixTagLayout::FixTagLayout() {
+	for (auto tag : duckdb::FixHotTags::ALL_TAGS) {
+		AddTag(tag);
+	}
+}
+
+const FixTagLayout &FixTagLayout::Default() {
+	static const FixTagLayout layout;
+	return layout;
+}
+
+uint16_t FixTagLayout::AddTag(int tag) {
+	auto existing = GetSlot(tag);
+	if (existing != NO_SLOT) {
+		return existing;
+	}
+
+	auto slot = static_cast<uint16_t>(slot_tags_.size());
+	slot_tags_.push_back(tag);
+	if (tag >= 0 && tag <= MAX_DENSE_TAG) {
+		if (static_cast<size_t>(tag) >= dense_slots_.size()) {
+			dense_slots_.resize(static_cast<size_t>(tag) + 1, NO_SLOT);
+		}
+		dense_slots_[tag] = slot;
+	} else {
+		sparse_slots_.emplace_back(tag, slot);
+	}
+	return slot;
+}
+
+uint16_t FixTagLayout::GetSparseSlot(int tag) const {
+	for (auto &entry : sparse_slots_) {
+		if (entry.first == tag) {
+			return entry.second;
+		}
+	}
+	return NO_SLOT;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "fix_hot_tags.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Maps tag numbers to direct-indexed value slots of a ParsedFixMessage
+// The first FixHotTags::NUM_HOT_TAGS slots are always the hot tags, in FixHotTags::ALL_TAGS order;
+// tags requested by a query (rtags/tagIds) are promoted to the slots after them
+// The tokenizer resolves every tag with a single array lookup instead of a switch or a hash map
+class FixTagLayout {
+public:
+	static constexpr uint16_t NO_SLOT = 0xFFFF;
+	// Tags up to this number are resolved through the dense array, larger ones through a short list
+	static constexpr int MAX_DENSE_TAG = 65535;
+
+	// Layout with just the hot tags
+	FixTagLayout();
+
+	// Shared layout with just the hot tags
+	static const FixTagLayout &Default();
+
+	// Promote a tag to a slot, returns its slot (the existing one if the tag already has a slot)
+	uint16_t AddTag(int tag);
+
+	// Slot of a tag, NO_SLOT if the tag is not promoted
+	inline uint16_t GetSlot(int tag) const {
+		if (tag >= 0 && static_cast<size_t>(tag) < dense_slots_.size()) {
+			return dense_slots_[tag];
+		}
+		return GetSparseSlot(tag);
+	}
+
+	// True if the tag is one of the built-in hot tags
+	inline bool IsHotTag(int tag) const {
+		return GetSlot(tag) < duckdb::FixHotTags::NUM_HOT_TAGS;
+	}
+
+	size_t SlotCount() const {
+		return slot_tags_.size();
+	}
+
+	// Tag stored in a slot
+	int GetTag(uint16_t slot) const {
+		return slot_tags_[slot];
+	}
+
+private:
+	uint16_t GetSparseSlot(int tag) const;
+
+	// tag -> slot, sized to the largest promoted tag up to MAX_DENSE_TAG
+	std::vector<uint16_t> dense_slots_;
+	// Promoted tags outside the dense range
+	std::vector<std::pair<int, uint16_t>> sparse_slots_;
+	// slot -> tag
+	std::vector<int> slot_tags_;
+};
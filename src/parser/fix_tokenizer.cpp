@@ -1,126 +1,79 @@
 #include "fix_tokenizer.hpp"
 #include "fix_hot_tags.hpp"
+#include "fix_simd_scan.hpp"
 #include <cstring>
 #include <cstdlib>
 
-bool FixTokenizer::IsNumeric(const char *str, size_t len) {
-	if (len == 0) {
+bool FixTokenizer::ExtractTagNumber(const char *tag_str, size_t tag_len, int &tag_out) {
+	// Validate and convert in a single pass; more than 9 digits cannot be a valid int tag
+	if (tag_len == 0 || tag_len > 9) {
 		return false;
 	}
-	for (size_t i = 0; i < len; i++) {
-		if (str[i] < '0' || str[i] > '9') {
+	int tag = 0;
+	for (size_t i = 0; i < tag_len; i++) {
+		unsigned digit = static_cast<unsigned char>(tag_str[i]) - '0';
+		if (digit > 9) {
 			return false;
 		}
+		tag = tag * 10 + static_cast<int>(digit);
 	}
+	tag_out = tag;
 	return true;
 }
 
-bool FixTokenizer::ExtractTagNumber(const char *tag_str, size_t tag_len, int &tag_out) {
-	if (!IsNumeric(tag_str, tag_len)) {
-		return false;
+void FixParseOptions::SetGroupLayout(std::shared_ptr<const duckdb::FixGroupLayout> layout,
+                                     const FixTagLayout &tag_layout) {
+	full_parse_messages.assign(layout->MessageCount(), false);
+	for (uint16_t id = 0; id < layout->MessageCount(); id++) {
+		for (size_t slot = 0; slot < tag_layout.SlotCount(); slot++) {
+			auto required = IsRequired(static_cast<uint16_t>(slot));
+			if (required && layout->IsGroupField(id, tag_layout.GetTag(static_cast<uint16_t>(slot)))) {
+				full_parse_messages[id] = true;
+				break;
+			}
+		}
 	}
+	group_layout = std::move(layout);
+}
 
-	// Convert to int manually
-	tag_out = 0;
-	for (size_t i = 0; i < tag_len; i++) {
-		tag_out = tag_out * 10 + (tag_str[i] - '0');
+bool FixParseOptions::CanStopEarly(const ParsedFixMessage::TagValue &msg_type) const {
+	if (!group_layout) {
+		return true;
 	}
-	return true;
+	// Message types the dictionary has no groups for cannot repeat a tag either
+	auto id = group_layout->GetMessageId(msg_type.data, msg_type.len);
+	return id == duckdb::FixGroupLayout::NO_MESSAGE || !full_parse_messages[id];
 }
 
 bool FixTokenizer::ParseTag(const char *tag_str, size_t tag_len, const char *value, size_t value_len,
-                            ParsedFixMessage &msg) {
+                            ParsedFixMessage &msg, const FixParseOptions &options, size_t &required_seen) {
 	int tag;
 	if (!ExtractTagNumber(tag_str, tag_len, tag)) {
 		return false;
 	}
 
 	// Add ALL tags to ordered list (for group parsing)
-	msg.all_tags_ordered.push_back({tag, {value, value_len}});
-
-	// Store in appropriate field based on tag number
-	// Using centralized FixHotTags constants for maintainability
-	switch (tag) {
-	case duckdb::FixHotTags::MSG_TYPE:
-		msg.msg_type = value;
-		msg.msg_type_len = value_len;
-		break;
-	case duckdb::FixHotTags::SENDER_COMP_ID:
-		msg.sender_comp_id = value;
-		msg.sender_comp_id_len = value_len;
-		break;
-	case duckdb::FixHotTags::TARGET_COMP_ID:
-		msg.target_comp_id = value;
-		msg.target_comp_id_len = value_len;
-		break;
-	case duckdb::FixHotTags::MSG_SEQ_NUM:
-		msg.msg_seq_num = value;
-		msg.msg_seq_num_len = value_len;
-		break;
-	case duckdb::FixHotTags::SENDING_TIME:
-		msg.sending_time = value;
-		msg.sending_time_len = value_len;
-		break;
-	case duckdb::FixHotTags::CL_ORD_ID:
-		msg.cl_ord_id = value;
-		msg.cl_ord_id_len = value_len;
-		break;
-	case duckdb::FixHotTags::ORDER_ID:
-		msg.order_id = value;
-		msg.order_id_len = value_len;
-		break;
-	case duckdb::FixHotTags::EXEC_ID:
-		msg.exec_id = value;
-		msg.exec_id_len = value_len;
-		break;
-	case duckdb::FixHotTags::SYMBOL:
-		msg.symbol = value;
-		msg.symbol_len = value_len;
-		break;
-	case duckdb::FixHotTags::SIDE:
-		msg.side = value;
-		msg.side_len = value_len;
-		break;
-	case duckdb::FixHotTags::EXEC_TYPE:
-		msg.exec_type = value;
-		msg.exec_type_len = value_len;
-		break;
-	case duckdb::FixHotTags::ORD_STATUS:
-		msg.ord_status = value;
-		msg.ord_status_len = value_len;
-		break;
-	case duckdb::FixHotTags::PRICE:
-		msg.price = value;
-		msg.price_len = value_len;
-		break;
-	case duckdb::FixHotTags::ORDER_QTY:
-		msg.order_qty = value;
-		msg.order_qty_len = value_len;
-		break;
-	case duckdb::FixHotTags::CUM_QTY:
-		msg.cum_qty = value;
-		msg.cum_qty_len = value_len;
-		break;
-	case duckdb::FixHotTags::LEAVES_QTY:
-		msg.leaves_qty = value;
-		msg.leaves_qty_len = value_len;
-		break;
-	case duckdb::FixHotTags::LAST_PX:
-		msg.last_px = value;
-		msg.last_px_len = value_len;
-		break;
-	case duckdb::FixHotTags::LAST_QTY:
-		msg.last_qty = value;
-		msg.last_qty_len = value_len;
-		break;
-	case duckdb::FixHotTags::TEXT:
-		msg.text = value;
-		msg.text_len = value_len;
-		break;
-	default:
-		// Store in other_tags map
-		msg.other_tags[tag] = {value, value_len};
-		break;
+	if (options.keep_tag_list) {
+		msg.all_tags_ordered.push_back({tag, {value, value_len}});
+	}
+
+	// Promoted tags (hot tags plus query-requested tags) go to their slot with a single table lookup
+	// The last occurrence wins; required_seen counts the required slots that currently hold a non-empty value
+	auto slot = msg.layout->GetSlot(tag);
+	if (slot != FixTagLayout::NO_SLOT) {
+		auto &entry = msg.slots[slot];
+		if ((entry.len == 0) != (value_len == 0) && options.IsRequired(slot)) {
+			if (value_len > 0) {
+				required_seen++;
+			} else {
+				required_seen--;
+			}
+		}
+		entry = {value, value_len};
+	}
+	if (slot >= duckdb::FixHotTags::NUM_HOT_TAGS) {
+		// Other tags are only kept in the ordered list
+		msg.other_tag_count++;
 	}
 
 	return true;
@@ -128,6 +81,14 @@ bool FixTokenizer::ParseTag(const char *tag_str, size_t tag_len, const char *val
 
 bool FixTokenizer::Parse(const char *input, size_t input_len, ParsedFixMessage &msg, char delimiter,
                          bool extract_prefix) {
+	FixParseOptions options;
+	options.delimiter = delimiter;
+	options.extract_prefix = extract_prefix;
+	return Parse(input, input_len, msg, options);
+}
+
+bool FixTokenizer::Parse(const char *input, size_t input_len, ParsedFixMessage &msg, const FixParseOptions &options) {
+	const char delimiter = options.delimiter;
 	msg.clear();
 	msg.raw_message = input;
 	msg.raw_message_len = input_len;
@@ -155,53 +116,82 @@ bool FixTokenizer::Parse(const char *input, size_t input_len, ParsedFixMessage &
 	}
 
 	// Extract prefix if requested and present
-	if (extract_prefix && fix_start > 0) {
+	if (options.extract_prefix && fix_start > 0) {
 		msg.prefix = input;
 		msg.prefix_len = fix_start;
 	}
 
 	// Parse FIX message starting from "8="
-	size_t pos = fix_start;
+	// Single pass over bitmasks of delimiter and '=' positions, 64 bytes at a time
+	// In a tag the first '=' ends it; in a value '=' is ordinary data and only the delimiter ends it
+	auto classify = FixSimdScan::GetClassifier();
 	size_t tag_count = 0;
-
-	while (pos < input_len) {
-		// Find next delimiter
-		size_t next_delim = pos;
-		while (next_delim < input_len && input[next_delim] != delimiter) {
-			next_delim++;
+	size_t required_seen = 0;
+	size_t pair_start = fix_start;
+	size_t eq_pos = 0;
+	bool in_tag = true;
+	bool stopped_early = false;
+	// Cleared once the message type turns out to need a full parse
+	bool may_stop_early = options.StopsEarly();
+
+	for (size_t block_start = fix_start; block_start < input_len && !stopped_early;
+	     block_start += FIX_SCAN_BLOCK_SIZE) {
+		size_t block_len = input_len - block_start;
+		uint64_t mask;
+		if (block_len >= FIX_SCAN_BLOCK_SIZE) {
+			mask = classify(input + block_start, delimiter);
+		} else {
+			mask = FixSimdScan::ClassifyTail(classify, input + block_start, block_len, delimiter);
 		}
 
-		// Extract tag=value pair
-		size_t pair_len = next_delim - pos;
-
-		if (pair_len > 0) {
-			const char *pair_start = input + pos;
-
-			// Find '=' separator
-			size_t eq_pos = 0;
-			while (eq_pos < pair_len && pair_start[eq_pos] != '=') {
-				eq_pos++;
+		while (mask) {
+			size_t pos = block_start + FixSimdScan::CountTrailingZeros(mask);
+			mask &= mask - 1;
+
+			if (input[pos] == delimiter) {
+				if (in_tag) {
+					// Empty pairs (consecutive delimiters) are skipped
+					if (pos > pair_start) {
+						msg.parse_error = "Invalid tag format (missing '=')";
+						return false;
+					}
+				} else {
+					if (!ParseTag(input + pair_start, eq_pos - pair_start, input + eq_pos + 1, pos - eq_pos - 1,
+					              msg, options, required_seen)) {
+						msg.parse_error = "Failed to parse tag";
+						return false;
+					}
+					tag_count++;
+					in_tag = true;
+					if (may_stop_early && required_seen == options.required_count) {
+						if (options.CanStopEarly(msg.Hot<duckdb::FixHotTags::MSG_TYPE>())) {
+							// Every projected tag has been found - skip the rest of the message
+							stopped_early = true;
+							break;
+						}
+						may_stop_early = false;
+					}
+				}
+				pair_start = pos + 1;
+			} else if (in_tag) {
+				eq_pos = pos;
+				in_tag = false;
 			}
-
-			if (eq_pos >= pair_len) {
-				msg.parse_error = "Invalid tag format (missing '=')";
-				return false;
-			}
-
-			const char *tag_str = pair_start;
-			size_t tag_len = eq_pos;
-			const char *value = pair_start + eq_pos + 1;
-			size_t value_len = pair_len - eq_pos - 1;
-
-			if (!ParseTag(tag_str, tag_len, value, value_len, msg)) {
-				msg.parse_error = "Failed to parse tag";
-				return false;
-			}
-
-			tag_count++;
 		}
+	}
 
-		pos = next_delim + 1;
+	// Last pair without a trailing delimiter
+	if (!stopped_early && pair_start < input_len) {
+		if (in_tag) {
+			msg.parse_error = "Invalid tag format (missing '=')";
+			return false;
+		}
+		if (!ParseTag(input + pair_start, eq_pos - pair_start, input + eq_pos + 1, input_len - eq_pos - 1, msg, options,
+		              required_seen)) {
+			msg.parse_error = "Failed to parse tag";
+			return false;
+		}
+		tag_count++;
 	}
 
 	if (tag_count == 0) {
@@ -210,7 +200,8 @@ bool FixTokenizer::Parse(const char *input, size_t input_len, ParsedFixMessage &
 	}
 
 	// Validate that we at least have MsgType (tag 35)
-	if (msg.msg_type == nullptr || msg.msg_type_len == 0) {
+	auto &msg_type = msg.Hot<duckdb::FixHotTags::MSG_TYPE>();
+	if (msg_type.data == nullptr || msg_type.len == 0) {
 		msg.parse_error = "Missing required tag 35 (MsgType)";
 		return false;
 	}
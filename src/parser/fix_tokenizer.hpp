@@ -1,27 +1,79 @@
 #pragma once
 
 #include "fix_message.hpp"
+#include "fix_group_layout.hpp"
 #include <cstdint>
+#include <memory>
+#include <vector>
+
+// Per-query tokenizer settings
+struct FixParseOptions {
+	char delimiter = '\x01';
+	// Extract everything before "8=" into msg.prefix
+	bool extract_prefix = false;
+	// Build msg.all_tags_ordered (needed for the tags and groups columns and FindTag on other tags)
+	bool keep_tag_list = true;
+
+	// Stop tokenizing once every required slot has a non-empty value; no required slots means parse everything
+	// MsgType is always required so the message can still be validated
+	// A repeated tag keeps its last occurrence, so stopping early is only exact for tags that cannot occur again
+	// later in the message: see SetGroupLayout for tags of repeating groups
+	void RequireSlot(uint16_t slot) {
+		if (slot / 64 >= required_slots.size()) {
+			required_slots.resize(slot / 64 + 1, 0);
+		}
+		if (!IsRequired(slot)) {
+			required_slots[slot / 64] |= static_cast<uint64_t>(1) << (slot % 64);
+			required_count++;
+		}
+	}
+
+	bool IsRequired(uint16_t slot) const {
+		return slot / 64 < required_slots.size() && (required_slots[slot / 64] >> (slot % 64)) & 1;
+	}
+
+	bool StopsEarly() const {
+		return required_count > 0;
+	}
+
+	// Parse messages to the end if their type has a repeating group containing the tag of a required slot, so that
+	// these tags keep their last occurrence like in a full parse; call after the last RequireSlot
+	void SetGroupLayout(std::shared_ptr<const duckdb::FixGroupLayout> layout, const FixTagLayout &tag_layout);
+
+	// False if a message of this type has to be parsed to the end
+	bool CanStopEarly(const ParsedFixMessage::TagValue &msg_type) const;
+
+	// Bitmap over slots
+	std::vector<uint64_t> required_slots;
+	size_t required_count = 0;
+	// Set by SetGroupLayout, by message id of group_layout
+	std::shared_ptr<const duckdb::FixGroupLayout> group_layout;
+	std::vector<bool> full_parse_messages;
+};
 
 // FIX message tokenizer
 // Fast, zero-copy parsing of SOH-delimited FIX messages
+// Field boundaries are found with the vectorized classifiers in fix_simd_scan.hpp
 class FixTokenizer {
 public:
 	// Parse a FIX message from a buffer
+	// Tags are assigned to value slots according to msg.layout
 	// Supports both SOH ('\x01') and pipe ('|') delimiters
 	// extract_prefix: if true, extracts everything before "8=" into msg.prefix
 	// Returns true on success, false on parse error (error stored in msg)
 	static bool Parse(const char *input, size_t input_len, ParsedFixMessage &msg, char delimiter = '\x01',
 	                  bool extract_prefix = false);
 
+	// Parse with per-query options (projection-aware early exit, optional tag list)
+	// When parsing stops early, errors in the unparsed remainder of the message are not detected
+	static bool Parse(const char *input, size_t input_len, ParsedFixMessage &msg, const FixParseOptions &options);
+
 private:
 	// Parse a single tag=value pair
+	// required_seen counts the required slots that hold a non-empty value
 	static bool ParseTag(const char *tag_str, size_t tag_len, const char *value, size_t value_len,
-	                     ParsedFixMessage &msg);
+	                     ParsedFixMessage &msg, const FixParseOptions &options, size_t &required_seen);
 
-	// Extract tag number from string
+	// Extract tag number from string, returns false if it is not a positive decimal number
 	static bool ExtractTagNumber(const char *tag_str, size_t tag_len, int &tag_out);
-
-	// Helper: check if string is numeric
-	static bool IsNumeric(const char *str, size_t len);
 };
@@ -6,165 +6,312 @@
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/common/string_util.hpp"
-#include <stdexcept>
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
 #include <cstring>
 
 namespace duckdb {
 
 void SetStringField(Vector &column, idx_t row, const char *ptr, size_t len) {
 	if (ptr != nullptr && len > 0) {
-		column.SetValue(row, Value(std::string(ptr, len)));
+		// Short strings are inlined into the string_t, longer ones are copied into the vector's heap
+		FlatVector::GetData<string_t>(column)[row] = StringVector::AddString(column, ptr, len);
 	} else {
-		column.SetValue(row, Value());
+		FlatVector::SetNull(column, row, true);
 	}
 }
 
-bool ConvertToInt64(const char *ptr, size_t len, int64_t &result, std::vector<std::string> &errors,
-                    const char *field_name) {
-	if (ptr == nullptr || len == 0) {
-		return false;
-	}
+// Powers of ten that are exactly representable as doubles
+static const double EXACT_POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                             1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+static constexpr int MAX_EXACT_POWER_OF_TEN = 22;
+static constexpr uint64_t MAX_EXACT_MANTISSA = 1ULL << 53;
 
-	try {
-		std::string str_val(ptr, len);
-		size_t pos;
-		result = std::stoll(str_val, &pos);
+static inline bool IsDigit(char c) {
+	return static_cast<unsigned>(static_cast<unsigned char>(c) - '0') <= 9;
+}
 
-		if (pos != str_val.length()) {
-			throw std::invalid_argument("extra characters");
+// Parse exactly count digits at ptr, returns -1 if any of them is not a digit
+static inline int ParseFixedDigits(const char *ptr, int count) {
+	int result = 0;
+	for (int i = 0; i < count; i++) {
+		unsigned digit = static_cast<unsigned char>(ptr[i]) - '0';
+		if (digit > 9) {
+			return -1;
 		}
-
-		return true;
-	} catch (const std::exception &e) {
-		errors.push_back(std::string("Invalid ") + field_name + ": '" + std::string(ptr, len) + "'");
-		return false;
+		result = result * 10 + static_cast<int>(digit);
 	}
+	return result;
 }
 
-bool ConvertToDouble(const char *ptr, size_t len, double &result, std::vector<std::string> &errors,
-                     const char *field_name) {
-	if (ptr == nullptr || len == 0) {
+bool ParseFixInt64(const char *ptr, size_t len, int64_t &result, const char *&reason) {
+	const char *end = ptr + len;
+	bool negative = false;
+	if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+		negative = *ptr == '-';
+		ptr++;
+	}
+	if (ptr == end) {
+		reason = "no digits";
 		return false;
 	}
 
-	try {
-		std::string str_val(ptr, len);
-		size_t pos;
-		result = std::stod(str_val, &pos);
-
-		if (pos != str_val.length()) {
-			throw std::invalid_argument("extra characters");
+	// Accumulate as unsigned so that INT64_MIN parses without overflow
+	const uint64_t limit = negative ? static_cast<uint64_t>(NumericLimits<int64_t>::Maximum()) + 1
+	                                : static_cast<uint64_t>(NumericLimits<int64_t>::Maximum());
+	uint64_t value = 0;
+	for (; ptr < end; ptr++) {
+		unsigned digit = static_cast<unsigned char>(*ptr) - '0';
+		if (digit > 9) {
+			reason = "not an integer";
+			return false;
+		}
+		if (value > (limit - digit) / 10) {
+			reason = "out of range";
+			return false;
 		}
+		value = value * 10 + digit;
+	}
+	result = negative ? static_cast<int64_t>(0 - value) : static_cast<int64_t>(value);
+	return true;
+}
 
+bool ParseFixDouble(const char *ptr, size_t len, double &result, const char *&reason) {
+	// Fast path for FIX PRICE/QTY fixed-point decimals: [-]digits[.digits]
+	// A mantissa of up to 53 bits divided by an exact power of ten is correctly rounded
+	const char *p = ptr;
+	const char *end = ptr + len;
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		p++;
+	}
+	uint64_t mantissa = 0;
+	int digits = 0;
+	int fraction_digits = 0;
+	for (; p < end && IsDigit(*p); p++, digits++) {
+		mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+		if (digits >= 19) {
+			break;
+		}
+	}
+	if (p < end && *p == '.' && digits < 19) {
+		p++;
+		for (; p < end && IsDigit(*p); p++, digits++, fraction_digits++) {
+			mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+			if (digits >= 19) {
+				break;
+			}
+		}
+	}
+	if (p == end && digits > 0 && digits <= 19 && mantissa <= MAX_EXACT_MANTISSA &&
+	    fraction_digits <= MAX_EXACT_POWER_OF_TEN) {
+		double value = static_cast<double>(mantissa) / EXACT_POWERS_OF_TEN[fraction_digits];
+		result = negative ? -value : value;
 		return true;
-	} catch (const std::exception &e) {
-		errors.push_back(std::string("Invalid ") + field_name + ": '" + std::string(ptr, len) + "'");
+	}
+
+	// Slow path: exponents, very long mantissas, inf/nan - DuckDB's cast neither allocates nor throws
+	if (!TryCast::Operation<string_t, double>(string_t(ptr, static_cast<uint32_t>(len)), result, false)) {
+		reason = "not a number";
 		return false;
 	}
+	return true;
 }
 
-bool ConvertToTimestamp(const char *ptr, size_t len, timestamp_t &result, std::vector<std::string> &errors,
-                        const char *field_name) {
-	if (ptr == nullptr || len < 17) { // Minimum: YYYYMMDD-HH:MM:SS
+bool ParseFixTimestamp(const char *ptr, size_t len, timestamp_t &result, const char *&reason) {
+	// Fixed layout: YYYYMMDD-HH:MM:SS[.ffffff]
+	//               0       8 9  12 15 17
+	int year = ParseFixedDigits(ptr, 4);
+	int month = ParseFixedDigits(ptr + 4, 2);
+	int day = ParseFixedDigits(ptr + 6, 2);
+	if (year < 0 || month < 0 || day < 0) {
+		reason = "Invalid digit";
 		return false;
 	}
 
-	try {
-		// Helper to parse 2 digits with bounds checking
-		auto parse_2digits = [&](size_t offset) -> int {
-			if (offset + 1 >= len) {
-				throw std::runtime_error("Buffer overrun");
-			}
-			const char *p = ptr + offset;
-			if (p[0] < '0' || p[0] > '9' || p[1] < '0' || p[1] > '9') {
-				throw std::runtime_error("Invalid digit");
-			}
-			return (p[0] - '0') * 10 + (p[1] - '0');
-		};
+	// Validate date components
+	if (year < 1900 || year > 2100) {
+		reason = "Year out of range";
+		return false;
+	}
+	if (month < 1 || month > 12) {
+		reason = "Month out of range";
+		return false;
+	}
+	if (!Date::IsValid(year, month, day)) {
+		reason = "Day out of range";
+		return false;
+	}
 
-		// Helper to parse 4 digits with bounds checking
-		auto parse_4digits = [&](size_t offset) -> int {
-			if (offset + 3 >= len) {
-				throw std::runtime_error("Buffer overrun");
-			}
-			const char *p = ptr + offset;
-			for (int i = 0; i < 4; i++) {
-				if (p[i] < '0' || p[i] > '9') {
-					throw std::runtime_error("Invalid digit");
-				}
-			}
-			return (p[0] - '0') * 1000 + (p[1] - '0') * 100 + (p[2] - '0') * 10 + (p[3] - '0');
-		};
+	// Check for separator at position 8
+	if (ptr[8] != '-') {
+		reason = "Missing date-time separator";
+		return false;
+	}
 
-		// Parse YYYYMMDD-HH:MM:SS[.sss]
-		int year = parse_4digits(0);  // YYYY
-		int month = parse_2digits(4); // MM
-		int day = parse_2digits(6);   // DD
+	int hour = ParseFixedDigits(ptr + 9, 2);
+	int minute = ParseFixedDigits(ptr + 12, 2);
+	int second = ParseFixedDigits(ptr + 15, 2);
+	if (hour < 0 || minute < 0 || second < 0) {
+		reason = "Invalid digit";
+		return false;
+	}
 
-		// Validate date components
-		if (year < 1900 || year > 2100) {
-			throw std::runtime_error("Year out of range");
-		}
-		if (month < 1 || month > 12) {
-			throw std::runtime_error("Month out of range");
+	// Validate time components
+	if (hour > 23) {
+		reason = "Hour out of range";
+		return false;
+	}
+	if (minute > 59) {
+		reason = "Minute out of range";
+		return false;
+	}
+	if (second > 59) {
+		reason = "Second out of range";
+		return false;
+	}
+
+	// Check for time separators
+	if (ptr[11] != ':' || ptr[14] != ':') {
+		reason = "Missing time separators";
+		return false;
+	}
+
+	// Fractional seconds: milliseconds or microseconds, finer digits (FIX allows picoseconds) are truncated
+	int32_t micros = 0;
+	if (len > 17 && ptr[17] == '.') {
+		int digits = 0;
+		for (size_t i = 18; i < len && digits < 6 && IsDigit(ptr[i]); i++, digits++) {
+			micros = micros * 10 + (ptr[i] - '0');
 		}
-		if (day < 1 || day > 31) {
-			throw std::runtime_error("Day out of range");
+		for (; digits < 6; digits++) {
+			micros *= 10;
 		}
+	}
 
-		// Check for separator at position 8
-		if (ptr[8] != '-') {
-			throw std::runtime_error("Missing date-time separator");
-		}
+	// Create timestamp (assuming UTC)
+	date_t date = Date::FromDate(year, month, day);
+	dtime_t time = Time::FromTime(hour, minute, second, micros);
+	result = Timestamp::FromDatetime(date, time);
+	return true;
+}
 
-		int hour = parse_2digits(9);    // HH
-		int minute = parse_2digits(12); // MM
-		int second = parse_2digits(15); // SS
+bool ParseFixBoolean(const char *ptr, size_t len, bool &result, const char *&reason) {
+	if (len == 1 && (ptr[0] == 'Y' || ptr[0] == 'N')) {
+		result = ptr[0] == 'Y';
+		return true;
+	}
+	reason = "Expected Y or N";
+	return false;
+}
 
-		// Validate time components
-		if (hour > 23) {
-			throw std::runtime_error("Hour out of range");
+// Call append(data, len) for each piece of the message of errors
+template <class APPEND>
+static void FormatConversionErrors(const vector<FixConversionError> &errors, APPEND &&append) {
+	for (idx_t i = 0; i < errors.size(); i++) {
+		auto &error = errors[i];
+		if (i > 0) {
+			append("; ", 2);
 		}
-		if (minute > 59) {
-			throw std::runtime_error("Minute out of range");
+		if (!error.field_name) {
+			append(error.value, error.len);
+			continue;
 		}
-		if (second > 59) {
-			throw std::runtime_error("Second out of range");
+		append("Invalid ", 8);
+		append(error.field_name, strlen(error.field_name));
+		append(": '", 3);
+		append(error.value, error.len);
+		append("'", 1);
+		if (error.reason) {
+			append(" (", 2);
+			append(error.reason, strlen(error.reason));
+			append(")", 1);
 		}
+	}
+}
 
-		// Check for time separators
-		if (ptr[11] != ':' || ptr[14] != ':') {
-			throw std::runtime_error("Missing time separators");
-		}
+idx_t FixConversionErrors::FormattedLength() const {
+	idx_t length = 0;
+	FormatConversionErrors(errors_, [&](const char *, size_t len) { length += len; });
+	return length;
+}
 
-		// Parse milliseconds if present and convert to microseconds
-		int micros = 0;
-		if (len > 17 && ptr[17] == '.') {
-			// Parse up to 3 digits of milliseconds
-			int ms = 0;
-			int digits = 0;
-			for (size_t i = 18; i < len && i < 21 && ptr[i] >= '0' && ptr[i] <= '9'; i++) {
-				ms = ms * 10 + (ptr[i] - '0');
-				digits++;
-			}
-			// Convert to microseconds (pad with zeros if needed)
-			while (digits < 3) {
-				ms *= 10;
-				digits++;
-			}
-			micros = ms * 1000; // milliseconds to microseconds
-		}
+void FixConversionErrors::Format(char *out) const {
+	FormatConversionErrors(errors_, [&](const char *data, size_t len) {
+		memcpy(out, data, len);
+		out += len;
+	});
+}
 
-		// Create timestamp (assuming UTC)
-		date_t date = Date::FromDate(year, month, day);
-		dtime_t time = Time::FromTime(hour, minute, second, micros);
-		result = Timestamp::FromDatetime(date, time);
+string FixConversionErrors::ToString() const {
+	string result(FormattedLength(), '\0');
+	Format(&result[0]);
+	return result;
+}
 
-		return true;
-	} catch (const std::exception &e) {
-		errors.push_back(std::string("Invalid ") + field_name + ": '" + std::string(ptr, len) + "' (" + e.what() + ")");
+// Record a conversion error if the caller wants errors; the message is only formatted if it is read
+static inline void AddConversionError(FixConversionErrors *errors, const char *field_name, const char *ptr,
+                                      size_t len, const char *reason) {
+	if (errors) {
+		errors->Add(field_name, ptr, len, reason);
+	}
+}
+
+bool ConvertToInt64(const char *ptr, size_t len, int64_t &result, FixConversionErrors *errors,
+                    const char *field_name) {
+	if (ptr == nullptr || len == 0) {
+		return false;
+	}
+
+	const char *reason;
+	if (!ParseFixInt64(ptr, len, result, reason)) {
+		AddConversionError(errors, field_name, ptr, len, nullptr);
+		return false;
+	}
+	return true;
+}
+
+bool ConvertToDouble(const char *ptr, size_t len, double &result, FixConversionErrors *errors,
+                     const char *field_name) {
+	if (ptr == nullptr || len == 0) {
+		return false;
+	}
+
+	const char *reason;
+	if (!ParseFixDouble(ptr, len, result, reason)) {
+		AddConversionError(errors, field_name, ptr, len, nullptr);
+		return false;
+	}
+	return true;
+}
+
+bool ConvertToTimestamp(const char *ptr, size_t len, timestamp_t &result, FixConversionErrors *errors,
+                        const char *field_name) {
+	if (ptr == nullptr || len < 17) { // Minimum: YYYYMMDD-HH:MM:SS
+		return false;
+	}
+
+	const char *reason;
+	if (!ParseFixTimestamp(ptr, len, result, reason)) {
+		AddConversionError(errors, field_name, ptr, len, reason);
+		return false;
+	}
+	return true;
+}
+
+bool ConvertToBoolean(const char *ptr, size_t len, bool &result, FixConversionErrors *errors,
+                      const char *field_name) {
+	if (ptr == nullptr || len == 0) {
+		return false;
+	}
+
+	const char *reason;
+	if (!ParseFixBoolean(ptr, len, result, reason)) {
+		AddConversionError(errors, field_name, ptr, len, nullptr);
 		return false;
 	}
+	return true;
 }
 
 } // namespace duckdb
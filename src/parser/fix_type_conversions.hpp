@@ -2,6 +2,8 @@
 
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/common/vector.hpp"
+#include "duckdb/common/types/vector.hpp"
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -11,20 +13,105 @@ namespace duckdb {
 // All conversions are lenient and collect errors rather than throwing exceptions
 
 // Set a string field from pointer/length pair
+// Writes straight into the flat vector; empty or missing values become NULL
 void SetStringField(Vector &column, idx_t row, const char *ptr, size_t len);
 
+// Set a fixed-width field directly in a flat vector
+template <class T>
+inline void SetFlatField(Vector &column, idx_t row, T value) {
+	FlatVector::GetData<T>(column)[row] = value;
+}
+
+// Mark a field as NULL through the validity mask
+inline void SetNullField(Vector &column, idx_t row) {
+	FlatVector::SetNull(column, row, true);
+}
+
+// Allocation-free parsers for FIX value formats
+// They never throw; on failure they return false and point reason at a static description
+
+// FIX INT / SEQNUM: [+-]digits
+bool ParseFixInt64(const char *ptr, size_t len, int64_t &result, const char *&reason);
+
+// FIX PRICE / QTY / FLOAT: fixed-point decimal [+-]digits[.digits], with a fallback for exponents
+// Values with up to 15-16 significant digits are converted exactly, without going through strtod
+bool ParseFixDouble(const char *ptr, size_t len, double &result, const char *&reason);
+
+// FIX UTCTimestamp: YYYYMMDD-HH:MM:SS[.sss[sss]], ptr must have at least 17 bytes
+bool ParseFixTimestamp(const char *ptr, size_t len, timestamp_t &result, const char *&reason);
+
+// FIX Boolean: Y or N
+bool ParseFixBoolean(const char *ptr, size_t len, bool &result, const char *&reason);
+
+// A value that could not be converted, recorded without building its message
+// value points into the message being converted, so a record lives only as long as the row being written
+struct FixConversionError {
+	// nullptr for a plain message (value), e.g. the tokenizer's parse error
+	const char *field_name;
+	const char *value;
+	size_t len;
+	// Static description of the problem, nullptr if none
+	const char *reason;
+};
+
+// The errors of one row, formatted into a message only when the parse_error column is read
+// Cleared per row and reused across rows, so collecting errors does not allocate once it has grown
+class FixConversionErrors {
+public:
+	void Clear() {
+		errors_.clear();
+	}
+
+	bool Empty() const {
+		return errors_.empty();
+	}
+
+	idx_t Count() const {
+		return errors_.size();
+	}
+
+	// A static message, such as ParsedFixMessage::parse_error
+	void AddMessage(const char *message) {
+		errors_.push_back({nullptr, message, strlen(message), nullptr});
+	}
+
+	void Add(const char *field_name, const char *value, size_t len, const char *reason) {
+		errors_.push_back({field_name, value, len, reason});
+	}
+
+	// Length of the message Format writes
+	idx_t FormattedLength() const;
+
+	// Write the message to out (FormattedLength() bytes): "Invalid <field>: '<value>' (<reason>)" per error,
+	// separated by "; "
+	void Format(char *out) const;
+
+	string ToString() const;
+
+private:
+	vector<FixConversionError> errors_;
+};
+
+// Conversion helpers used by the table function
+// Missing values (empty) return false without an error; invalid values add a record to errors,
+// unless errors is nullptr (errors neither read nor counted)
+
 // Convert string to int64 with error collection
-bool ConvertToInt64(const char *ptr, size_t len, int64_t &result, std::vector<std::string> &errors,
+bool ConvertToInt64(const char *ptr, size_t len, int64_t &result, FixConversionErrors *errors,
                     const char *field_name);
 
 // Convert string to double with error collection
-bool ConvertToDouble(const char *ptr, size_t len, double &result, std::vector<std::string> &errors,
+bool ConvertToDouble(const char *ptr, size_t len, double &result, FixConversionErrors *errors,
                      const char *field_name);
 
 // Convert FIX timestamp string to DuckDB timestamp with error collection
-// Format: YYYYMMDD-HH:MM:SS[.sss]
+// Format: YYYYMMDD-HH:MM:SS[.sss] or with microseconds YYYYMMDD-HH:MM:SS.ssssss
 // Example: 20231215-10:30:00 or 20231215-10:30:00.123
-bool ConvertToTimestamp(const char *ptr, size_t len, timestamp_t &result, std::vector<std::string> &errors,
+bool ConvertToTimestamp(const char *ptr, size_t len, timestamp_t &result, FixConversionErrors *errors,
                         const char *field_name);
 
+// Convert FIX Boolean (Y/N) to bool with error collection
+bool ConvertToBoolean(const char *ptr, size_t len, bool &result, FixConversionErrors *errors,
+                      const char *field_name);
+
 } // namespace duckdb
@@ -4,17 +4,41 @@
 #include "duckdb.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/config.hpp"
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
 #include "table_function/read_fix_function.hpp"
 #include "table_function/dictionary_functions.hpp"
+#include "table_function/fix_index_function.hpp"
+#include "table_function/fix_order_states_function.hpp"
+#include "table_function/fix_seq_gaps_function.hpp"
+#include "table_function/fix_convert_function.hpp"
+#include "table_function/fix_scan_stats.hpp"
+#include "scalar_function/fix_scalar_functions.hpp"
+#include "dictionary/fix_dictionary_cache.hpp"
 
 namespace duckdb {
 
 static void LoadInternal(ExtensionLoader &loader) {
+	// Parse the embedded FIX 4.4 dictionary once, queries without a dictionary parameter share it
+	FixDictionaryCache::LoadEmbedded(loader.GetDatabaseInstance());
+
+	// read_fix scan counters for fix_scan_stats() and EXPLAIN ANALYZE, off by default
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(FIX_PROFILING_SETTING, "Count and time read_fix scans, see fix_scan_stats()",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+
 	// Register the read_fix table function
 	auto read_fix_function = ReadFixFunction::GetFunction();
 	loader.RegisterFunction(read_fix_function);
 
+	// Register read_fix_follow for tailing live logs
+	auto read_fix_follow_function = ReadFixFunction::GetFollowFunction();
+	loader.RegisterFunction(read_fix_follow_function);
+
+	// Register the read_fix_follow checkpoint lookup
+	auto fix_follow_checkpoint_function = ReadFixFunction::GetFollowCheckpointFunction();
+	loader.RegisterFunction(fix_follow_checkpoint_function);
+
 	// Register dictionary exploration functions
 	auto fix_fields_function = FixFieldsFunction::GetFunction();
 	loader.RegisterFunction(fix_fields_function);
@@ -24,6 +48,31 @@ static void LoadInternal(ExtensionLoader &loader) {
 
 	auto fix_groups_function = FixGroupsFunction::GetFunction();
 	loader.RegisterFunction(fix_groups_function);
+
+	// Register the sparse index builder
+	auto fix_build_index_function = FixBuildIndexFunction::GetFunction();
+	loader.RegisterFunction(fix_build_index_function);
+
+	// Register the order state folding function
+	auto fix_order_states_function = FixOrderStatesFunction::GetFunction();
+	loader.RegisterFunction(fix_order_states_function);
+
+	// Register the session sequence check
+	auto fix_seq_gaps_function = FixSeqGapsFunction::GetFunction();
+	loader.RegisterFunction(fix_seq_gaps_function);
+
+	// Register the Parquet conversion
+	auto fix_convert_function = FixConvertFunction::GetFunction();
+	loader.RegisterFunction(fix_convert_function);
+
+	// Register the scan profiling results
+	auto fix_scan_stats_function = FixScanStatsFunction::GetFunction();
+	loader.RegisterFunction(fix_scan_stats_function);
+
+	// Register the scalar functions for messages stored in tables
+	loader.RegisterFunction(FixGetTagFunction::GetFunctions());
+	loader.RegisterFunction(FixGetTagsFunction::GetFunctions());
+	loader.RegisterFunction(FixParseFunction::GetFunctions());
 }
 
 void QuackfixExtension::Load(ExtensionLoader &loader) {
@@ -0,0 +1,338 @@
+#include "fix_scalar_functions.hpp"
+#include "table_function/read_fix_function.hpp"
+#include "dictionary/fix_dictionary_cache.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/expression_executor_state.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "parser/fix_hot_tags.hpp"
+#include "parser/fix_tokenizer.hpp"
+#include "parser/fix_type_conversions.hpp"
+#include <algorithm>
+
+namespace duckdb {
+
+// Fields of the fix_parse STRUCT in slot order, named and typed like the read_fix hot tag columns
+static const struct {
+	const char *name;
+	LogicalTypeId type;
+} FIX_PARSE_FIELDS[] = {
+    {"MsgType", LogicalTypeId::VARCHAR},
+    {"SenderCompID", LogicalTypeId::VARCHAR},
+    {"TargetCompID", LogicalTypeId::VARCHAR},
+    {"MsgSeqNum", LogicalTypeId::BIGINT},
+    {"SendingTime", LogicalTypeId::TIMESTAMP},
+    {"ClOrdID", LogicalTypeId::VARCHAR},
+    {"OrderID", LogicalTypeId::VARCHAR},
+    {"ExecID", LogicalTypeId::VARCHAR},
+    {"Symbol", LogicalTypeId::VARCHAR},
+    {"Side", LogicalTypeId::VARCHAR},
+    {"ExecType", LogicalTypeId::VARCHAR},
+    {"OrdStatus", LogicalTypeId::VARCHAR},
+    {"Price", LogicalTypeId::DOUBLE},
+    {"OrderQty", LogicalTypeId::DOUBLE},
+    {"CumQty", LogicalTypeId::DOUBLE},
+    {"LeavesQty", LogicalTypeId::DOUBLE},
+    {"LastPx", LogicalTypeId::DOUBLE},
+    {"LastQty", LogicalTypeId::DOUBLE},
+    {"Text", LogicalTypeId::VARCHAR}
+};
+
+static_assert(sizeof(FIX_PARSE_FIELDS) / sizeof(FIX_PARSE_FIELDS[0]) == FixHotTags::NUM_HOT_TAGS,
+              "fix_parse needs a field for every hot tag");
+
+// Delimiter a message uses: whichever of SOH and '|' ends its first field
+static char DetectDelimiter(const char *data, idx_t len) {
+	for (idx_t i = 0; i < len; i++) {
+		if (data[i] == '\x01' || data[i] == '|') {
+			return data[i];
+		}
+	}
+	return '\x01';
+}
+
+struct FixScalarBindData : public FunctionData {
+	// Requested tags (fix_get_tag, fix_get_tags) and their slots in tag_layout
+	vector<int> tags;
+	vector<uint16_t> slots;
+	FixTagLayout tag_layout;
+	// Without a delimiter argument, messages that use '|' are parsed with pipe_options
+	bool detect_delimiter = true;
+	FixParseOptions options;
+	FixParseOptions pipe_options;
+
+	const FixParseOptions &GetOptions(const char *data, idx_t len) const {
+		if (detect_delimiter && DetectDelimiter(data, len) == '|') {
+			return pipe_options;
+		}
+		return options;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<FixScalarBindData>(*this);
+	}
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<FixScalarBindData>();
+		return tags == other.tags && detect_delimiter == other.detect_delimiter &&
+		       options.delimiter == other.options.delimiter;
+	}
+};
+
+struct FixScalarLocalState : public FunctionLocalState {
+	explicit FixScalarLocalState(const FixTagLayout &tag_layout) : parsed(tag_layout) {
+	}
+
+	ParsedFixMessage parsed;
+};
+
+static unique_ptr<FunctionLocalState> FixScalarInitLocal(ExpressionState &state, const BoundFunctionExpression &expr,
+                                                         FunctionData *bind_data) {
+	return make_uniq<FixScalarLocalState>(bind_data->Cast<FixScalarBindData>().tag_layout);
+}
+
+static Value GetConstantArgument(ClientContext &context, const ScalarFunction &function, Expression &argument,
+                                 const char *name) {
+	if (!argument.IsFoldable()) {
+		throw BinderException("%s: %s must be a constant", function.name, name);
+	}
+	auto value = ExpressionExecutor::EvaluateScalar(context, argument);
+	if (value.IsNull()) {
+		throw BinderException("%s: %s cannot be NULL", function.name, name);
+	}
+	return value;
+}
+
+// Set up the delimiter (argument delimiter_arg if given) and stop the tokenizer at the requested slots
+static unique_ptr<FunctionData> FinishBind(ClientContext &context, ScalarFunction &bound_function,
+                                           vector<unique_ptr<Expression>> &arguments, idx_t delimiter_arg,
+                                           unique_ptr<FixScalarBindData> result) {
+	auto &options = result->options;
+	options.delimiter = '\x01';
+	options.keep_tag_list = false;
+	for (auto slot : result->slots) {
+		options.RequireSlot(slot);
+	}
+	// A tag that the repeating groups of the message type may repeat keeps its last occurrence: such messages
+	// are parsed to the end (groups of the embedded FIX 4.4 dictionary, MsgType tells which ones apply)
+	options.RequireSlot(static_cast<uint16_t>(FixHotTags::HotSlot(FixHotTags::MSG_TYPE)));
+	std::shared_ptr<const FixGroupLayout> group_layout;
+	FixDictionaryCache::Get(context, string(), group_layout);
+	options.SetGroupLayout(std::move(group_layout), result->tag_layout);
+	if (arguments.size() > delimiter_arg) {
+		auto delimiter = GetConstantArgument(context, bound_function, *arguments[delimiter_arg], "delimiter");
+		options.delimiter = ReadFixFunction::ParseDelimiter(StringValue::Get(delimiter));
+		result->detect_delimiter = false;
+	}
+	result->pipe_options = options;
+	result->pipe_options.delimiter = '|';
+	return std::move(result);
+}
+
+static int GetTagArgument(const ScalarFunction &function, const Value &value) {
+	auto tag = IntegerValue::Get(value.DefaultCastAs(LogicalType::INTEGER));
+	if (tag <= 0) {
+		throw BinderException("%s: invalid tag %d", function.name, tag);
+	}
+	return tag;
+}
+
+static void AddTag(FixScalarBindData &bind_data, int tag) {
+	if (std::find(bind_data.tags.begin(), bind_data.tags.end(), tag) == bind_data.tags.end()) {
+		bind_data.tags.push_back(tag);
+		bind_data.slots.push_back(bind_data.tag_layout.AddTag(tag));
+	}
+}
+
+static unique_ptr<FunctionData> FixGetTagBind(ClientContext &context, ScalarFunction &bound_function,
+                                              vector<unique_ptr<Expression>> &arguments) {
+	auto result = make_uniq<FixScalarBindData>();
+	auto tag = GetConstantArgument(context, bound_function, *arguments[1], "tag");
+	AddTag(*result, GetTagArgument(bound_function, tag));
+	return FinishBind(context, bound_function, arguments, 2, std::move(result));
+}
+
+static unique_ptr<FunctionData> FixGetTagsBind(ClientContext &context, ScalarFunction &bound_function,
+                                               vector<unique_ptr<Expression>> &arguments) {
+	auto result = make_uniq<FixScalarBindData>();
+	auto tags = GetConstantArgument(context, bound_function, *arguments[1], "tags");
+	for (auto &tag : ListValue::GetChildren(tags)) {
+		if (tag.IsNull()) {
+			throw BinderException("%s: tags cannot contain NULL", bound_function.name);
+		}
+		AddTag(*result, GetTagArgument(bound_function, tag));
+	}
+	return FinishBind(context, bound_function, arguments, 2, std::move(result));
+}
+
+static unique_ptr<FunctionData> FixParseBind(ClientContext &context, ScalarFunction &bound_function,
+                                             vector<unique_ptr<Expression>> &arguments) {
+	auto result = make_uniq<FixScalarBindData>();
+	for (auto tag : FixHotTags::ALL_TAGS) {
+		result->slots.push_back(result->tag_layout.GetSlot(tag));
+	}
+	return FinishBind(context, bound_function, arguments, 1, std::move(result));
+}
+
+// Call op(row, data, len) for every message of the chunk; NULL messages give NULL
+// Results reference the messages (see StringVector::AddHeapReference) instead of copying them
+template <class OP>
+static void ExecuteOverMessages(DataChunk &args, Vector &result, OP &&op) {
+	auto &input = args.data[0];
+	auto count = input.GetVectorType() == VectorType::CONSTANT_VECTOR ? 1 : args.size();
+	UnifiedVectorFormat format;
+	input.ToUnifiedFormat(count, format);
+	auto messages = UnifiedVectorFormat::GetData<string_t>(format);
+	for (idx_t row = 0; row < count; row++) {
+		auto idx = format.sel->get_index(row);
+		if (!format.validity.RowIsValid(idx)) {
+			FlatVector::SetNull(result, row, true);
+			continue;
+		}
+		auto &message = messages[idx];
+		op(row, message.GetData(), message.GetSize());
+	}
+	if (input.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+static inline string_t TagString(const ParsedFixMessage::TagValue &value) {
+	return string_t(value.data, static_cast<uint32_t>(value.len));
+}
+
+static void FixGetTagExecute(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &bind_data = state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<FixScalarBindData>();
+	auto &parsed = ExecuteFunctionState::GetFunctionState(state)->Cast<FixScalarLocalState>().parsed;
+	auto slot = bind_data.slots[0];
+	auto values = FlatVector::GetData<string_t>(result);
+	ExecuteOverMessages(args, result, [&](idx_t row, const char *data, idx_t len) {
+		FixTokenizer::Parse(data, len, parsed, bind_data.GetOptions(data, len));
+		auto &value = parsed.GetSlot(slot);
+		if (value.data == nullptr || value.len == 0) {
+			FlatVector::SetNull(result, row, true);
+			return;
+		}
+		values[row] = TagString(value);
+	});
+	StringVector::AddHeapReference(result, args.data[0]);
+}
+
+static void FixGetTagsExecute(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &bind_data = state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<FixScalarBindData>();
+	auto &parsed = ExecuteFunctionState::GetFunctionState(state)->Cast<FixScalarLocalState>().parsed;
+	auto entries = ListVector::GetData(result);
+	ExecuteOverMessages(args, result, [&](idx_t row, const char *data, idx_t len) {
+		FixTokenizer::Parse(data, len, parsed, bind_data.GetOptions(data, len));
+		auto offset = ListVector::GetListSize(result);
+		ListVector::Reserve(result, offset + bind_data.slots.size());
+		auto keys = FlatVector::GetData<int32_t>(MapVector::GetKeys(result));
+		auto values = FlatVector::GetData<string_t>(MapVector::GetValues(result));
+		idx_t found = 0;
+		for (idx_t i = 0; i < bind_data.slots.size(); i++) {
+			auto &value = parsed.GetSlot(bind_data.slots[i]);
+			if (value.data == nullptr || value.len == 0) {
+				continue;
+			}
+			keys[offset + found] = bind_data.tags[i];
+			values[offset + found] = TagString(value);
+			found++;
+		}
+		ListVector::SetListSize(result, offset + found);
+		entries[row].offset = offset;
+		entries[row].length = found;
+	});
+	StringVector::AddHeapReference(MapVector::GetValues(result), args.data[0]);
+}
+
+static void FixParseExecute(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &bind_data = state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<FixScalarBindData>();
+	auto &parsed = ExecuteFunctionState::GetFunctionState(state)->Cast<FixScalarLocalState>().parsed;
+	auto &fields = StructVector::GetEntries(result);
+	ExecuteOverMessages(args, result, [&](idx_t row, const char *data, idx_t len) {
+		// Messages the tokenizer rejects (no "8=", no MsgType, malformed fields) give NULL
+		if (!FixTokenizer::Parse(data, len, parsed, bind_data.GetOptions(data, len))) {
+			FlatVector::SetNull(result, row, true);
+			return;
+		}
+		for (idx_t slot = 0; slot < FixHotTags::NUM_HOT_TAGS; slot++) {
+			auto &field = *fields[slot];
+			auto &value = parsed.GetSlot(static_cast<uint16_t>(slot));
+			auto name = FIX_PARSE_FIELDS[slot].name;
+			bool valid;
+			switch (FIX_PARSE_FIELDS[slot].type) {
+			case LogicalTypeId::BIGINT: {
+				int64_t number;
+				valid = ConvertToInt64(value.data, value.len, number, nullptr, name);
+				if (valid) {
+					SetFlatField(field, row, number);
+				}
+				break;
+			}
+			case LogicalTypeId::DOUBLE: {
+				double number;
+				valid = ConvertToDouble(value.data, value.len, number, nullptr, name);
+				if (valid) {
+					SetFlatField(field, row, number);
+				}
+				break;
+			}
+			case LogicalTypeId::TIMESTAMP: {
+				timestamp_t time;
+				valid = ConvertToTimestamp(value.data, value.len, time, nullptr, name);
+				if (valid) {
+					SetFlatField(field, row, time);
+				}
+				break;
+			}
+			default:
+				valid = value.data != nullptr && value.len > 0;
+				if (valid) {
+					FlatVector::GetData<string_t>(field)[row] = TagString(value);
+				}
+				break;
+			}
+			if (!valid) {
+				SetNullField(field, row);
+			}
+		}
+	});
+	for (idx_t slot = 0; slot < FixHotTags::NUM_HOT_TAGS; slot++) {
+		if (FIX_PARSE_FIELDS[slot].type == LogicalTypeId::VARCHAR) {
+			StringVector::AddHeapReference(*fields[slot], args.data[0]);
+		}
+	}
+}
+
+// One overload without and one with a constant delimiter argument
+static ScalarFunctionSet MakeFunctionSet(const string &name, vector<LogicalType> arguments, LogicalType return_type,
+                                         scalar_function_t function, bind_scalar_function_t bind) {
+	ScalarFunctionSet set(name);
+	ScalarFunction func(name, std::move(arguments), std::move(return_type), function, bind);
+	func.init_local_state = FixScalarInitLocal;
+	set.AddFunction(func);
+	func.arguments.push_back(LogicalType(LogicalTypeId::VARCHAR));
+	set.AddFunction(func);
+	return set;
+}
+
+ScalarFunctionSet FixGetTagFunction::GetFunctions() {
+	return MakeFunctionSet("fix_get_tag", {LogicalType::VARCHAR, LogicalType::INTEGER}, LogicalType::VARCHAR,
+	                       FixGetTagExecute, FixGetTagBind);
+}
+
+ScalarFunctionSet FixGetTagsFunction::GetFunctions() {
+	return MakeFunctionSet("fix_get_tags", {LogicalType::VARCHAR, LogicalType::LIST(LogicalType::INTEGER)},
+	                       LogicalType::MAP(LogicalType::INTEGER, LogicalType::VARCHAR), FixGetTagsExecute,
+	                       FixGetTagsBind);
+}
+
+ScalarFunctionSet FixParseFunction::GetFunctions() {
+	child_list_t<LogicalType> fields;
+	for (auto &field : FIX_PARSE_FIELDS) {
+		fields.emplace_back(field.name, LogicalType(field.type));
+	}
+	return MakeFunctionSet("fix_parse", {LogicalType::VARCHAR}, LogicalType::STRUCT(std::move(fields)),
+	                       FixParseExecute, FixParseBind);
+}
+
+} // namespace duckdb
@@ -0,0 +1,24 @@
+#pragma once
+#include "duckdb/function/function_set.hpp"
+
+namespace duckdb {
+
+// Scalar functions over FIX messages already stored in tables (raw strings, e.g. the raw_message column)
+// The tag and delimiter arguments must be constants, they are resolved once at bind time
+
+// fix_get_tag(msg, tag) - value of the last occurrence of tag, NULL if the tag is missing
+struct FixGetTagFunction {
+	static ScalarFunctionSet GetFunctions();
+};
+
+// fix_get_tags(msg, [tags]) - MAP(INTEGER, VARCHAR) of the requested tags that are present
+struct FixGetTagsFunction {
+	static ScalarFunctionSet GetFunctions();
+};
+
+// fix_parse(msg) - STRUCT of the hot tags, typed like the read_fix columns
+struct FixParseFunction {
+	static ScalarFunctionSet GetFunctions();
+};
+
+} // namespace duckdb
@@ -3,8 +3,7 @@
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "dictionary/fix_dictionary.hpp"
-#include "dictionary/xml_loader.hpp"
-#include "dictionary/embedded_fix44_dictionary.hpp"
+#include "dictionary/fix_dictionary_cache.hpp"
 #include <unordered_set>
 
 namespace duckdb {
@@ -14,7 +13,7 @@ namespace duckdb {
 // =============================================================================
 
 struct FixFieldsBindData : public TableFunctionData {
-	shared_ptr<FixDictionary> dictionary;
+	shared_ptr<const FixDictionary> dictionary;
 };
 
 struct FixFieldsGlobalState : public GlobalTableFunctionState {
@@ -33,19 +32,10 @@ static unique_ptr<FunctionData> FixFieldsBind(ClientContext &context, TableFunct
                                               vector<LogicalType> &return_types, vector<string> &names) {
 	auto result = make_uniq<FixFieldsBindData>();
 
-	// Load FIX dictionary - use embedded by default, or custom path if provided
+	// Load FIX dictionary (cached) - use embedded by default, or custom path if provided
 	try {
-		FixDictionary dict;
-		if (input.inputs.empty()) {
-			// Use embedded FIX 4.4 dictionary
-			auto xml_content = GetEmbeddedFix44Dictionary();
-			dict = FixDictionaryLoader::LoadFromString(xml_content);
-		} else {
-			// Use provided dictionary file path
-			auto &dict_path = StringValue::Get(input.inputs[0]);
-			dict = FixDictionaryLoader::LoadBase(context, dict_path);
-		}
-		result->dictionary = make_shared_ptr<FixDictionary>(std::move(dict));
+		string dict_path = input.inputs.empty() ? string() : StringValue::Get(input.inputs[0]);
+		result->dictionary = FixDictionaryCache::Get(context, dict_path);
 	} catch (const std::exception &e) {
 		throw BinderException("Failed to load FIX dictionary: %s", e.what());
 	}
@@ -148,7 +138,7 @@ TableFunction FixFieldsFunction::GetFunction() {
 // =============================================================================
 
 struct FixMessageFieldsBindData : public TableFunctionData {
-	shared_ptr<FixDictionary> dictionary;
+	shared_ptr<const FixDictionary> dictionary;
 };
 
 struct MessageFieldEntry {
@@ -195,19 +185,10 @@ static unique_ptr<FunctionData> FixMessageFieldsBind(ClientContext &context, Tab
                                                      vector<LogicalType> &return_types, vector<string> &names) {
 	auto result = make_uniq<FixMessageFieldsBindData>();
 
-	// Load FIX dictionary - use embedded by default, or custom path if provided
+	// Load FIX dictionary (cached) - use embedded by default, or custom path if provided
 	try {
-		FixDictionary dict;
-		if (input.inputs.empty()) {
-			// Use embedded FIX 4.4 dictionary
-			auto xml_content = GetEmbeddedFix44Dictionary();
-			dict = FixDictionaryLoader::LoadFromString(xml_content);
-		} else {
-			// Use provided dictionary file path
-			auto &dict_path = StringValue::Get(input.inputs[0]);
-			dict = FixDictionaryLoader::LoadBase(context, dict_path);
-		}
-		result->dictionary = make_shared_ptr<FixDictionary>(std::move(dict));
+		string dict_path = input.inputs.empty() ? string() : StringValue::Get(input.inputs[0]);
+		result->dictionary = FixDictionaryCache::Get(context, dict_path);
 	} catch (const std::exception &e) {
 		throw BinderException("Failed to load FIX dictionary: %s", e.what());
 	}
@@ -332,7 +313,7 @@ TableFunction FixMessageFieldsFunction::GetFunction() {
 // =============================================================================
 
 struct FixGroupsBindData : public TableFunctionData {
-	shared_ptr<FixDictionary> dictionary;
+	shared_ptr<const FixDictionary> dictionary;
 };
 
 struct GroupEntry {
@@ -387,19 +368,10 @@ static unique_ptr<FunctionData> FixGroupsBind(ClientContext &context, TableFunct
                                               vector<LogicalType> &return_types, vector<string> &names) {
 	auto result = make_uniq<FixGroupsBindData>();
 
-	// Load FIX dictionary - use embedded by default, or custom path if provided
+	// Load FIX dictionary (cached) - use embedded by default, or custom path if provided
 	try {
-		FixDictionary dict;
-		if (input.inputs.empty()) {
-			// Use embedded FIX 4.4 dictionary
-			auto xml_content = GetEmbeddedFix44Dictionary();
-			dict = FixDictionaryLoader::LoadFromString(xml_content);
-		} else {
-			// Use provided dictionary file path
-			auto &dict_path = StringValue::Get(input.inputs[0]);
-			dict = FixDictionaryLoader::LoadBase(context, dict_path);
-		}
-		result->dictionary = make_shared_ptr<FixDictionary>(std::move(dict));
+		string dict_path = input.inputs.empty() ? string() : StringValue::Get(input.inputs[0]);
+		result->dictionary = FixDictionaryCache::Get(context, dict_path);
 	} catch (const std::exception &e) {
 		throw BinderException("Failed to load FIX dictionary: %s", e.what());
 	}
@@ -0,0 +1,656 @@
+#include "fix_convert_function.hpp"
+#include "read_fix_function.hpp"
+#include "dictionary/fix_dictionary_cache.hpp"
+#include "parser/fix_file_reader.hpp"
+#include "parser/fix_group_layout.hpp"
+#include "parser/fix_group_parser.hpp"
+#include "parser/fix_hot_tags.hpp"
+#include "parser/fix_tag_index.hpp"
+#include "parser/fix_tokenizer.hpp"
+#include "parser/fix_type_conversions.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/copy_function_catalog_entry.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/execution/execution_context.hpp"
+#include "duckdb/function/copy_function.hpp"
+#include "duckdb/main/extension_helper.hpp"
+#include "duckdb/parallel/thread_context.hpp"
+#include "duckdb/parser/parsed_data/copy_info.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace duckdb {
+
+// Position in the ordered tag list of a column's value, NO_POSITION if the message does not have the tag
+static constexpr uint32_t NO_POSITION = 0xFFFFFFFF;
+
+struct FixConvertBindData : public TableFunctionData {
+	vector<string> files;
+	string out_dir;
+	shared_ptr<const FixDictionary> dictionary;
+	std::shared_ptr<const FixGroupLayout> group_layout;
+	char delimiter = '|';
+	FileCompressionType compression = FileCompressionType::AUTO_DETECT;
+	// The Parquet writer, called directly so that one scan feeds the files of every message type
+	unique_ptr<CopyFunction> parquet;
+};
+
+// A column (or a member of a group's STRUCT) filled from one tag, typed like read_fix with typed_tags
+struct FixConvertField {
+	int tag;
+	LogicalType type;
+};
+
+// A repeating group: LIST(STRUCT(fields..., nested groups...))
+struct FixConvertGroup {
+	int count_tag;
+	vector<FixConvertField> fields;
+	// Member index of each field tag, sorted by tag
+	vector<pair<int, idx_t>> field_members;
+	// Nested groups, members after the fields, sorted by count tag
+	vector<FixConvertGroup> groups;
+	LogicalType type;
+};
+
+// The Parquet file of one message type: its wide schema and the writer state shared by the threads
+struct FixConvertFile {
+	string msg_type;
+	// Dictionary name of the message type, empty if it is not in the dictionary
+	string name;
+	string path;
+	// Hot tags (in slot order), then the body fields of the message
+	vector<FixConvertField> fields;
+	// Column of each body field tag, sorted by tag
+	vector<pair<int, idx_t>> field_columns;
+	// Group columns after the fields, sorted by count tag
+	vector<FixConvertGroup> groups;
+	// Message types missing from the dictionary have a tags map after the hot tags instead
+	bool tags_map = false;
+	vector<LogicalType> types;
+
+	unique_ptr<FunctionData> copy_bind_data;
+	unique_ptr<GlobalFunctionData> copy_state;
+	std::atomic<int64_t> rows {0};
+};
+
+struct FixConvertGlobalState : public GlobalTableFunctionState {
+	FixRangeScheduler scheduler;
+	FixParseOptions parse_options;
+	std::shared_ptr<const FixGroupLayout> group_layout;
+
+	std::mutex lock;
+	// Files by message type, each created by the first thread that finds the type
+	std::unordered_map<string, unique_ptr<FixConvertFile>> files;
+	// Threads still converting; the last one to finish closes the files
+	idx_t active_threads = 0;
+	bool finished = false;
+	// Closed files in msg_type order, returned as rows
+	vector<const FixConvertFile *> outputs;
+	idx_t next_output = 0;
+
+	explicit FixConvertGlobalState(const FixConvertBindData &bind_data)
+	    : scheduler(bind_data.files, DEFAULT_FIX_RANGE_SIZE, bind_data.compression),
+	      group_layout(bind_data.group_layout) {
+		parse_options.delimiter = bind_data.delimiter;
+	}
+
+	idx_t MaxThreads() const override {
+		// Ranges are handed out on demand, threads that find no work finish immediately
+		return GlobalTableFunctionState::MAX_THREADS;
+	}
+};
+
+// A thread's rows of one file, written to Parquet a chunk at a time
+struct FixConvertLocalFile {
+	FixConvertFile *file;
+	DataChunk chunk;
+	unique_ptr<LocalFunctionData> copy_state;
+};
+
+struct FixConvertLocalState : public LocalTableFunctionState {
+	ThreadContext thread;
+	ExecutionContext execution;
+	FixFileReader file_reader;
+
+	// Reused across messages so that steady-state parsing does not allocate
+	ParsedFixMessage parsed;
+	FixParsedGroups parsed_groups;
+	FixTagIndex tag_index;
+	vector<uint32_t> positions;
+
+	std::unordered_map<string, unique_ptr<FixConvertLocalFile>> files;
+	bool finished = false;
+
+	FixConvertLocalState(ClientContext &context, const FixConvertBindData &bind_data)
+	    : thread(context), execution(context, thread, nullptr) {
+		file_reader.SetFraming(FixFraming::LINES, bind_data.delimiter);
+	}
+};
+
+// Column name of a tag, like the tagIds columns of read_fix
+static string GetFieldName(const FixDictionary &dict, int tag) {
+	auto field = dict.fields.find(tag);
+	return field == dict.fields.end() ? "Tag" + std::to_string(tag) : field->second.name;
+}
+
+// Type read_fix gives the field with typed_tags
+static LogicalType GetFieldType(const FixDictionary &dict, int tag) {
+	auto field = dict.fields.find(tag);
+	if (field == dict.fields.end()) {
+		return LogicalType(LogicalTypeId::VARCHAR);
+	}
+	return ReadFixFunction::GetTypedTagLogicalType(field->second.type);
+}
+
+static vector<const FixGroupDef *> SortGroups(const FixGroupLayout::GroupDefMap &groups) {
+	vector<const FixGroupDef *> result;
+	for (auto &group : groups) {
+		if (group.second) {
+			result.push_back(group.second);
+		}
+	}
+	std::sort(result.begin(), result.end(),
+	          [](const FixGroupDef *a, const FixGroupDef *b) { return a->count_tag < b->count_tag; });
+	return result;
+}
+
+// Index of tag in a sorted {tag, index} list, DConstants::INVALID_INDEX if it is not there
+static idx_t FindIndex(const vector<pair<int, idx_t>> &indexes, int tag) {
+	auto entry = std::lower_bound(indexes.begin(), indexes.end(), tag,
+	                              [](const pair<int, idx_t> &index, int t) { return index.first < t; });
+	return entry != indexes.end() && entry->first == tag ? entry->second : DConstants::INVALID_INDEX;
+}
+
+// Fields and nested groups of a group, false if it has neither
+// Groups (wrongly) nested in themselves stop at the component depth limit
+static bool BuildGroup(const FixDictionary &dict, const FixGroupDef &def, int depth, FixConvertGroup &group) {
+	std::vector<int> fields(def.field_tags.begin(), def.field_tags.end());
+	FixGroupLayout::GroupDefMap subgroups;
+	for (auto &sub : def.subgroups) {
+		subgroups.emplace(sub.first, sub.second.get());
+	}
+	FixGroupLayout::ResolveComponents(dict, def.component_refs, fields, subgroups, 0);
+
+	group.count_tag = def.count_tag;
+	child_list_t<LogicalType> members;
+	std::unordered_set<int> added_fields;
+	for (auto tag : fields) {
+		if (subgroups.find(tag) != subgroups.end() || !added_fields.insert(tag).second) {
+			continue;
+		}
+		auto type = GetFieldType(dict, tag);
+		group.field_members.emplace_back(tag, group.fields.size());
+		group.fields.push_back({tag, type});
+		members.emplace_back(GetFieldName(dict, tag), type);
+	}
+	std::sort(group.field_members.begin(), group.field_members.end());
+	if (depth < FixGroupLayout::MAX_COMPONENT_DEPTH) {
+		for (auto sub : SortGroups(subgroups)) {
+			FixConvertGroup nested;
+			if (BuildGroup(dict, *sub, depth + 1, nested)) {
+				members.emplace_back(GetFieldName(dict, sub->count_tag), nested.type);
+				group.groups.push_back(std::move(nested));
+			}
+		}
+	}
+	if (members.empty()) {
+		return false;
+	}
+	group.type = LogicalType::LIST(LogicalType::STRUCT(std::move(members)));
+	return true;
+}
+
+// Message types and names can hold any character, file names keep letters, digits, '-' and '_'
+static string SanitizeFileName(const string &name) {
+	string result = name;
+	for (auto &c : result) {
+		if (!StringUtil::CharacterIsAlphaNumeric(c) && c != '-' && c != '_') {
+			c = '_';
+		}
+	}
+	return result;
+}
+
+// The wide schema of a message type, and its Parquet file opened for writing
+// Hot tags come first, then every other field of the dictionary message; count tags become group columns
+static unique_ptr<FixConvertFile> CreateFile(ClientContext &context, const FixConvertBindData &bind_data,
+                                             const string &msg_type) {
+	auto &dict = *bind_data.dictionary;
+	auto file = make_uniq<FixConvertFile>();
+	file->msg_type = msg_type;
+
+	vector<string> names;
+	ReadFixFunction::AddHotColumns(names, file->types);
+	for (idx_t i = 0; i < FixHotTags::NUM_HOT_TAGS; i++) {
+		file->fields.push_back({FixHotTags::ALL_TAGS[i], file->types[i]});
+	}
+
+	string file_name = SanitizeFileName(msg_type);
+	auto message = dict.messages.find(msg_type);
+	if (message != dict.messages.end()) {
+		file->name = message->second.name;
+		file_name += "_" + SanitizeFileName(file->name);
+
+		std::vector<int> fields(message->second.required_fields.begin(), message->second.required_fields.end());
+		fields.insert(fields.end(), message->second.optional_fields.begin(), message->second.optional_fields.end());
+		FixGroupLayout::GroupDefMap groups;
+		for (auto &group : message->second.groups) {
+			groups.emplace(group.first, group.second.get());
+		}
+		FixGroupLayout::ResolveComponents(dict, message->second.component_refs, fields, groups, 0);
+
+		std::unordered_set<int> added_fields;
+		for (auto tag : fields) {
+			if (FixHotTags::IsHotTag(tag) || groups.find(tag) != groups.end() || !added_fields.insert(tag).second) {
+				continue;
+			}
+			file->field_columns.emplace_back(tag, file->fields.size());
+			file->fields.push_back({tag, GetFieldType(dict, tag)});
+			names.push_back(GetFieldName(dict, tag));
+			file->types.push_back(file->fields.back().type);
+		}
+		std::sort(file->field_columns.begin(), file->field_columns.end());
+		for (auto def : SortGroups(groups)) {
+			FixConvertGroup group;
+			if (BuildGroup(dict, *def, 0, group)) {
+				names.push_back(GetFieldName(dict, def->count_tag));
+				file->types.push_back(group.type);
+				file->groups.push_back(std::move(group));
+			}
+		}
+	} else {
+		// Message types missing from the dictionary keep the other tags in a map
+		file->tags_map = true;
+		names.emplace_back("tags");
+		file->types.push_back(LogicalType::MAP(LogicalType::INTEGER, LogicalType::VARCHAR));
+	}
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	file->path = fs.JoinPath(bind_data.out_dir, file_name + ".parquet");
+
+	CopyInfo info;
+	info.format = "parquet";
+	info.file_path = file->path;
+	info.is_from = false;
+	CopyFunctionBindInput bind_input(info);
+	auto &parquet = *bind_data.parquet;
+	file->copy_bind_data = parquet.copy_to_bind(context, bind_input, names, file->types);
+	file->copy_state = parquet.copy_to_initialize_global(context, *file->copy_bind_data, file->path);
+	return file;
+}
+
+// Convert a value with the read_fix converters; empty and invalid values become NULL
+static void WriteValue(Vector &column, idx_t row, const LogicalType &type, const ParsedFixMessage::TagValue &value) {
+	switch (type.id()) {
+	case LogicalTypeId::BIGINT: {
+		int64_t val;
+		if (ConvertToInt64(value.data, value.len, val, nullptr, nullptr)) {
+			SetFlatField(column, row, val);
+		} else {
+			SetNullField(column, row);
+		}
+		break;
+	}
+	case LogicalTypeId::DOUBLE: {
+		double val;
+		if (ConvertToDouble(value.data, value.len, val, nullptr, nullptr)) {
+			SetFlatField(column, row, val);
+		} else {
+			SetNullField(column, row);
+		}
+		break;
+	}
+	case LogicalTypeId::TIMESTAMP: {
+		timestamp_t val;
+		if (ConvertToTimestamp(value.data, value.len, val, nullptr, nullptr)) {
+			SetFlatField(column, row, val);
+		} else {
+			SetNullField(column, row);
+		}
+		break;
+	}
+	case LogicalTypeId::BOOLEAN: {
+		bool val;
+		if (ConvertToBoolean(value.data, value.len, val, nullptr, nullptr)) {
+			SetFlatField(column, row, val);
+		} else {
+			SetNullField(column, row);
+		}
+		break;
+	}
+	default:
+		SetStringField(column, row, value.data, value.len);
+		break;
+	}
+}
+
+static const ParsedFixMessage::TagValue &GetValue(const ParsedFixMessage &parsed, uint32_t position) {
+	static const ParsedFixMessage::TagValue missing {nullptr, 0};
+	return position == NO_POSITION ? missing : parsed.all_tags_ordered[position].second;
+}
+
+// Write the group with the count tag of group among parsed groups[begin, begin + count) as the entry of row
+// positions is scratch space, free again once an instance's fields are written
+static void WriteGroup(Vector &list_vec, idx_t row, const FixConvertGroup &group, const ParsedFixMessage &parsed,
+                       const FixParsedGroups &parsed_groups, size_t begin, size_t count, vector<uint32_t> &positions) {
+	const FixGroupSpan *span = nullptr;
+	for (size_t g = begin; g < begin + count; g++) {
+		if (parsed_groups.groups[g].count_tag == group.count_tag) {
+			span = &parsed_groups.groups[g];
+			break;
+		}
+	}
+	if (!span) {
+		SetNullField(list_vec, row);
+		return;
+	}
+
+	auto offset = ListVector::GetListSize(list_vec);
+	ListVector::Reserve(list_vec, offset + span->instance_count);
+	auto &members = StructVector::GetEntries(ListVector::GetEntry(list_vec));
+	auto &ordered_tags = parsed.all_tags_ordered;
+	for (idx_t i = 0; i < span->instance_count; i++) {
+		auto &instance = parsed_groups.instances[span->instance_begin + i];
+		positions.assign(group.fields.size(), NO_POSITION);
+		for (auto f = instance.begin; f < instance.end; f++) {
+			auto member = FindIndex(group.field_members, ordered_tags[parsed_groups.fields[f]].first);
+			if (member != DConstants::INVALID_INDEX) {
+				positions[member] = parsed_groups.fields[f];
+			}
+		}
+		for (idx_t m = 0; m < group.fields.size(); m++) {
+			WriteValue(*members[m], offset + i, group.fields[m].type, GetValue(parsed, positions[m]));
+		}
+		for (idx_t n = 0; n < group.groups.size(); n++) {
+			WriteGroup(*members[group.fields.size() + n], offset + i, group.groups[n], parsed, parsed_groups,
+			           instance.group_begin, instance.group_count, positions);
+		}
+	}
+	ListVector::SetListSize(list_vec, offset + span->instance_count);
+
+	auto &entry = ListVector::GetData(list_vec)[row];
+	entry.offset = offset;
+	entry.length = span->instance_count;
+}
+
+// Append a message to the thread's chunk of its file
+static void WriteMessage(const FixConvertGlobalState &gstate, FixConvertLocalState &lstate,
+                         FixConvertLocalFile &local) {
+	auto &file = *local.file;
+	auto &chunk = local.chunk;
+	auto &parsed = lstate.parsed;
+	auto &ordered_tags = parsed.all_tags_ordered;
+	auto row = chunk.size();
+
+	for (idx_t i = 0; i < FixHotTags::NUM_HOT_TAGS; i++) {
+		WriteValue(chunk.data[i], row, file.types[i], parsed.GetSlot(static_cast<uint16_t>(i)));
+	}
+
+	if (file.tags_map) {
+		auto &tags_vec = chunk.data[FixHotTags::NUM_HOT_TAGS];
+		if (parsed.other_tag_count == 0) {
+			SetNullField(tags_vec, row);
+		} else {
+			// MAP keys must be unique: repeated tags keep their last value, as in read_fix
+			auto &tag_index = lstate.tag_index;
+			tag_index.Reset(parsed.other_tag_count);
+			for (idx_t i = 0; i < ordered_tags.size(); i++) {
+				if (!FixHotTags::IsHotTag(ordered_tags[i].first)) {
+					tag_index.Insert(ordered_tags[i].first, static_cast<uint32_t>(i));
+				}
+			}
+			auto &positions = tag_index.Positions();
+			auto offset = ListVector::GetListSize(tags_vec);
+			ListVector::Reserve(tags_vec, offset + positions.size());
+			auto keys = FlatVector::GetData<int32_t>(MapVector::GetKeys(tags_vec));
+			auto &value_vec = MapVector::GetValues(tags_vec);
+			for (idx_t i = 0; i < positions.size(); i++) {
+				auto &tag = ordered_tags[positions[i]];
+				keys[offset + i] = tag.first;
+				FlatVector::GetData<string_t>(value_vec)[offset + i] =
+				    StringVector::AddString(value_vec, tag.second.data, tag.second.len);
+			}
+			ListVector::SetListSize(tags_vec, offset + positions.size());
+			auto &entry = ListVector::GetData(tags_vec)[row];
+			entry.offset = offset;
+			entry.length = positions.size();
+		}
+	} else {
+		// Body fields keep their last occurrence, like tagIds columns
+		auto &positions = lstate.positions;
+		positions.assign(file.fields.size(), NO_POSITION);
+		for (idx_t i = 0; i < ordered_tags.size(); i++) {
+			auto column = FindIndex(file.field_columns, ordered_tags[i].first);
+			if (column != DConstants::INVALID_INDEX) {
+				positions[column] = static_cast<uint32_t>(i);
+			}
+		}
+		for (idx_t c = FixHotTags::NUM_HOT_TAGS; c < file.fields.size(); c++) {
+			WriteValue(chunk.data[c], row, file.fields[c].type, GetValue(parsed, positions[c]));
+		}
+
+		if (!file.groups.empty()) {
+			// Cleared first, so a message without groups has none
+			auto &parsed_groups = lstate.parsed_groups;
+			FixGroupParser::ParseGroups(parsed, *gstate.group_layout, parsed_groups);
+			for (idx_t g = 0; g < file.groups.size(); g++) {
+				WriteGroup(chunk.data[file.fields.size() + g], row, file.groups[g], parsed, parsed_groups, 0,
+				           parsed_groups.message_group_count, positions);
+			}
+		}
+	}
+	chunk.SetCardinality(row + 1);
+}
+
+// Hand a thread's chunk of a file to the Parquet writer
+static void FlushChunk(const FixConvertBindData &bind_data, FixConvertLocalState &lstate, FixConvertLocalFile &local) {
+	if (local.chunk.size() == 0) {
+		return;
+	}
+	auto &file = *local.file;
+	file.rows += static_cast<int64_t>(local.chunk.size());
+	bind_data.parquet->copy_to_sink(lstate.execution, *file.copy_bind_data, *file.copy_state, *local.copy_state,
+	                                local.chunk);
+	local.chunk.Reset();
+}
+
+// The thread's chunk of the file of a message type, creating the file when the type is new to the scan
+static FixConvertLocalFile &GetLocalFile(ClientContext &context, const FixConvertBindData &bind_data,
+                                         FixConvertGlobalState &gstate, FixConvertLocalState &lstate,
+                                         const ParsedFixMessage::TagValue &msg_type) {
+	string key(msg_type.data, msg_type.len);
+	auto entry = lstate.files.find(key);
+	if (entry != lstate.files.end()) {
+		return *entry->second;
+	}
+
+	FixConvertFile *file;
+	{
+		std::lock_guard<std::mutex> guard(gstate.lock);
+		auto &shared = gstate.files[key];
+		if (!shared) {
+			shared = CreateFile(context, bind_data, key);
+		}
+		file = shared.get();
+	}
+	auto local = make_uniq<FixConvertLocalFile>();
+	local->file = file;
+	local->chunk.Initialize(Allocator::Get(context), file->types);
+	local->copy_state = bind_data.parquet->copy_to_initialize_local(lstate.execution, *file->copy_bind_data);
+	auto &result = *local;
+	lstate.files.emplace(std::move(key), std::move(local));
+	return result;
+}
+
+// Read this thread's ranges until none is left, routing every message to the file of its type
+static void ConvertRanges(ClientContext &context, const FixConvertBindData &bind_data, FixConvertGlobalState &gstate,
+                          FixConvertLocalState &lstate) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	const char *line;
+	idx_t line_len;
+	while (true) {
+		if (!lstate.file_reader.IsOpen() && !lstate.file_reader.OpenNextRange(fs, gstate.scheduler)) {
+			break;
+		}
+		if (!lstate.file_reader.ReadLine(line, line_len)) {
+			lstate.file_reader.Close();
+			continue;
+		}
+		if (line_len == 0) {
+			continue;
+		}
+		auto &parsed = lstate.parsed;
+		FixTokenizer::Parse(line, line_len, parsed, gstate.parse_options);
+		auto &msg_type = parsed.Hot<FixHotTags::MSG_TYPE>();
+		if (msg_type.data == nullptr || msg_type.len == 0) {
+			continue; // Nothing to route it by
+		}
+		auto &local = GetLocalFile(context, bind_data, gstate, lstate, msg_type);
+		WriteMessage(gstate, lstate, local);
+		if (local.chunk.size() == STANDARD_VECTOR_SIZE) {
+			FlushChunk(bind_data, lstate, local);
+		}
+	}
+
+	for (auto &entry : lstate.files) {
+		auto &local = *entry.second;
+		FlushChunk(bind_data, lstate, local);
+		bind_data.parquet->copy_to_combine(lstate.execution, *local.file->copy_bind_data, *local.file->copy_state,
+		                                   *local.copy_state);
+	}
+}
+
+static unique_ptr<FunctionData> FixConvertBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<FixConvertBindData>();
+	auto &files = StringValue::Get(input.inputs[0]);
+	result->out_dir = StringValue::Get(input.inputs[1]);
+	if (result->out_dir.empty()) {
+		throw BinderException("fix_convert: out_dir cannot be empty");
+	}
+
+	// Fail at bind time when nothing matches, like read_fix
+	auto &fs = FileSystem::GetFileSystem(context);
+	for (auto &file_info : fs.GlobFiles(files, context, FileGlobOptions::DISALLOW_EMPTY)) {
+		result->files.push_back(file_info.path);
+	}
+
+	string dict_path;
+	if (input.named_parameters.find("dictionary") != input.named_parameters.end()) {
+		dict_path = StringValue::Get(input.named_parameters.at("dictionary"));
+	}
+	try {
+		result->dictionary = FixDictionaryCache::Get(context, dict_path, result->group_layout);
+	} catch (const std::exception &e) {
+		throw BinderException("Failed to load FIX dictionary: %s", e.what());
+	}
+
+	if (input.named_parameters.find("delimiter") != input.named_parameters.end()) {
+		result->delimiter = ReadFixFunction::ParseDelimiter(StringValue::Get(input.named_parameters.at("delimiter")));
+	}
+
+	if (input.named_parameters.find("compression") != input.named_parameters.end()) {
+		result->compression = FileCompressionTypeFromString(StringValue::Get(input.named_parameters.at("compression")));
+	}
+
+	// The parquet extension provides the writer, loaded on demand like for COPY ... (FORMAT parquet)
+	auto parquet = Catalog::GetEntry<CopyFunctionCatalogEntry>(context, INVALID_CATALOG, DEFAULT_SCHEMA, "parquet",
+	                                                           OnEntryNotFound::RETURN_NULL);
+	if (!parquet && ExtensionHelper::TryAutoLoadExtension(context, "parquet")) {
+		parquet = Catalog::GetEntry<CopyFunctionCatalogEntry>(context, INVALID_CATALOG, DEFAULT_SCHEMA, "parquet",
+		                                                      OnEntryNotFound::RETURN_NULL);
+	}
+	if (!parquet) {
+		throw BinderException("fix_convert requires the parquet extension");
+	}
+	result->parquet = make_uniq<CopyFunction>(parquet->function);
+
+	names.emplace_back("msg_type");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("name");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("file");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("rows");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> FixConvertInitGlobal(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<FixConvertBindData>();
+	auto &fs = FileSystem::GetFileSystem(context);
+	if (!fs.DirectoryExists(bind_data.out_dir)) {
+		fs.CreateDirectory(bind_data.out_dir);
+	}
+	return make_uniq<FixConvertGlobalState>(bind_data);
+}
+
+static unique_ptr<LocalTableFunctionState> FixConvertInitLocal(ExecutionContext &context,
+                                                               TableFunctionInitInput &input,
+                                                               GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<FixConvertBindData>();
+	auto &gstate = global_state->Cast<FixConvertGlobalState>();
+	{
+		std::lock_guard<std::mutex> guard(gstate.lock);
+		gstate.active_threads++;
+	}
+	return make_uniq<FixConvertLocalState>(context.client, bind_data);
+}
+
+static void FixConvertScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<FixConvertBindData>();
+	auto &gstate = data_p.global_state->Cast<FixConvertGlobalState>();
+	auto &lstate = data_p.local_state->Cast<FixConvertLocalState>();
+
+	// Every thread converts on its first call; the last one to finish closes the files
+	if (!lstate.finished) {
+		lstate.finished = true;
+		ConvertRanges(context, bind_data, gstate, lstate);
+
+		std::lock_guard<std::mutex> guard(gstate.lock);
+		if (--gstate.active_threads == 0 && !gstate.finished) {
+			gstate.finished = true;
+			for (auto &entry : gstate.files) {
+				auto &file = *entry.second;
+				bind_data.parquet->copy_to_finalize(context, *file.copy_bind_data, *file.copy_state);
+				gstate.outputs.push_back(&file);
+			}
+			std::sort(gstate.outputs.begin(), gstate.outputs.end(),
+			          [](const FixConvertFile *a, const FixConvertFile *b) { return a->msg_type < b->msg_type; });
+		}
+	}
+
+	// The rows describe the files, returned once they are all closed
+	std::lock_guard<std::mutex> guard(gstate.lock);
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE && gstate.next_output < gstate.outputs.size()) {
+		auto &file = *gstate.outputs[gstate.next_output++];
+		output.data[0].SetValue(output_idx, Value(file.msg_type));
+		output.data[1].SetValue(output_idx, file.name.empty() ? Value() : Value(file.name));
+		output.data[2].SetValue(output_idx, Value(file.path));
+		output.data[3].SetValue(output_idx, Value::BIGINT(file.rows));
+		output_idx++;
+	}
+
+	output.SetCardinality(output_idx);
+}
+
+TableFunction FixConvertFunction::GetFunction() {
+	TableFunction func("fix_convert", {LogicalType(LogicalTypeId::VARCHAR), LogicalType(LogicalTypeId::VARCHAR)},
+	                   FixConvertScan, FixConvertBind, FixConvertInitGlobal, FixConvertInitLocal);
+	func.name = "fix_convert";
+	func.named_parameters["delimiter"] = LogicalType(LogicalTypeId::VARCHAR);
+	func.named_parameters["dictionary"] = LogicalType(LogicalTypeId::VARCHAR);
+	func.named_parameters["compression"] = LogicalType(LogicalTypeId::VARCHAR);
+	return func;
+}
+
+} // namespace duckdb
@@ -0,0 +1,13 @@
+#pragma once
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// fix_convert(files, out_dir) - writes one Parquet file per MsgType of FIX logs, each with the wide typed schema
+// of its dictionary message (fields as typed columns, repeating groups as LIST<STRUCT> columns)
+class FixConvertFunction {
+public:
+	static TableFunction GetFunction();
+};
+
+} // namespace duckdb
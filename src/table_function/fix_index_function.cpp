@@ -0,0 +1,156 @@
+#include "fix_index_function.hpp"
+#include "read_fix_function.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/limits.hpp"
+#include "parser/fix_file_reader.hpp"
+#include "parser/fix_sparse_index.hpp"
+#include "parser/fix_tokenizer.hpp"
+
+namespace duckdb {
+
+struct FixBuildIndexBindData : public TableFunctionData {
+	vector<string> files;
+	char delimiter = '|';
+	idx_t block_lines = FixSparseIndex::DEFAULT_BLOCK_LINES;
+};
+
+struct FixBuildIndexGlobalState : public GlobalTableFunctionState {
+	idx_t next_file = 0;
+
+	idx_t MaxThreads() const override {
+		return 1;
+	}
+};
+
+static unique_ptr<FunctionData> FixBuildIndexBind(ClientContext &context, TableFunctionBindInput &input,
+                                                  vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<FixBuildIndexBindData>();
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto file_list = fs.GlobFiles(StringValue::Get(input.inputs[0]), context, FileGlobOptions::DISALLOW_EMPTY);
+	for (auto &file_info : file_list) {
+		result->files.push_back(file_info.path);
+	}
+
+	// Must match the delimiter read_fix is called with, the index is only used then
+	if (input.named_parameters.find("delimiter") != input.named_parameters.end()) {
+		result->delimiter = ReadFixFunction::ParseDelimiter(StringValue::Get(input.named_parameters.at("delimiter")));
+	}
+
+	if (input.named_parameters.find("block_lines") != input.named_parameters.end()) {
+		auto block_lines = BigIntValue::Get(input.named_parameters.at("block_lines"));
+		if (block_lines <= 0) {
+			throw BinderException("block_lines must be greater than zero");
+		}
+		result->block_lines = static_cast<idx_t>(block_lines);
+	}
+
+	names.emplace_back("file");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("index_file");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("lines");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	names.emplace_back("blocks");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> FixBuildIndexInitGlobal(ClientContext &context,
+                                                                    TableFunctionInitInput &input) {
+	return make_uniq<FixBuildIndexGlobalState>();
+}
+
+// Scan one file and build its index
+static FixSparseIndex BuildFileIndex(FileSystem &fs, const string &file, const FixBuildIndexBindData &bind_data) {
+	// Compressed files are detected and rejected, their offsets do not match the decompressed lines
+	auto handle = fs.OpenFile(file, FileFlags::FILE_FLAGS_READ | FileCompressionType::AUTO_DETECT);
+	if (!handle->CanSeek()) {
+		throw InvalidInputException("fix_build_index: '%s' does not support seeking and cannot be indexed", file);
+	}
+	auto file_size = handle->GetFileSize();
+	auto stamp = FixSparseIndex::ComputeStamp(*handle, file_size);
+	handle.reset();
+
+	// Only the indexed tags are needed, the tokenizer stops once it has them
+	FixParseOptions options;
+	options.delimiter = bind_data.delimiter;
+	options.keep_tag_list = false;
+	for (auto tag : {FixHotTags::MSG_TYPE, FixHotTags::SENDER_COMP_ID, FixHotTags::TARGET_COMP_ID,
+	                 FixHotTags::MSG_SEQ_NUM, FixHotTags::SENDING_TIME}) {
+		options.RequireSlot(static_cast<uint16_t>(FixHotTags::HotSlot(tag)));
+	}
+
+	// The whole file as a single range
+	vector<string> files {file};
+	FixRangeScheduler scheduler(files, NumericLimits<idx_t>::Maximum());
+	FixFileReader reader;
+	ParsedFixMessage parsed;
+	FixSparseIndexBuilder builder(bind_data.delimiter, bind_data.block_lines);
+	if (reader.OpenNextRange(fs, scheduler)) {
+		const char *line;
+		idx_t line_len;
+		while (reader.ReadLine(line, line_len)) {
+			// Empty lines are skipped by read_fix as well
+			if (line_len == 0) {
+				continue;
+			}
+			FixTokenizer::Parse(line, line_len, parsed, options);
+			builder.AddLine(reader.GetLineOffset(), parsed);
+		}
+		reader.Close();
+	}
+	return builder.Finish(file_size, stamp);
+}
+
+// Write the index next to the file, through a temporary file so readers never see a partial index
+static void WriteFileIndex(FileSystem &fs, const string &index_path, const FixSparseIndex &index) {
+	auto data = index.Serialize();
+	auto temp_path = index_path + ".tmp";
+	auto handle = fs.OpenFile(temp_path, FileOpenFlags::FILE_FLAGS_WRITE | FileOpenFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	handle->Write(&data[0], data.size());
+	handle->Sync();
+	handle.reset();
+	fs.MoveFile(temp_path, index_path);
+}
+
+static void FixBuildIndexScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<FixBuildIndexBindData>();
+	auto &gstate = data_p.global_state->Cast<FixBuildIndexGlobalState>();
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE && gstate.next_file < bind_data.files.size()) {
+		auto &file = bind_data.files[gstate.next_file++];
+		auto index = BuildFileIndex(fs, file, bind_data);
+		auto index_path = FixSparseIndex::GetIndexPath(file);
+		WriteFileIndex(fs, index_path, index);
+
+		idx_t lines = 0;
+		for (auto &block : index.blocks) {
+			lines += block.line_count;
+		}
+		output.data[0].SetValue(output_idx, Value(file));
+		output.data[1].SetValue(output_idx, Value(index_path));
+		output.data[2].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(lines)));
+		output.data[3].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(index.blocks.size())));
+		output_idx++;
+	}
+
+	output.SetCardinality(output_idx);
+}
+
+TableFunction FixBuildIndexFunction::GetFunction() {
+	TableFunction func("fix_build_index", {LogicalType(LogicalTypeId::VARCHAR)}, FixBuildIndexScan, FixBuildIndexBind,
+	                   FixBuildIndexInitGlobal);
+	func.name = "fix_build_index";
+	func.named_parameters["delimiter"] = LogicalType(LogicalTypeId::VARCHAR);
+	func.named_parameters["block_lines"] = LogicalType(LogicalTypeId::BIGINT);
+	return func;
+}
+
+} // namespace duckdb
@@ -0,0 +1,12 @@
+#pragma once
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// fix_build_index(files) - writes a sparse index sidecar (<file>.qfidx) next to each FIX log
+class FixBuildIndexFunction {
+public:
+	static TableFunction GetFunction();
+};
+
+} // namespace duckdb
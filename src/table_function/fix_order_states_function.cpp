@@ -0,0 +1,673 @@
+#include "fix_order_states_function.hpp"
+#include "read_fix_function.hpp"
+#include "dictionary/fix_dictionary_cache.hpp"
+#include "duckdb/common/enums/file_compression_type.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "parser/fix_file_reader.hpp"
+#include "parser/fix_tokenizer.hpp"
+#include "parser/fix_type_conversions.hpp"
+#include <mutex>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+
+namespace duckdb {
+
+static constexpr int FIX_ORIG_CL_ORD_ID = 41; // OrigClOrdID
+static constexpr int FIX_POSS_DUP_FLAG = 43;  // PossDupFlag
+static constexpr int FIX_ORD_STATUS = 39;     // OrdStatus, for the status names
+
+// SendingTime of a message without a valid one
+static constexpr int64_t FIX_NO_TIME = NumericLimits<int64_t>::Minimum();
+
+// Orders the messages of an order: by SendingTime, then by position in the input (range, offset)
+struct FixOrderEventKey {
+	int64_t time = FIX_NO_TIME;
+	idx_t batch = 0;
+	idx_t offset = 0;
+
+	bool operator<(const FixOrderEventKey &other) const {
+		return std::tie(time, batch, offset) < std::tie(other.time, other.batch, other.offset);
+	}
+};
+
+// A value decided by the latest message that sets it
+template <class T>
+struct FixLatest {
+	T value {};
+	FixOrderEventKey key;
+	bool set = false;
+
+	// True if a message at new_key overrides the value
+	bool Accepts(const FixOrderEventKey &new_key) const {
+		return !set || key < new_key;
+	}
+
+	void Update(T new_value, const FixOrderEventKey &new_key) {
+		if (Accepts(new_key)) {
+			value = std::move(new_value);
+			key = new_key;
+			set = true;
+		}
+	}
+
+	void Merge(const FixLatest &other) {
+		if (other.set) {
+			Update(other.value, other.key);
+		}
+	}
+};
+
+// What the messages of one ClOrdID say about its order
+// States of one order merge: those built by different threads, and those of the ClOrdIDs of a cancel/replace chain
+struct FixOrderState {
+	// ClOrdID this one replaces or cancels (OrigClOrdID)
+	string orig_cl_ord_id;
+	string order_id;
+	string symbol;
+	string side;
+	FixLatest<string> cl_ord_id;
+	FixLatest<string> ord_status;
+	FixLatest<double> order_qty;
+	FixLatest<double> price;
+	FixLatest<double> leaves_qty;
+	// Largest CumQty reported
+	double cum_qty = 0;
+	bool has_cum_qty = false;
+	// Fills: execution reports with a LastQty
+	double filled_qty = 0;
+	double filled_notional = 0;
+	idx_t fill_count = 0;
+	idx_t message_count = 0;
+	// SendingTimes (microseconds), FIX_NO_TIME until seen
+	int64_t first_time = FIX_NO_TIME;
+	int64_t last_time = FIX_NO_TIME;
+	int64_t new_time = FIX_NO_TIME;        // first NewOrderSingle
+	int64_t ack_time = FIX_NO_TIME;        // first ExecutionReport
+	int64_t first_fill_time = FIX_NO_TIME; // first fill
+
+	void Merge(const FixOrderState &other);
+};
+
+static void MergeFirstTime(int64_t &time, int64_t other) {
+	if (other != FIX_NO_TIME && (time == FIX_NO_TIME || other < time)) {
+		time = other;
+	}
+}
+
+static void MergeLastTime(int64_t &time, int64_t other) {
+	if (other != FIX_NO_TIME && (time == FIX_NO_TIME || other > time)) {
+		time = other;
+	}
+}
+
+static void MergeFirstString(string &value, const string &other) {
+	if (value.empty()) {
+		value = other;
+	}
+}
+
+static void MergeCumQty(FixOrderState &state, double cum_qty) {
+	if (!state.has_cum_qty || cum_qty > state.cum_qty) {
+		state.cum_qty = cum_qty;
+		state.has_cum_qty = true;
+	}
+}
+
+void FixOrderState::Merge(const FixOrderState &other) {
+	MergeFirstString(orig_cl_ord_id, other.orig_cl_ord_id);
+	MergeFirstString(order_id, other.order_id);
+	MergeFirstString(symbol, other.symbol);
+	MergeFirstString(side, other.side);
+	cl_ord_id.Merge(other.cl_ord_id);
+	ord_status.Merge(other.ord_status);
+	order_qty.Merge(other.order_qty);
+	price.Merge(other.price);
+	leaves_qty.Merge(other.leaves_qty);
+	if (other.has_cum_qty) {
+		MergeCumQty(*this, other.cum_qty);
+	}
+	filled_qty += other.filled_qty;
+	filled_notional += other.filled_notional;
+	fill_count += other.fill_count;
+	message_count += other.message_count;
+	MergeFirstTime(first_time, other.first_time);
+	MergeLastTime(last_time, other.last_time);
+	MergeFirstTime(new_time, other.new_time);
+	MergeFirstTime(ack_time, other.ack_time);
+	MergeFirstTime(first_fill_time, other.first_fill_time);
+}
+
+typedef unordered_map<string, FixOrderState> FixOrderStateMap;
+
+// One output row: an order named after the first ClOrdID of its chain (empty if only its OrderID is known)
+struct FixOrderRow {
+	string cl_ord_id;
+	FixOrderState state;
+};
+
+struct FixOrderStatesBindData : public TableFunctionData {
+	vector<string> files;
+	idx_t range_size = DEFAULT_FIX_RANGE_SIZE;
+	FileCompressionType compression = FileCompressionType::AUTO_DETECT;
+	// Hot tags plus OrigClOrdID and PossDupFlag
+	FixTagLayout tag_layout;
+	uint16_t orig_cl_ord_id_slot = FixTagLayout::NO_SLOT;
+	uint16_t poss_dup_slot = FixTagLayout::NO_SLOT;
+	FixParseOptions parse_options;
+	// Dictionary description of each OrdStatus value
+	unordered_map<string, string> ord_status_names;
+};
+
+struct FixOrderStatesLocalState : public LocalTableFunctionState {
+	FixFileReader file_reader;
+	ParsedFixMessage parsed;
+	// Order states by ClOrdID, and by OrderID for messages without a ClOrdID
+	FixOrderStateMap by_cl_ord_id;
+	FixOrderStateMap by_order_id;
+	idx_t ranges_read = 0;
+	bool scanned = false;
+	// This thread merged last and emits the orders
+	bool emits = false;
+
+	explicit FixOrderStatesLocalState(const FixOrderStatesBindData &bind_data) : parsed(bind_data.tag_layout) {
+	}
+};
+
+struct FixOrderStatesGlobalState : public GlobalTableFunctionState {
+	FixRangeScheduler scheduler;
+
+	std::mutex lock;
+	FixOrderStateMap by_cl_ord_id;
+	FixOrderStateMap by_order_id;
+	idx_t merged_ranges = 0;
+	bool finalized = false;
+	// Built and emitted by the thread that merged last
+	vector<FixOrderRow> rows;
+	idx_t next_row = 0;
+
+	explicit FixOrderStatesGlobalState(const FixOrderStatesBindData &bind_data)
+	    : scheduler(bind_data.files, bind_data.range_size, bind_data.compression) {
+	}
+
+	idx_t MaxThreads() const override {
+		// Ranges are handed out on demand, threads that find no work finish immediately
+		return GlobalTableFunctionState::MAX_THREADS;
+	}
+
+	// Merge the states of a thread that found no more ranges
+	// Returns true for the thread whose merge completes the scan, it then emits the orders
+	bool Merge(FixOrderStatesLocalState &local);
+};
+
+static void MergeStates(FixOrderStateMap &target, FixOrderStateMap &source) {
+	for (auto &entry : source) {
+		auto existing = target.find(entry.first);
+		if (existing == target.end()) {
+			target.emplace(entry.first, std::move(entry.second));
+		} else {
+			existing->second.Merge(entry.second);
+		}
+	}
+	source.clear();
+}
+
+// Group the ClOrdIDs of each cancel/replace chain (linked by OrigClOrdID) into one order
+static vector<FixOrderRow> BuildOrders(FixOrderStateMap &by_cl_ord_id, FixOrderStateMap &by_order_id) {
+	// The first ClOrdID of a chain may predate the log, it still names the order
+	vector<string> missing;
+	for (auto &entry : by_cl_ord_id) {
+		auto &orig = entry.second.orig_cl_ord_id;
+		if (!orig.empty() && by_cl_ord_id.find(orig) == by_cl_ord_id.end()) {
+			missing.push_back(orig);
+		}
+	}
+	for (auto &cl_ord_id : missing) {
+		by_cl_ord_id.emplace(cl_ord_id, FixOrderState());
+	}
+
+	vector<pair<const string *, const FixOrderState *>> members;
+	unordered_map<string, idx_t> ids;
+	for (auto &entry : by_cl_ord_id) {
+		ids.emplace(entry.first, members.size());
+		members.emplace_back(&entry.first, &entry.second);
+	}
+
+	// Union-find over the chain links
+	vector<idx_t> parents(members.size());
+	std::iota(parents.begin(), parents.end(), idx_t(0));
+	auto find = [&](idx_t id) {
+		while (parents[id] != id) {
+			parents[id] = parents[parents[id]];
+			id = parents[id];
+		}
+		return id;
+	};
+	for (idx_t i = 0; i < members.size(); i++) {
+		auto &orig = members[i].second->orig_cl_ord_id;
+		if (!orig.empty()) {
+			auto root = find(i);
+			auto orig_root = find(ids[orig]);
+			if (root != orig_root) {
+				parents[root] = orig_root;
+			}
+		}
+	}
+
+	// A chain is named after its ClOrdID without OrigClOrdID, the earliest one if there are several
+	auto names_order = [&](idx_t candidate, idx_t current) {
+		auto &a = *members[candidate].second;
+		auto &b = *members[current].second;
+		if (a.orig_cl_ord_id.empty() != b.orig_cl_ord_id.empty()) {
+			return a.orig_cl_ord_id.empty();
+		}
+		return a.first_time < b.first_time;
+	};
+	vector<FixOrderRow> rows;
+	vector<idx_t> row_of_root(members.size(), DConstants::INVALID_INDEX);
+	vector<idx_t> names;
+	for (idx_t i = 0; i < members.size(); i++) {
+		auto root = find(i);
+		if (row_of_root[root] == DConstants::INVALID_INDEX) {
+			row_of_root[root] = rows.size();
+			rows.emplace_back();
+			names.push_back(i);
+		}
+		auto row = row_of_root[root];
+		rows[row].state.Merge(*members[i].second);
+		if (names_order(i, names[row])) {
+			names[row] = i;
+		}
+	}
+	for (idx_t row = 0; row < rows.size(); row++) {
+		rows[row].cl_ord_id = *members[names[row]].first;
+	}
+
+	// Messages without a ClOrdID join the order with their OrderID
+	unordered_map<string, idx_t> row_of_order_id;
+	for (idx_t row = 0; row < rows.size(); row++) {
+		if (!rows[row].state.order_id.empty()) {
+			row_of_order_id.emplace(rows[row].state.order_id, row);
+		}
+	}
+	for (auto &entry : by_order_id) {
+		auto row = row_of_order_id.find(entry.first);
+		if (row != row_of_order_id.end()) {
+			rows[row->second].state.Merge(entry.second);
+		} else {
+			row_of_order_id.emplace(entry.first, rows.size());
+			rows.emplace_back();
+			rows.back().state = std::move(entry.second);
+		}
+	}
+	by_cl_ord_id.clear();
+	by_order_id.clear();
+	return rows;
+}
+
+bool FixOrderStatesGlobalState::Merge(FixOrderStatesLocalState &local) {
+	std::lock_guard<std::mutex> guard(lock);
+	MergeStates(by_cl_ord_id, local.by_cl_ord_id);
+	MergeStates(by_order_id, local.by_order_id);
+	merged_ranges += local.ranges_read;
+	// Every thread that merges has found the scheduler empty, so all ranges have been handed out
+	if (finalized || merged_ranges < scheduler.GetRangeCount()) {
+		return false;
+	}
+	finalized = true;
+	rows = BuildOrders(by_cl_ord_id, by_order_id);
+	return true;
+}
+
+static unique_ptr<FunctionData> FixOrderStatesBind(ClientContext &context, TableFunctionBindInput &input,
+                                                   vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<FixOrderStatesBindData>();
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto file_list = fs.GlobFiles(StringValue::Get(input.inputs[0]), context, FileGlobOptions::DISALLOW_EMPTY);
+	for (auto &file_info : file_list) {
+		result->files.push_back(file_info.path);
+	}
+
+	auto &options = result->parse_options;
+	options.delimiter = '|';
+	if (input.named_parameters.find("delimiter") != input.named_parameters.end()) {
+		options.delimiter = ReadFixFunction::ParseDelimiter(StringValue::Get(input.named_parameters.at("delimiter")));
+	}
+	if (input.named_parameters.find("range_size") != input.named_parameters.end()) {
+		result->range_size = ReadFixFunction::ParseByteSize("range_size", input.named_parameters.at("range_size"));
+	}
+	if (input.named_parameters.find("compression") != input.named_parameters.end()) {
+		result->compression = FileCompressionTypeFromString(StringValue::Get(input.named_parameters.at("compression")));
+	}
+
+	// Status names come from the dictionary, the embedded FIX 4.4 one by default
+	shared_ptr<const FixDictionary> dictionary;
+	std::shared_ptr<const FixGroupLayout> group_layout;
+	try {
+		string dict_path;
+		if (input.named_parameters.find("dictionary") != input.named_parameters.end()) {
+			dict_path = StringValue::Get(input.named_parameters.at("dictionary"));
+		}
+		dictionary = FixDictionaryCache::Get(context, dict_path, group_layout);
+	} catch (const std::exception &e) {
+		throw BinderException("Failed to load FIX dictionary: %s", e.what());
+	}
+	auto ord_status = dictionary->fields.find(FIX_ORD_STATUS);
+	if (ord_status != dictionary->fields.end()) {
+		for (auto &value : ord_status->second.enums) {
+			result->ord_status_names[value.enum_value] = value.description;
+		}
+	}
+
+	// Only the tags the order state is built from are tokenized
+	result->orig_cl_ord_id_slot = result->tag_layout.AddTag(FIX_ORIG_CL_ORD_ID);
+	result->poss_dup_slot = result->tag_layout.AddTag(FIX_POSS_DUP_FLAG);
+	options.keep_tag_list = false;
+	for (auto tag : {FixHotTags::MSG_TYPE, FixHotTags::SENDING_TIME, FixHotTags::CL_ORD_ID, FixHotTags::ORDER_ID,
+	                 FixHotTags::SYMBOL, FixHotTags::SIDE, FixHotTags::ORD_STATUS, FixHotTags::PRICE,
+	                 FixHotTags::ORDER_QTY, FixHotTags::CUM_QTY, FixHotTags::LEAVES_QTY, FixHotTags::LAST_PX,
+	                 FixHotTags::LAST_QTY}) {
+		options.RequireSlot(static_cast<uint16_t>(FixHotTags::HotSlot(tag)));
+	}
+	options.RequireSlot(result->orig_cl_ord_id_slot);
+	options.RequireSlot(result->poss_dup_slot);
+	// Tags that a message's repeating groups may repeat keep their last occurrence
+	options.SetGroupLayout(std::move(group_layout), result->tag_layout);
+
+	names.emplace_back("ClOrdID");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("current_cl_ord_id");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("OrderID");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("Symbol");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("Side");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("OrdStatus");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("status");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("OrderQty");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE));
+
+	names.emplace_back("Price");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE));
+
+	names.emplace_back("CumQty");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE));
+
+	names.emplace_back("LeavesQty");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE));
+
+	names.emplace_back("filled_qty");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE));
+
+	names.emplace_back("avg_px");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE));
+
+	names.emplace_back("fill_count");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	names.emplace_back("message_count");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	names.emplace_back("first_time");
+	return_types.emplace_back(LogicalType(LogicalTypeId::TIMESTAMP));
+
+	names.emplace_back("last_time");
+	return_types.emplace_back(LogicalType(LogicalTypeId::TIMESTAMP));
+
+	names.emplace_back("ack_latency");
+	return_types.emplace_back(LogicalType(LogicalTypeId::INTERVAL));
+
+	names.emplace_back("fill_latency");
+	return_types.emplace_back(LogicalType(LogicalTypeId::INTERVAL));
+
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> FixOrderStatesInitGlobal(ClientContext &context,
+                                                                     TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<FixOrderStatesBindData>();
+	return make_uniq<FixOrderStatesGlobalState>(bind_data);
+}
+
+static unique_ptr<LocalTableFunctionState> FixOrderStatesInitLocal(ExecutionContext &context,
+                                                                   TableFunctionInitInput &input,
+                                                                   GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<FixOrderStatesBindData>();
+	return make_uniq<FixOrderStatesLocalState>(bind_data);
+}
+
+// NewOrderSingle, OrderCancelRequest, OrderCancelReplaceRequest, ExecutionReport, OrderCancelReject
+static bool IsOrderMessage(char msg_type) {
+	return msg_type == 'D' || msg_type == 'F' || msg_type == 'G' || msg_type == '8' || msg_type == '9';
+}
+
+static void SetFirstString(string &target, const ParsedFixMessage::TagValue &value) {
+	if (target.empty() && value.len > 0) {
+		target.assign(value.data, value.len);
+	}
+}
+
+// Fold one order message into the state of its ClOrdID
+static void AddOrderMessage(FixOrderState &state, const ParsedFixMessage &msg, char msg_type,
+                            const FixOrderEventKey &key, const FixOrderStatesBindData &bind_data) {
+	state.message_count++;
+	MergeFirstTime(state.first_time, key.time);
+	MergeLastTime(state.last_time, key.time);
+
+	auto &cl_ord_id = msg.Hot<FixHotTags::CL_ORD_ID>();
+	if (cl_ord_id.len > 0 && state.cl_ord_id.Accepts(key)) {
+		state.cl_ord_id.Update(string(cl_ord_id.data, cl_ord_id.len), key);
+	}
+	SetFirstString(state.orig_cl_ord_id, msg.GetSlot(bind_data.orig_cl_ord_id_slot));
+	SetFirstString(state.order_id, msg.Hot<FixHotTags::ORDER_ID>());
+	SetFirstString(state.symbol, msg.Hot<FixHotTags::SYMBOL>());
+	SetFirstString(state.side, msg.Hot<FixHotTags::SIDE>());
+
+	double value;
+	auto &order_qty = msg.Hot<FixHotTags::ORDER_QTY>();
+	if (ConvertToDouble(order_qty.data, order_qty.len, value, nullptr, "OrderQty")) {
+		state.order_qty.Update(value, key);
+	}
+	auto &price = msg.Hot<FixHotTags::PRICE>();
+	if (ConvertToDouble(price.data, price.len, value, nullptr, "Price")) {
+		state.price.Update(value, key);
+	}
+
+	if (msg_type == 'D') {
+		MergeFirstTime(state.new_time, key.time);
+		return;
+	}
+	if (msg_type != '8' && msg_type != '9') {
+		return;
+	}
+	// Execution reports and cancel rejects report the order's status
+	auto &ord_status = msg.Hot<FixHotTags::ORD_STATUS>();
+	if (ord_status.len > 0 && state.ord_status.Accepts(key)) {
+		state.ord_status.Update(string(ord_status.data, ord_status.len), key);
+	}
+	if (msg_type == '9') {
+		return;
+	}
+	MergeFirstTime(state.ack_time, key.time);
+	auto &cum_qty = msg.Hot<FixHotTags::CUM_QTY>();
+	if (ConvertToDouble(cum_qty.data, cum_qty.len, value, nullptr, "CumQty")) {
+		MergeCumQty(state, value);
+	}
+	auto &leaves_qty = msg.Hot<FixHotTags::LEAVES_QTY>();
+	if (ConvertToDouble(leaves_qty.data, leaves_qty.len, value, nullptr, "LeavesQty")) {
+		state.leaves_qty.Update(value, key);
+	}
+	double last_qty;
+	auto &last_qty_value = msg.Hot<FixHotTags::LAST_QTY>();
+	if (ConvertToDouble(last_qty_value.data, last_qty_value.len, last_qty, nullptr, "LastQty") && last_qty > 0) {
+		double last_px = 0;
+		auto &last_px_value = msg.Hot<FixHotTags::LAST_PX>();
+		ConvertToDouble(last_px_value.data, last_px_value.len, last_px, nullptr, "LastPx");
+		state.filled_qty += last_qty;
+		state.filled_notional += last_qty * last_px;
+		state.fill_count++;
+		MergeFirstTime(state.first_fill_time, key.time);
+	}
+}
+
+// Read every range this thread gets into its order states
+static void ScanOrderMessages(ClientContext &context, const FixOrderStatesBindData &bind_data,
+                              FixOrderStatesGlobalState &gstate, FixOrderStatesLocalState &lstate) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto &reader = lstate.file_reader;
+	auto &parsed = lstate.parsed;
+	const char *line;
+	idx_t line_len;
+	while (reader.OpenNextRange(fs, gstate.scheduler)) {
+		while (reader.ReadLine(line, line_len)) {
+			if (line_len == 0) {
+				continue;
+			}
+			FixTokenizer::Parse(line, line_len, parsed, bind_data.parse_options);
+			auto &msg_type = parsed.Hot<FixHotTags::MSG_TYPE>();
+			if (msg_type.len != 1 || !IsOrderMessage(msg_type.data[0])) {
+				continue;
+			}
+			// Resent messages repeat what the originals said
+			auto &poss_dup = parsed.GetSlot(bind_data.poss_dup_slot);
+			if (poss_dup.len == 1 && poss_dup.data[0] == 'Y') {
+				continue;
+			}
+
+			FixOrderEventKey key;
+			timestamp_t sending_time;
+			auto &sending_time_value = parsed.Hot<FixHotTags::SENDING_TIME>();
+			if (ConvertToTimestamp(sending_time_value.data, sending_time_value.len, sending_time, nullptr,
+			                       "SendingTime")) {
+				key.time = sending_time.value;
+			}
+			key.batch = reader.GetBatchIndex();
+			key.offset = reader.GetLineOffset();
+
+			FixOrderState *state;
+			auto &cl_ord_id = parsed.Hot<FixHotTags::CL_ORD_ID>();
+			auto &order_id = parsed.Hot<FixHotTags::ORDER_ID>();
+			if (cl_ord_id.len > 0) {
+				state = &lstate.by_cl_ord_id[string(cl_ord_id.data, cl_ord_id.len)];
+			} else if (order_id.len > 0) {
+				state = &lstate.by_order_id[string(order_id.data, order_id.len)];
+			} else {
+				continue;
+			}
+			AddOrderMessage(*state, parsed, msg_type.data[0], key, bind_data);
+		}
+		reader.Close();
+		lstate.ranges_read++;
+	}
+}
+
+static void SetLatestDouble(Vector &column, idx_t row, const FixLatest<double> &value) {
+	if (value.set) {
+		SetFlatField(column, row, value.value);
+	} else {
+		SetNullField(column, row);
+	}
+}
+
+static void SetTime(Vector &column, idx_t row, int64_t time) {
+	if (time != FIX_NO_TIME) {
+		SetFlatField(column, row, timestamp_t(time));
+	} else {
+		SetNullField(column, row);
+	}
+}
+
+static void SetLatency(Vector &column, idx_t row, int64_t start, int64_t end) {
+	if (start != FIX_NO_TIME && end != FIX_NO_TIME) {
+		SetFlatField(column, row, Interval::FromMicro(end - start));
+	} else {
+		SetNullField(column, row);
+	}
+}
+
+static void WriteOrderRow(DataChunk &output, idx_t row, const FixOrderRow &order,
+                          const FixOrderStatesBindData &bind_data) {
+	auto &state = order.state;
+	SetStringField(output.data[0], row, order.cl_ord_id.data(), order.cl_ord_id.size());
+	SetStringField(output.data[1], row, state.cl_ord_id.value.data(), state.cl_ord_id.value.size());
+	SetStringField(output.data[2], row, state.order_id.data(), state.order_id.size());
+	SetStringField(output.data[3], row, state.symbol.data(), state.symbol.size());
+	SetStringField(output.data[4], row, state.side.data(), state.side.size());
+	SetStringField(output.data[5], row, state.ord_status.value.data(), state.ord_status.value.size());
+	auto status_name = bind_data.ord_status_names.find(state.ord_status.value);
+	if (status_name != bind_data.ord_status_names.end()) {
+		SetStringField(output.data[6], row, status_name->second.data(), status_name->second.size());
+	} else {
+		SetNullField(output.data[6], row);
+	}
+	SetLatestDouble(output.data[7], row, state.order_qty);
+	SetLatestDouble(output.data[8], row, state.price);
+	if (state.has_cum_qty) {
+		SetFlatField(output.data[9], row, state.cum_qty);
+	} else {
+		SetNullField(output.data[9], row);
+	}
+	SetLatestDouble(output.data[10], row, state.leaves_qty);
+	SetFlatField(output.data[11], row, state.filled_qty);
+	if (state.filled_qty > 0) {
+		SetFlatField(output.data[12], row, state.filled_notional / state.filled_qty);
+	} else {
+		SetNullField(output.data[12], row);
+	}
+	SetFlatField(output.data[13], row, static_cast<int64_t>(state.fill_count));
+	SetFlatField(output.data[14], row, static_cast<int64_t>(state.message_count));
+	SetTime(output.data[15], row, state.first_time);
+	SetTime(output.data[16], row, state.last_time);
+	SetLatency(output.data[17], row, state.new_time, state.ack_time);
+	SetLatency(output.data[18], row, state.new_time, state.first_fill_time);
+}
+
+static void FixOrderStatesScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<FixOrderStatesBindData>();
+	auto &gstate = data_p.global_state->Cast<FixOrderStatesGlobalState>();
+	auto &lstate = data_p.local_state->Cast<FixOrderStatesLocalState>();
+
+	if (!lstate.scanned) {
+		ScanOrderMessages(context, bind_data, gstate, lstate);
+		lstate.scanned = true;
+		lstate.emits = gstate.Merge(lstate);
+	}
+	if (!lstate.emits) {
+		return;
+	}
+
+	// Only the emitting thread reads the rows once they are built
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE && gstate.next_row < gstate.rows.size()) {
+		WriteOrderRow(output, output_idx, gstate.rows[gstate.next_row++], bind_data);
+		output_idx++;
+	}
+	output.SetCardinality(output_idx);
+}
+
+TableFunction FixOrderStatesFunction::GetFunction() {
+	TableFunction func("fix_order_states", {LogicalType(LogicalTypeId::VARCHAR)}, FixOrderStatesScan,
+	                   FixOrderStatesBind, FixOrderStatesInitGlobal, FixOrderStatesInitLocal);
+	func.name = "fix_order_states";
+	func.named_parameters["delimiter"] = LogicalType(LogicalTypeId::VARCHAR);
+	func.named_parameters["dictionary"] = LogicalType(LogicalTypeId::VARCHAR);
+	func.named_parameters["range_size"] = LogicalType(LogicalTypeId::VARCHAR);
+	func.named_parameters["compression"] = LogicalType(LogicalTypeId::VARCHAR);
+	return func;
+}
+
+} // namespace duckdb
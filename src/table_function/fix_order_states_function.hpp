@@ -0,0 +1,13 @@
+#pragma once
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// fix_order_states(files) - one row per order with its final state, folded from the order messages of FIX logs
+// (NewOrderSingle, OrderCancelReplaceRequest, OrderCancelRequest, ExecutionReport, OrderCancelReject) in one pass
+class FixOrderStatesFunction {
+public:
+	static TableFunction GetFunction();
+};
+
+} // namespace duckdb
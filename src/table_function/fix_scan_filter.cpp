@@ -0,0 +1,463 @@
+#include "fix_scan_filter.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "parser/fix_type_conversions.hpp"
+#include <cstring>
+
+namespace duckdb {
+
+void FixScanFilter::Initialize(const TableFilterSet &filters, const vector<FixFilterColumn> &columns,
+                               const vector<LogicalType> &types, char delimiter) {
+	vector<unique_ptr<Expression>> residuals;
+	for (auto &entry : filters.filters) {
+		auto column_pos = entry.first;
+		auto &filter = *entry.second;
+		if (column_pos >= columns.size() || column_pos >= types.size()) {
+			throw InternalException("read_fix: filter on unknown column %llu", column_pos);
+		}
+		// Optional filters are hints that may be skipped, the plan evaluates them anyway
+		if (filter.filter_type == TableFilterType::OPTIONAL_FILTER) {
+			continue;
+		}
+
+		auto &column = columns[column_pos];
+		vector<Condition> compiled;
+		if (column.slot != FixTagLayout::NO_SLOT && Compile(filter, column, compiled)) {
+			for (auto &condition : compiled) {
+				// Equality on a VARCHAR tag: the line must contain "<d>tag=value<d>" for one of the constants,
+				// or for tag 8 (BeginString) start the message with "8=value<d>"
+				if (condition.IsEquality() && condition.value_type == FixFilterValueType::VARCHAR) {
+					RawPattern pattern;
+					pattern.first_field = column.tag == 8;
+					for (auto &constant : condition.strings) {
+						pattern.needles.push_back(string(1, delimiter) + std::to_string(column.tag) + "=" + constant +
+						                          string(1, delimiter));
+					}
+					patterns_.push_back(std::move(pattern));
+				}
+				conditions_.push_back(std::move(condition));
+			}
+			continue;
+		}
+
+		BoundReferenceExpression column_ref(types[column_pos], column_pos);
+		residuals.push_back(filter.ToExpression(column_ref));
+	}
+
+	if (residuals.size() == 1) {
+		residual_ = std::move(residuals[0]);
+	} else if (residuals.size() > 1) {
+		auto conjunction = make_uniq<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_AND);
+		conjunction->children = std::move(residuals);
+		residual_ = std::move(conjunction);
+	}
+}
+
+bool FixScanFilter::Compile(const TableFilter &filter, const FixFilterColumn &column, vector<Condition> &result) {
+	Condition condition;
+	condition.comparison = ExpressionType::INVALID;
+	condition.slot = column.slot;
+	condition.value_type = column.type;
+
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = filter.Cast<ConstantFilter>();
+		switch (constant_filter.comparison_type) {
+		case ExpressionType::COMPARE_EQUAL:
+		case ExpressionType::COMPARE_NOTEQUAL:
+		case ExpressionType::COMPARE_LESSTHAN:
+		case ExpressionType::COMPARE_GREATERTHAN:
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			break;
+		default:
+			return false;
+		}
+		condition.type = ConditionType::COMPARE;
+		condition.comparison = constant_filter.comparison_type;
+		if (!AddConstant(condition, constant_filter.constant)) {
+			return false;
+		}
+		break;
+	}
+	case TableFilterType::IN_FILTER: {
+		auto &in_filter = filter.Cast<InFilter>();
+		condition.type = ConditionType::IN;
+		for (auto &constant : in_filter.values) {
+			if (!AddConstant(condition, constant)) {
+				return false;
+			}
+		}
+		break;
+	}
+	case TableFilterType::IS_NULL:
+		condition.type = ConditionType::IS_NULL;
+		break;
+	case TableFilterType::IS_NOT_NULL:
+		condition.type = ConditionType::IS_NOT_NULL;
+		break;
+	case TableFilterType::CONJUNCTION_AND: {
+		// All children must compile, otherwise the whole conjunction is left to the residual
+		auto &conjunction = filter.Cast<ConjunctionAndFilter>();
+		for (auto &child : conjunction.child_filters) {
+			if (child->filter_type == TableFilterType::OPTIONAL_FILTER) {
+				continue;
+			}
+			if (!Compile(*child, column, result)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+
+	result.push_back(std::move(condition));
+	return true;
+}
+
+bool FixScanFilter::AddConstant(Condition &condition, const Value &constant) {
+	if (constant.IsNull()) {
+		return false;
+	}
+	auto type_id = constant.type().id();
+	switch (condition.value_type) {
+	case FixFilterValueType::VARCHAR:
+		if (type_id != LogicalTypeId::VARCHAR) {
+			return false;
+		}
+		condition.strings.push_back(StringValue::Get(constant));
+		return true;
+	case FixFilterValueType::BIGINT:
+		if (type_id != LogicalTypeId::BIGINT) {
+			return false;
+		}
+		condition.ints.push_back(constant.GetValue<int64_t>());
+		return true;
+	case FixFilterValueType::DOUBLE:
+		if (type_id != LogicalTypeId::DOUBLE) {
+			return false;
+		}
+		condition.doubles.push_back(constant.GetValue<double>());
+		return true;
+	case FixFilterValueType::TIMESTAMP:
+		if (type_id != LogicalTypeId::TIMESTAMP) {
+			return false;
+		}
+		condition.timestamps.push_back(constant.GetValue<timestamp_t>());
+		return true;
+	case FixFilterValueType::BOOLEAN:
+		if (type_id != LogicalTypeId::BOOLEAN) {
+			return false;
+		}
+		condition.ints.push_back(constant.GetValue<bool>() ? 1 : 0);
+		return true;
+	default:
+		return false;
+	}
+}
+
+// The last field of a line may have no trailing delimiter
+static bool ContainsField(const char *line, size_t len, const string &needle) {
+	auto needle_len = needle.size();
+	if (len + 1 >= needle_len && memcmp(line + len + 1 - needle_len, needle.data(), needle_len - 1) == 0) {
+		return true;
+	}
+	if (len < needle_len) {
+		return false;
+	}
+	const char *pos = line;
+	const char *last = line + len - needle_len;
+	while (pos <= last) {
+		pos = static_cast<const char *>(memchr(pos, needle[0], static_cast<size_t>(last - pos) + 1));
+		if (!pos) {
+			return false;
+		}
+		if (memcmp(pos, needle.data(), needle_len) == 0) {
+			return true;
+		}
+		pos++;
+	}
+	return false;
+}
+
+// Start of the FIX message in a line: the first "8=", like in the tokenizer (a prefix may come before it)
+static const char *FindMessageStart(const char *line, size_t len) {
+	for (size_t i = 0; i + 1 < len; i++) {
+		if (line[i] == '8' && line[i + 1] == '=') {
+			return line + i;
+		}
+	}
+	return nullptr;
+}
+
+// The needle without its leading delimiter at the start of the message, which may also end right after the value
+static bool StartsWithField(const char *start, size_t len, const string &needle) {
+	auto field_len = needle.size() - 1;
+	if (len >= field_len) {
+		return memcmp(start, needle.data() + 1, field_len) == 0;
+	}
+	return len + 1 == field_len && memcmp(start, needle.data() + 1, len) == 0;
+}
+
+// Whether a field of the line has a tag with leading zeros (e.g. "035=D"): the tokenizer reads it as the tag
+// without them, which the needles do not match
+static bool HasZeroPaddedTag(const char *line, size_t len, char delimiter) {
+	const char *pos = line;
+	const char *last = line + len;
+	while (pos + 2 < last) {
+		pos = static_cast<const char *>(memchr(pos, delimiter, static_cast<size_t>(last - pos) - 2));
+		if (!pos) {
+			return false;
+		}
+		if (pos[1] == '0' && pos[2] >= '0' && pos[2] <= '9') {
+			return true;
+		}
+		pos++;
+	}
+	return false;
+}
+
+bool FixScanFilter::MayMatch(const char *line, size_t len) const {
+	for (auto &pattern : patterns_) {
+		bool found = false;
+		for (auto &needle : pattern.needles) {
+			if (ContainsField(line, len, needle)) {
+				found = true;
+				break;
+			}
+		}
+		if (!found && pattern.first_field) {
+			auto start = FindMessageStart(line, len);
+			auto remaining = start ? len - static_cast<size_t>(start - line) : 0;
+			for (auto &needle : pattern.needles) {
+				if (start && StartsWithField(start, remaining, needle)) {
+					found = true;
+					break;
+				}
+			}
+		}
+		if (!found) {
+			// Rare in practice, such lines are left to the checks on the tokenized message
+			return !pattern.needles.empty() && HasZeroPaddedTag(line, len, pattern.needles[0][0]);
+		}
+	}
+	return true;
+}
+
+template <class T>
+static bool CompareValues(ExpressionType comparison, const T &left, const T &right) {
+	switch (comparison) {
+	case ExpressionType::COMPARE_EQUAL:
+		return Equals::Operation(left, right);
+	case ExpressionType::COMPARE_NOTEQUAL:
+		return NotEquals::Operation(left, right);
+	case ExpressionType::COMPARE_LESSTHAN:
+		return LessThan::Operation(left, right);
+	case ExpressionType::COMPARE_GREATERTHAN:
+		return GreaterThan::Operation(left, right);
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		return LessThanEquals::Operation(left, right);
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return GreaterThanEquals::Operation(left, right);
+	default:
+		throw InternalException("read_fix: unsupported comparison in compiled filter");
+	}
+}
+
+// A comparison has one constant, an IN list matches if any constant is equal
+template <class T>
+static bool MatchConstants(bool is_in, ExpressionType comparison, const T &value, const vector<T> &constants) {
+	if (is_in) {
+		for (auto &constant : constants) {
+			if (Equals::Operation(value, constant)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	return CompareValues(comparison, value, constants[0]);
+}
+
+bool FixScanFilter::Evaluate(const Condition &condition, const ParsedFixMessage::TagValue &value) {
+	// Convert the value exactly as the column writer does, so the filter sees the column's value
+	bool valid;
+	int64_t int_value = 0;
+	double double_value = 0;
+	timestamp_t timestamp_value;
+	bool boolean_value = false;
+	switch (condition.value_type) {
+	case FixFilterValueType::VARCHAR:
+		valid = value.data != nullptr && value.len > 0;
+		break;
+	case FixFilterValueType::BIGINT:
+		valid = ConvertToInt64(value.data, value.len, int_value, nullptr, nullptr);
+		break;
+	case FixFilterValueType::DOUBLE:
+		valid = ConvertToDouble(value.data, value.len, double_value, nullptr, nullptr);
+		break;
+	case FixFilterValueType::TIMESTAMP:
+		valid = ConvertToTimestamp(value.data, value.len, timestamp_value, nullptr, nullptr);
+		break;
+	case FixFilterValueType::BOOLEAN:
+		valid = ConvertToBoolean(value.data, value.len, boolean_value, nullptr, nullptr);
+		int_value = boolean_value ? 1 : 0;
+		break;
+	default:
+		throw InternalException("read_fix: unsupported value type in compiled filter");
+	}
+
+	if (condition.type == ConditionType::IS_NULL) {
+		return !valid;
+	}
+	if (condition.type == ConditionType::IS_NOT_NULL) {
+		return valid;
+	}
+	// A comparison with NULL is never true
+	if (!valid) {
+		return false;
+	}
+
+	bool is_in = condition.type == ConditionType::IN;
+	switch (condition.value_type) {
+	case FixFilterValueType::VARCHAR: {
+		string_t string_value(value.data, static_cast<uint32_t>(value.len));
+		if (is_in) {
+			for (auto &constant : condition.strings) {
+				string_t constant_value(constant.data(), static_cast<uint32_t>(constant.size()));
+				if (Equals::Operation(string_value, constant_value)) {
+					return true;
+				}
+			}
+			return false;
+		}
+		auto &constant = condition.strings[0];
+		return CompareValues(condition.comparison, string_value,
+		                     string_t(constant.data(), static_cast<uint32_t>(constant.size())));
+	}
+	case FixFilterValueType::BIGINT:
+	case FixFilterValueType::BOOLEAN:
+		return MatchConstants(is_in, condition.comparison, int_value, condition.ints);
+	case FixFilterValueType::DOUBLE:
+		return MatchConstants(is_in, condition.comparison, double_value, condition.doubles);
+	default:
+		return MatchConstants(is_in, condition.comparison, timestamp_value, condition.timestamps);
+	}
+}
+
+bool FixScanFilter::Matches(const ParsedFixMessage &parsed) const {
+	for (auto &condition : conditions_) {
+		if (!Evaluate(condition, parsed.GetSlot(condition.slot))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static int64_t ZoneValue(int64_t value) {
+	return value;
+}
+
+static int64_t ZoneValue(timestamp_t value) {
+	return value.value;
+}
+
+// Can a block whose non-NULL values lie in zone contain a value passing the condition
+template <class T>
+static bool ZoneMayMatch(bool is_in, ExpressionType comparison, const FixIndexZone &zone, const vector<T> &constants) {
+	if (is_in) {
+		for (auto &constant : constants) {
+			auto value = ZoneValue(constant);
+			if (zone.min <= value && value <= zone.max) {
+				return true;
+			}
+		}
+		return false;
+	}
+	auto value = ZoneValue(constants[0]);
+	switch (comparison) {
+	case ExpressionType::COMPARE_EQUAL:
+		return zone.min <= value && value <= zone.max;
+	case ExpressionType::COMPARE_NOTEQUAL:
+		return zone.min != value || zone.max != value;
+	case ExpressionType::COMPARE_LESSTHAN:
+		return zone.min < value;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		return zone.max > value;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		return zone.min <= value;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return zone.max >= value;
+	default:
+		return true;
+	}
+}
+
+bool FixScanFilter::MayMatchBlock(const FixSparseIndex &index, idx_t block_idx) const {
+	static constexpr auto MSG_SEQ_NUM_SLOT = FixHotTags::HotSlot(FixHotTags::MSG_SEQ_NUM);
+	static constexpr auto SENDING_TIME_SLOT = FixHotTags::HotSlot(FixHotTags::SENDING_TIME);
+	// The value set columns are the first hot tag slots, in FixSparseIndex::SetColumn order
+	static_assert(FixHotTags::HotSlot(FixHotTags::MSG_TYPE) == FixSparseIndex::MSG_TYPE &&
+	                  FixHotTags::HotSlot(FixHotTags::SENDER_COMP_ID) == FixSparseIndex::SENDER_COMP_ID &&
+	                  FixHotTags::HotSlot(FixHotTags::TARGET_COMP_ID) == FixSparseIndex::TARGET_COMP_ID,
+	              "index value sets must follow the hot tag order");
+
+	auto &block = index.blocks[block_idx];
+	for (auto &condition : conditions_) {
+		// The index has no NULL counts
+		if (condition.type == ConditionType::IS_NULL) {
+			continue;
+		}
+		bool is_in = condition.type == ConditionType::IN;
+
+		if (condition.slot == MSG_SEQ_NUM_SLOT || condition.slot == SENDING_TIME_SLOT) {
+			// The zones hold the typed values, a tag column with another type (e.g. tagIds=[34] read as VARCHAR)
+			// compares differently and is not pruned
+			bool seq_num = condition.slot == MSG_SEQ_NUM_SLOT;
+			if (condition.value_type != (seq_num ? FixFilterValueType::BIGINT : FixFilterValueType::TIMESTAMP)) {
+				continue;
+			}
+			auto &zone = seq_num ? block.seq_num : block.sending_time;
+			// A block without values only has NULLs, which pass no comparison
+			if (!zone.has_values) {
+				return false;
+			}
+			if (condition.type == ConditionType::IS_NOT_NULL) {
+				continue;
+			}
+			bool may_match = seq_num ? ZoneMayMatch(is_in, condition.comparison, zone, condition.ints)
+			                         : ZoneMayMatch(is_in, condition.comparison, zone, condition.timestamps);
+			if (!may_match) {
+				return false;
+			}
+			continue;
+		}
+
+		if (condition.slot < FixSparseIndex::SET_COLUMN_COUNT && condition.value_type == FixFilterValueType::VARCHAR &&
+		    condition.IsEquality()) {
+			auto &set = index.sets[condition.slot];
+			if (!set.indexed) {
+				continue;
+			}
+			bool may_match = false;
+			for (auto &constant : condition.strings) {
+				auto value_idx = set.Find(constant.data(), constant.size());
+				if (value_idx >= 0 && set.BlockHas(block_idx, static_cast<idx_t>(value_idx))) {
+					may_match = true;
+					break;
+				}
+			}
+			if (!may_match) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace duckdb
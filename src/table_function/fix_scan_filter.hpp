@@ -0,0 +1,88 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/planner/table_filter.hpp"
+#include "parser/fix_message.hpp"
+#include "parser/fix_sparse_index.hpp"
+
+namespace duckdb {
+
+// Value type of a tag column as read_fix writes it
+enum class FixFilterValueType : uint8_t { VARCHAR, BIGINT, DOUBLE, TIMESTAMP, BOOLEAN };
+
+// A scanned column that filters can be evaluated on before the row is written
+struct FixFilterColumn {
+	// Slot of the tag in ParsedFixMessage, FixTagLayout::NO_SLOT for columns that are not a single tag
+	uint16_t slot = FixTagLayout::NO_SLOT;
+	int tag = 0;
+	FixFilterValueType type = FixFilterValueType::VARCHAR;
+};
+
+// Filters pushed into read_fix
+// Comparisons, IN and NULL checks on tag columns are compiled into conditions over the parsed message,
+// so rows that do not match are dropped before any column is written; equality on a VARCHAR tag also
+// yields a raw byte pattern (e.g. "|35=8|") that rejects most lines before they are tokenized
+// Everything else (other filter types, filters on tags/groups/raw_message/...) becomes a residual
+// expression that is evaluated on the output chunk
+class FixScanFilter {
+public:
+	// columns and types describe each scanned column (the positions the filter set is keyed by)
+	void Initialize(const TableFilterSet &filters, const vector<FixFilterColumn> &columns,
+	                const vector<LogicalType> &types, char delimiter);
+
+	bool HasConditions() const {
+		return !conditions_.empty();
+	}
+
+	// False if the line can not match, checked on the raw bytes before tokenizing
+	bool MayMatch(const char *line, size_t len) const;
+
+	// True if the parsed message passes every compiled condition
+	bool Matches(const ParsedFixMessage &parsed) const;
+
+	// False if no row of an indexed block can pass the compiled conditions
+	bool MayMatchBlock(const FixSparseIndex &index, idx_t block) const;
+
+	// Filters left to evaluate on the output chunk, nullptr if there are none
+	const Expression *GetResidual() const {
+		return residual_.get();
+	}
+
+private:
+	enum class ConditionType : uint8_t { COMPARE, IN, IS_NULL, IS_NOT_NULL };
+
+	struct Condition {
+		ConditionType type;
+		ExpressionType comparison;
+		uint16_t slot;
+		FixFilterValueType value_type;
+		// Constants of the comparison (one) or of the IN list, in the column's value type (BOOLEAN as 0/1 ints)
+		vector<string> strings;
+		vector<int64_t> ints;
+		vector<double> doubles;
+		vector<timestamp_t> timestamps;
+
+		// = or IN
+		bool IsEquality() const {
+			return type == ConditionType::IN ||
+			       (type == ConditionType::COMPARE && comparison == ExpressionType::COMPARE_EQUAL);
+		}
+	};
+
+	// Byte patterns of which at least one must occur in a matching line
+	struct RawPattern {
+		vector<string> needles;
+		// Tag 8 also matches as the first field of the message, which has no delimiter before it
+		bool first_field = false;
+	};
+
+	bool Compile(const TableFilter &filter, const FixFilterColumn &column, vector<Condition> &result);
+	static bool AddConstant(Condition &condition, const Value &constant);
+	static bool Evaluate(const Condition &condition, const ParsedFixMessage::TagValue &value);
+
+	vector<Condition> conditions_;
+	vector<RawPattern> patterns_;
+	unique_ptr<Expression> residual_;
+};
+
+} // namespace duckdb
@@ -0,0 +1,133 @@
+#include "fix_scan_stats.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+
+namespace duckdb {
+
+static constexpr const char *FIX_SCAN_STATS_KEY = "quackfix_scan_stats";
+
+shared_ptr<FixScanStatsHistory> FixScanStatsHistory::Get(ClientContext &context) {
+	auto &cache = ObjectCache::GetObjectCache(context);
+	auto history = cache.Get<FixScanStatsHistory>(FIX_SCAN_STATS_KEY);
+	if (!history) {
+		history = make_shared_ptr<FixScanStatsHistory>();
+		cache.Put(FIX_SCAN_STATS_KEY, history);
+	}
+	return history;
+}
+
+void FixScanStatsHistory::Add(FixScanStats stats) {
+	lock_guard<mutex> guard(lock);
+	stats.scan_id = next_scan_id++;
+	scans.push_back(std::move(stats));
+	while (scans.size() > MAX_SCANS) {
+		scans.pop_front();
+	}
+}
+
+vector<FixScanStats> FixScanStatsHistory::Snapshot() {
+	lock_guard<mutex> guard(lock);
+	return vector<FixScanStats>(scans.begin(), scans.end());
+}
+
+// Counter columns of fix_scan_stats, after scan_id, function, query, files, range_size, buffer_size, threads
+// and wall_ns
+struct FixScanStatsColumn {
+	const char *name;
+	idx_t FixScanCounters::*counter;
+};
+
+static const FixScanStatsColumn FIX_SCAN_STATS_COUNTERS[] = {
+    {"bytes_read", &FixScanCounters::bytes_read},
+    {"lines_read", &FixScanCounters::lines_read},
+    {"messages_parsed", &FixScanCounters::messages_parsed},
+    {"rows_emitted", &FixScanCounters::rows_emitted},
+    {"parse_errors", &FixScanCounters::parse_errors},
+    {"conversion_errors", &FixScanCounters::conversion_errors},
+    {"read_ns", &FixScanCounters::read_ns},
+    {"filter_ns", &FixScanCounters::filter_ns},
+    {"tokenize_ns", &FixScanCounters::tokenize_ns},
+    {"groups_ns", &FixScanCounters::groups_ns},
+    {"materialize_ns", &FixScanCounters::materialize_ns},
+};
+
+struct FixScanStatsGlobalState : public GlobalTableFunctionState {
+	vector<FixScanStats> scans;
+	idx_t current_idx = 0;
+
+	idx_t MaxThreads() const override {
+		return 1;
+	}
+};
+
+static unique_ptr<FunctionData> FixScanStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                 vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("scan_id");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+	names.emplace_back("function");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("query");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	for (auto name : {"files", "range_size", "buffer_size", "threads", "wall_ns"}) {
+		names.emplace_back(name);
+		return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+	}
+	for (auto &column : FIX_SCAN_STATS_COUNTERS) {
+		names.emplace_back(column.name);
+		return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+	}
+	// Bytes read per second of wall time
+	names.emplace_back("mb_per_second");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE));
+	return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<GlobalTableFunctionState> FixScanStatsInitGlobal(ClientContext &context,
+                                                                   TableFunctionInitInput &input) {
+	auto result = make_uniq<FixScanStatsGlobalState>();
+	result->scans = FixScanStatsHistory::Get(context)->Snapshot();
+	return std::move(result);
+}
+
+static void FixScanStatsScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &gstate = data_p.global_state->Cast<FixScanStatsGlobalState>();
+
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE && gstate.current_idx < gstate.scans.size()) {
+		auto &scan = gstate.scans[gstate.current_idx];
+		idx_t col = 0;
+		auto set_bigint = [&](idx_t value) {
+			output.data[col++].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(value)));
+		};
+		set_bigint(scan.scan_id);
+		output.data[col++].SetValue(output_idx, Value(scan.function));
+		output.data[col++].SetValue(output_idx, Value(scan.query));
+		set_bigint(scan.files);
+		set_bigint(scan.range_size);
+		set_bigint(scan.buffer_size);
+		set_bigint(scan.threads);
+		set_bigint(scan.wall_ns);
+		for (auto &column : FIX_SCAN_STATS_COUNTERS) {
+			set_bigint(scan.counters.*column.counter);
+		}
+		if (scan.wall_ns > 0) {
+			auto seconds = static_cast<double>(scan.wall_ns) / 1e9;
+			auto mb = static_cast<double>(scan.counters.bytes_read) / (1 << 20);
+			output.data[col].SetValue(output_idx, Value::DOUBLE(mb / seconds));
+		} else {
+			output.data[col].SetValue(output_idx, Value());
+		}
+
+		output_idx++;
+		gstate.current_idx++;
+	}
+
+	output.SetCardinality(output_idx);
+}
+
+TableFunction FixScanStatsFunction::GetFunction() {
+	TableFunction func("fix_scan_stats", {}, FixScanStatsScan, FixScanStatsBind, FixScanStatsInitGlobal);
+	func.name = "fix_scan_stats";
+	return func;
+}
+
+} // namespace duckdb
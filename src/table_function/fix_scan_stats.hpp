@@ -0,0 +1,127 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include <chrono>
+#include <deque>
+
+namespace duckdb {
+
+// Name of the setting that turns the read_fix scan counters on
+static constexpr const char *FIX_PROFILING_SETTING = "quackfix_profiling";
+
+// Counters of a read_fix scan, collected while quackfix_profiling is set
+// Each thread counts into its own copy and adds it to the scan's totals once per chunk
+struct FixScanCounters {
+	idx_t bytes_read = 0;
+	idx_t lines_read = 0;
+	idx_t messages_parsed = 0;
+	idx_t rows_emitted = 0;
+	idx_t parse_errors = 0;
+	idx_t conversion_errors = 0;
+	// Nanoseconds per phase, summed over threads
+	// read: FixFileReader (I/O, line splitting), filter: pushed filters, tokenize: FixTokenizer,
+	// groups: group parsing and the groups column, materialize: every other output column
+	idx_t read_ns = 0;
+	idx_t filter_ns = 0;
+	idx_t tokenize_ns = 0;
+	idx_t groups_ns = 0;
+	idx_t materialize_ns = 0;
+
+	void Add(const FixScanCounters &other) {
+		bytes_read += other.bytes_read;
+		lines_read += other.lines_read;
+		messages_parsed += other.messages_parsed;
+		rows_emitted += other.rows_emitted;
+		parse_errors += other.parse_errors;
+		conversion_errors += other.conversion_errors;
+		read_ns += other.read_ns;
+		filter_ns += other.filter_ns;
+		tokenize_ns += other.tokenize_ns;
+		groups_ns += other.groups_ns;
+		materialize_ns += other.materialize_ns;
+	}
+
+	// Clock of the phase timers, in nanoseconds
+	static idx_t Now() {
+		auto now = std::chrono::steady_clock::now().time_since_epoch();
+		return static_cast<idx_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+	}
+};
+
+// Adds the time since the previous lap to a phase counter, a no-op unless profiling
+struct FixPhaseTimer {
+	explicit FixPhaseTimer(bool enabled_p) : enabled(enabled_p), mark(enabled_p ? FixScanCounters::Now() : 0) {
+	}
+
+	void Lap(idx_t &phase_ns) {
+		if (enabled) {
+			auto now = FixScanCounters::Now();
+			phase_ns += now - mark;
+			mark = now;
+		}
+	}
+
+	bool enabled;
+	idx_t mark;
+};
+
+// Totals of one finished read_fix scan
+struct FixScanStats {
+	idx_t scan_id = 0;
+	string function;
+	string query;
+	idx_t files = 0;
+	idx_t range_size = 0;
+	idx_t buffer_size = 0;
+	// Threads that scanned at least one range
+	idx_t threads = 0;
+	// From the start of the scan to the last chunk it produced
+	idx_t wall_ns = 0;
+	FixScanCounters counters;
+};
+
+// Stats of the last profiled scans of a database, kept in its ObjectCache
+class FixScanStatsHistory : public ObjectCacheEntry {
+public:
+	// Scans kept, older ones are dropped
+	static constexpr idx_t MAX_SCANS = 100;
+
+	// The history of the database of context
+	static shared_ptr<FixScanStatsHistory> Get(ClientContext &context);
+
+	// Keep the stats of a finished scan, numbering it
+	void Add(FixScanStats stats);
+
+	// The kept scans, oldest first
+	vector<FixScanStats> Snapshot();
+
+	static string ObjectType() {
+		return "quackfix_scan_stats";
+	}
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	// Not accounted against the object cache size
+	optional_idx GetEstimatedCacheMemory() const override {
+		return optional_idx();
+	}
+
+private:
+	mutex lock;
+	std::deque<FixScanStats> scans;
+	idx_t next_scan_id = 1;
+};
+
+// fix_scan_stats() - the counters and phase timings of the last read_fix scans run with quackfix_profiling set
+class FixScanStatsFunction {
+public:
+	static TableFunction GetFunction();
+};
+
+} // namespace duckdb
@@ -0,0 +1,459 @@
+#include "fix_seq_gaps_function.hpp"
+#include "read_fix_function.hpp"
+#include "duckdb/common/enums/file_compression_type.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "parser/fix_file_reader.hpp"
+#include "parser/fix_tokenizer.hpp"
+#include "parser/fix_type_conversions.hpp"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace duckdb {
+
+static constexpr int FIX_NEW_SEQ_NO = 36;          // NewSeqNo
+static constexpr int FIX_POSS_DUP_FLAG = 43;       // PossDupFlag
+static constexpr int FIX_POSS_RESEND = 97;         // PossResend
+static constexpr int FIX_GAP_FILL_FLAG = 123;      // GapFillFlag
+static constexpr int FIX_RESET_SEQ_NUM_FLAG = 141; // ResetSeqNumFlag
+
+enum class FixSeqSegmentType : uint8_t {
+	// Consecutive messages
+	MESSAGES,
+	// Consecutive messages sent with PossDupFlag or PossResend
+	POSS_DUP,
+	// SequenceReset-GapFill: first..last will not be resent
+	GAP_FILL,
+	// SequenceReset-Reset, or Logon with ResetSeqNumFlag (which itself takes first): the session continues at first
+	RESET
+};
+
+// Consecutive sequence numbers of one session within one range
+// A healthy session is one MESSAGES segment per range, so the per-range state stays small
+struct FixSeqSegment {
+	FixSeqSegmentType type;
+	int64_t first;
+	int64_t last;
+	// File offset and SendingTime (NULL if invalid) of the first message
+	idx_t offset;
+	timestamp_t time;
+	bool has_time;
+};
+
+struct FixSeqSession {
+	string sender;
+	string target;
+	// In stream order
+	vector<FixSeqSegment> segments;
+};
+
+// The sessions of one range, keyed by SenderCompID '\0' TargetCompID
+struct FixSeqRange {
+	idx_t batch_index;
+	string file;
+	unordered_map<string, FixSeqSession> sessions;
+};
+
+enum class FixSeqGapKind : uint8_t { GAP, DUPLICATE, POSS_DUP, GAP_FILL, RESET };
+
+static const char *FixSeqGapKindName(FixSeqGapKind kind) {
+	switch (kind) {
+	case FixSeqGapKind::GAP:
+		return "gap";
+	case FixSeqGapKind::DUPLICATE:
+		return "duplicate";
+	case FixSeqGapKind::POSS_DUP:
+		return "poss_dup";
+	case FixSeqGapKind::GAP_FILL:
+		return "gap_fill";
+	default:
+		return "reset";
+	}
+}
+
+struct FixSeqGapRow {
+	const FixSeqSession *session;
+	FixSeqGapKind kind;
+	int64_t seq_from;
+	int64_t seq_to;
+	// The message that revealed it
+	const string *file;
+	idx_t offset;
+	timestamp_t time;
+	bool has_time;
+};
+
+// Replays the segments of one session in stream order, tracking the next expected sequence number
+struct FixSeqReplay {
+	FixSeqReplay(const FixSeqSession &session, vector<FixSeqGapRow> &rows)
+	    : session(session), rows(rows), first_row(rows.size()) {
+	}
+
+	void Apply(const FixSeqSegment &segment, const string &file);
+
+private:
+	void AddRow(FixSeqGapKind kind, int64_t seq_from, int64_t seq_to, const FixSeqSegment &segment,
+	            const string &file);
+
+	const FixSeqSession &session;
+	vector<FixSeqGapRow> &rows;
+	// Rows of this session start here
+	idx_t first_row;
+	int64_t expected = 0;
+	bool started = false;
+};
+
+void FixSeqReplay::AddRow(FixSeqGapKind kind, int64_t seq_from, int64_t seq_to, const FixSeqSegment &segment,
+                          const string &file) {
+	// Runs split by range boundaries (and consecutive resends, duplicates or gap fills) are reported once
+	if (rows.size() > first_row && kind != FixSeqGapKind::GAP && kind != FixSeqGapKind::RESET) {
+		auto &last = rows.back();
+		if (last.kind == kind && last.seq_to + 1 == seq_from) {
+			last.seq_to = seq_to;
+			return;
+		}
+	}
+	rows.push_back({&session, kind, seq_from, seq_to, &file, segment.offset, segment.time, segment.has_time});
+}
+
+void FixSeqReplay::Apply(const FixSeqSegment &segment, const string &file) {
+	if (segment.type == FixSeqSegmentType::RESET) {
+		AddRow(FixSeqGapKind::RESET, segment.first, segment.first, segment, file);
+		expected = segment.last + 1;
+		started = true;
+		return;
+	}
+	// The first message of a session sets where it starts
+	if (!started) {
+		expected = segment.first;
+		started = true;
+	}
+	if (segment.first > expected) {
+		AddRow(FixSeqGapKind::GAP, expected, segment.first - 1, segment, file);
+	}
+	if (segment.type == FixSeqSegmentType::POSS_DUP) {
+		AddRow(FixSeqGapKind::POSS_DUP, segment.first, segment.last, segment, file);
+	} else if (segment.type == FixSeqSegmentType::GAP_FILL) {
+		AddRow(FixSeqGapKind::GAP_FILL, segment.first, segment.last, segment, file);
+	} else if (segment.first < expected) {
+		AddRow(FixSeqGapKind::DUPLICATE, segment.first, MinValue(segment.last, expected - 1), segment, file);
+	}
+	expected = MaxValue(expected, segment.last + 1);
+}
+
+struct FixSeqGapsBindData : public TableFunctionData {
+	vector<string> files;
+	idx_t range_size = DEFAULT_FIX_RANGE_SIZE;
+	FileCompressionType compression = FileCompressionType::AUTO_DETECT;
+	// Hot tags plus the resend and reset tags
+	FixTagLayout tag_layout;
+	uint16_t new_seq_no_slot = FixTagLayout::NO_SLOT;
+	uint16_t poss_dup_slot = FixTagLayout::NO_SLOT;
+	uint16_t poss_resend_slot = FixTagLayout::NO_SLOT;
+	uint16_t gap_fill_slot = FixTagLayout::NO_SLOT;
+	uint16_t reset_slot = FixTagLayout::NO_SLOT;
+	FixParseOptions parse_options;
+};
+
+struct FixSeqGapsLocalState : public LocalTableFunctionState {
+	FixFileReader file_reader;
+	ParsedFixMessage parsed;
+	// One entry per range read, the last one is being read
+	vector<FixSeqRange> ranges;
+	// Session key of the current message, reused to avoid allocating
+	string key;
+	bool scanned = false;
+	// This thread merged last and emits the rows
+	bool emits = false;
+
+	explicit FixSeqGapsLocalState(const FixSeqGapsBindData &bind_data) : parsed(bind_data.tag_layout) {
+	}
+};
+
+struct FixSeqGapsGlobalState : public GlobalTableFunctionState {
+	FixRangeScheduler scheduler;
+
+	std::mutex lock;
+	vector<FixSeqRange> ranges;
+	bool finalized = false;
+	// Built and emitted by the thread that merged last
+	vector<FixSeqGapRow> rows;
+	idx_t next_row = 0;
+
+	explicit FixSeqGapsGlobalState(const FixSeqGapsBindData &bind_data)
+	    : scheduler(bind_data.files, bind_data.range_size, bind_data.compression) {
+	}
+
+	idx_t MaxThreads() const override {
+		// Ranges are handed out on demand, threads that find no work finish immediately
+		return GlobalTableFunctionState::MAX_THREADS;
+	}
+
+	// Merge the ranges of a thread that found no more ranges
+	// Returns true for the thread whose merge completes the scan, it then emits the rows
+	bool Merge(FixSeqGapsLocalState &local);
+
+private:
+	// Replay every session over the ranges in file order
+	void BuildRows();
+};
+
+bool FixSeqGapsGlobalState::Merge(FixSeqGapsLocalState &local) {
+	std::lock_guard<std::mutex> guard(lock);
+	for (auto &range : local.ranges) {
+		ranges.push_back(std::move(range));
+	}
+	local.ranges.clear();
+	// Every thread that merges has found the scheduler empty, so all ranges have been handed out
+	if (finalized || ranges.size() < scheduler.GetRangeCount()) {
+		return false;
+	}
+	finalized = true;
+	BuildRows();
+	return true;
+}
+
+void FixSeqGapsGlobalState::BuildRows() {
+	std::sort(ranges.begin(), ranges.end(),
+	          [](const FixSeqRange &a, const FixSeqRange &b) { return a.batch_index < b.batch_index; });
+	// Sessions are replayed one after the other, ordered by key
+	std::map<string, vector<pair<const FixSeqRange *, const FixSeqSession *>>> sessions;
+	for (auto &range : ranges) {
+		for (auto &entry : range.sessions) {
+			sessions[entry.first].emplace_back(&range, &entry.second);
+		}
+	}
+	for (auto &entry : sessions) {
+		FixSeqReplay replay(*entry.second[0].second, rows);
+		for (auto &part : entry.second) {
+			for (auto &segment : part.second->segments) {
+				replay.Apply(segment, part.first->file);
+			}
+		}
+	}
+}
+
+static unique_ptr<FunctionData> FixSeqGapsBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<FixSeqGapsBindData>();
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto file_list = fs.GlobFiles(StringValue::Get(input.inputs[0]), context, FileGlobOptions::DISALLOW_EMPTY);
+	for (auto &file_info : file_list) {
+		result->files.push_back(file_info.path);
+	}
+
+	auto &options = result->parse_options;
+	options.delimiter = '|';
+	if (input.named_parameters.find("delimiter") != input.named_parameters.end()) {
+		options.delimiter = ReadFixFunction::ParseDelimiter(StringValue::Get(input.named_parameters.at("delimiter")));
+	}
+	if (input.named_parameters.find("range_size") != input.named_parameters.end()) {
+		result->range_size = ReadFixFunction::ParseByteSize("range_size", input.named_parameters.at("range_size"));
+	}
+	if (input.named_parameters.find("compression") != input.named_parameters.end()) {
+		result->compression = FileCompressionTypeFromString(StringValue::Get(input.named_parameters.at("compression")));
+	}
+
+	// Only the session, sequence and resend tags are tokenized
+	auto &layout = result->tag_layout;
+	result->new_seq_no_slot = layout.AddTag(FIX_NEW_SEQ_NO);
+	result->poss_dup_slot = layout.AddTag(FIX_POSS_DUP_FLAG);
+	result->poss_resend_slot = layout.AddTag(FIX_POSS_RESEND);
+	result->gap_fill_slot = layout.AddTag(FIX_GAP_FILL_FLAG);
+	result->reset_slot = layout.AddTag(FIX_RESET_SEQ_NUM_FLAG);
+	options.keep_tag_list = false;
+	for (auto tag : {FixHotTags::MSG_TYPE, FixHotTags::SENDER_COMP_ID, FixHotTags::TARGET_COMP_ID,
+	                 FixHotTags::MSG_SEQ_NUM, FixHotTags::SENDING_TIME}) {
+		options.RequireSlot(static_cast<uint16_t>(FixHotTags::HotSlot(tag)));
+	}
+	for (auto slot : {result->new_seq_no_slot, result->poss_dup_slot, result->poss_resend_slot, result->gap_fill_slot,
+	                  result->reset_slot}) {
+		options.RequireSlot(slot);
+	}
+
+	names.emplace_back("SenderCompID");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("TargetCompID");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("kind");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("seq_from");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	names.emplace_back("seq_to");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	names.emplace_back("file");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("file_offset");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	names.emplace_back("SendingTime");
+	return_types.emplace_back(LogicalType(LogicalTypeId::TIMESTAMP));
+
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> FixSeqGapsInitGlobal(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<FixSeqGapsBindData>();
+	return make_uniq<FixSeqGapsGlobalState>(bind_data);
+}
+
+static unique_ptr<LocalTableFunctionState> FixSeqGapsInitLocal(ExecutionContext &context,
+                                                               TableFunctionInitInput &input,
+                                                               GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<FixSeqGapsBindData>();
+	return make_uniq<FixSeqGapsLocalState>(bind_data);
+}
+
+static bool IsFlagSet(const ParsedFixMessage::TagValue &value) {
+	return value.len == 1 && value.data[0] == 'Y';
+}
+
+// Append one message to the segments of its session
+static void AddSeqMessage(FixSeqSession &session, FixSeqSegmentType type, int64_t first, int64_t last, idx_t offset,
+                          const ParsedFixMessage &msg) {
+	if ((type == FixSeqSegmentType::MESSAGES || type == FixSeqSegmentType::POSS_DUP) && !session.segments.empty()) {
+		auto &segment = session.segments.back();
+		if (segment.type == type && segment.last + 1 == first) {
+			segment.last = last;
+			return;
+		}
+	}
+	FixSeqSegment segment;
+	segment.type = type;
+	segment.first = first;
+	segment.last = last;
+	segment.offset = offset;
+	auto &sending_time = msg.Hot<FixHotTags::SENDING_TIME>();
+	segment.has_time = ConvertToTimestamp(sending_time.data, sending_time.len, segment.time, nullptr, "SendingTime");
+	session.segments.push_back(segment);
+}
+
+// Read every range this thread gets into per-range session segments
+static void ScanSeqMessages(ClientContext &context, const FixSeqGapsBindData &bind_data, FixSeqGapsGlobalState &gstate,
+                            FixSeqGapsLocalState &lstate) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto &reader = lstate.file_reader;
+	auto &parsed = lstate.parsed;
+	const char *line;
+	idx_t line_len;
+	while (reader.OpenNextRange(fs, gstate.scheduler)) {
+		lstate.ranges.emplace_back();
+		auto &range = lstate.ranges.back();
+		range.batch_index = reader.GetBatchIndex();
+		range.file = reader.GetCurrentFile();
+		while (reader.ReadLine(line, line_len)) {
+			if (line_len == 0) {
+				continue;
+			}
+			FixTokenizer::Parse(line, line_len, parsed, bind_data.parse_options);
+			int64_t seq_num;
+			auto &seq_num_value = parsed.Hot<FixHotTags::MSG_SEQ_NUM>();
+			if (!ConvertToInt64(seq_num_value.data, seq_num_value.len, seq_num, nullptr, "MsgSeqNum")) {
+				continue;
+			}
+
+			auto type = FixSeqSegmentType::MESSAGES;
+			auto last = seq_num;
+			auto &msg_type = parsed.Hot<FixHotTags::MSG_TYPE>();
+			if (msg_type.len == 1 && msg_type.data[0] == '4') {
+				int64_t new_seq_no;
+				auto &new_seq_no_value = parsed.GetSlot(bind_data.new_seq_no_slot);
+				if (!ConvertToInt64(new_seq_no_value.data, new_seq_no_value.len, new_seq_no, nullptr, "NewSeqNo")) {
+					continue;
+				}
+				if (IsFlagSet(parsed.GetSlot(bind_data.gap_fill_slot))) {
+					if (new_seq_no <= seq_num) {
+						continue;
+					}
+					type = FixSeqSegmentType::GAP_FILL;
+					last = new_seq_no - 1;
+				} else {
+					// SequenceReset-Reset ignores its own MsgSeqNum
+					type = FixSeqSegmentType::RESET;
+					seq_num = new_seq_no;
+					last = new_seq_no - 1;
+				}
+			} else if (msg_type.len == 1 && msg_type.data[0] == 'A' &&
+			           IsFlagSet(parsed.GetSlot(bind_data.reset_slot))) {
+				type = FixSeqSegmentType::RESET;
+			} else if (IsFlagSet(parsed.GetSlot(bind_data.poss_dup_slot)) ||
+			           IsFlagSet(parsed.GetSlot(bind_data.poss_resend_slot))) {
+				type = FixSeqSegmentType::POSS_DUP;
+			}
+
+			auto &sender = parsed.Hot<FixHotTags::SENDER_COMP_ID>();
+			auto &target = parsed.Hot<FixHotTags::TARGET_COMP_ID>();
+			auto &key = lstate.key;
+			key.assign(sender.data, sender.len);
+			key.push_back('\0');
+			key.append(target.data, target.len);
+			auto entry = range.sessions.find(key);
+			if (entry == range.sessions.end()) {
+				entry = range.sessions.emplace(key, FixSeqSession()).first;
+				entry->second.sender.assign(sender.data, sender.len);
+				entry->second.target.assign(target.data, target.len);
+			}
+			AddSeqMessage(entry->second, type, seq_num, last, reader.GetLineOffset(), parsed);
+		}
+		reader.Close();
+	}
+}
+
+static void FixSeqGapsScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<FixSeqGapsBindData>();
+	auto &gstate = data_p.global_state->Cast<FixSeqGapsGlobalState>();
+	auto &lstate = data_p.local_state->Cast<FixSeqGapsLocalState>();
+
+	if (!lstate.scanned) {
+		ScanSeqMessages(context, bind_data, gstate, lstate);
+		lstate.scanned = true;
+		lstate.emits = gstate.Merge(lstate);
+	}
+	if (!lstate.emits) {
+		return;
+	}
+
+	// Only the emitting thread reads the rows once they are built
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE && gstate.next_row < gstate.rows.size()) {
+		auto &row = gstate.rows[gstate.next_row++];
+		auto &session = *row.session;
+		SetStringField(output.data[0], output_idx, session.sender.data(), session.sender.size());
+		SetStringField(output.data[1], output_idx, session.target.data(), session.target.size());
+		auto kind = FixSeqGapKindName(row.kind);
+		SetStringField(output.data[2], output_idx, kind, strlen(kind));
+		SetFlatField(output.data[3], output_idx, row.seq_from);
+		SetFlatField(output.data[4], output_idx, row.seq_to);
+		SetStringField(output.data[5], output_idx, row.file->data(), row.file->size());
+		SetFlatField(output.data[6], output_idx, static_cast<int64_t>(row.offset));
+		if (row.has_time) {
+			SetFlatField(output.data[7], output_idx, row.time);
+		} else {
+			SetNullField(output.data[7], output_idx);
+		}
+		output_idx++;
+	}
+	output.SetCardinality(output_idx);
+}
+
+TableFunction FixSeqGapsFunction::GetFunction() {
+	TableFunction func("fix_seq_gaps", {LogicalType(LogicalTypeId::VARCHAR)}, FixSeqGapsScan, FixSeqGapsBind,
+	                   FixSeqGapsInitGlobal, FixSeqGapsInitLocal);
+	func.name = "fix_seq_gaps";
+	func.named_parameters["delimiter"] = LogicalType(LogicalTypeId::VARCHAR);
+	func.named_parameters["range_size"] = LogicalType(LogicalTypeId::VARCHAR);
+	func.named_parameters["compression"] = LogicalType(LogicalTypeId::VARCHAR);
+	return func;
+}
+
+} // namespace duckdb
@@ -0,0 +1,13 @@
+#pragma once
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// fix_seq_gaps(files) - the MsgSeqNum gaps, duplicates, resends and resets of each (SenderCompID, TargetCompID)
+// session of FIX logs, found in one pass
+class FixSeqGapsFunction {
+public:
+	static TableFunction GetFunction();
+};
+
+} // namespace duckdb
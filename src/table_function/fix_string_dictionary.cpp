@@ -0,0 +1,113 @@
+#include "fix_string_dictionary.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "parser/fix_type_conversions.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace duckdb {
+
+// Dictionary ids are unique for the lifetime of the process, across scan threads and queries
+static std::atomic<idx_t> next_dictionary_id {0};
+
+void FixStringDictionary::Reset() {
+	// A full dictionary stays with the chunks that reference it, the next chunk starts a new one
+	if (entry_count_ == MAX_ENTRIES) {
+		entries_.reset();
+	}
+	flat_ = false;
+	chunk_started_ = false;
+}
+
+void FixStringDictionary::StartChunk() {
+	if (!entries_) {
+		entries_ = make_uniq<Vector>(LogicalType::VARCHAR, MAX_ENTRIES);
+		entry_count_ = 0;
+		null_code_ = MAX_ENTRIES;
+		std::fill(slots_, slots_ + SLOT_COUNT, EMPTY_SLOT);
+		dictionary_id_.clear();
+	}
+	// The codes are shared with the dictionary vector of the previous chunk until its output is reset
+	if (!codes_.data() || codes_.sel_data().use_count() > 2) {
+		codes_.Initialize(STANDARD_VECTOR_SIZE);
+	}
+	chunk_started_ = true;
+}
+
+idx_t FixStringDictionary::Intern(const char *data, size_t len) {
+	auto entries = FlatVector::GetData<string_t>(*entries_);
+	auto slot = Hash(data, len) & (SLOT_COUNT - 1);
+	while (slots_[slot] != EMPTY_SLOT) {
+		auto &entry = entries[slots_[slot]];
+		if (entry.GetSize() == len && memcmp(entry.GetData(), data, len) == 0) {
+			return slots_[slot];
+		}
+		slot = (slot + 1) & (SLOT_COUNT - 1);
+	}
+	if (entry_count_ == MAX_ENTRIES) {
+		return MAX_ENTRIES;
+	}
+	auto code = entry_count_++;
+	entries[code] = StringVector::AddString(*entries_, data, len);
+	slots_[slot] = static_cast<uint16_t>(code);
+	return code;
+}
+
+void FixStringDictionary::Add(Vector &column, idx_t row, const char *data, size_t len) {
+	if (flat_) {
+		SetStringField(column, row, data, len);
+		return;
+	}
+	if (!chunk_started_) {
+		StartChunk();
+	}
+	idx_t code;
+	if (data == nullptr || len == 0) {
+		if (null_code_ == MAX_ENTRIES) {
+			if (entry_count_ == MAX_ENTRIES) {
+				Flatten(column, row);
+				SetNullField(column, row);
+				return;
+			}
+			null_code_ = entry_count_++;
+			FlatVector::SetNull(*entries_, null_code_, true);
+		}
+		code = null_code_;
+	} else {
+		code = Intern(data, len);
+		if (code == MAX_ENTRIES) {
+			Flatten(column, row);
+			SetStringField(column, row, data, len);
+			return;
+		}
+	}
+	codes_.set_index(row, code);
+}
+
+void FixStringDictionary::Flatten(Vector &column, idx_t rows) {
+	auto entries = FlatVector::GetData<string_t>(*entries_);
+	for (idx_t row = 0; row < rows; row++) {
+		auto code = codes_.get_index(row);
+		if (code == null_code_) {
+			SetNullField(column, row);
+		} else {
+			SetStringField(column, row, entries[code].GetData(), entries[code].GetSize());
+		}
+	}
+	flat_ = true;
+}
+
+void FixStringDictionary::Finish(Vector &column, idx_t count) {
+	if (flat_ || count == 0 || !chunk_started_) {
+		return;
+	}
+	// Same entries, same id
+	if (dictionary_id_.empty() || id_entry_count_ != entry_count_) {
+		dictionary_id_ = "quackfix_" + std::to_string(next_dictionary_id.fetch_add(1, std::memory_order_relaxed));
+		id_entry_count_ = entry_count_;
+	}
+	column.Dictionary(*entries_, entry_count_, codes_, count);
+	DictionaryVector::SetDictionaryId(column, dictionary_id_);
+}
+
+} // namespace duckdb
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+// Dictionary encoding of one low-cardinality VARCHAR column (MsgType, Side, ...) of the output chunks
+// Each distinct value is stored once in a small dictionary vector and rows only record its code; at the end
+// of the chunk the column becomes a dictionary vector over it, with its size and an id, so that aggregates
+// and joins downstream can work on the dictionary entries instead of the rows
+// The dictionary carries over to the next chunks of the scan thread until it is full. Entries are only ever
+// appended, so chunks that still reference it see their values unchanged; the id changes whenever entries were
+// added, and stays the same while a column's values repeat (which lets downstream caches hit)
+// If a chunk needs more than MAX_ENTRIES distinct values the column falls back to a flat vector, and the next
+// chunk starts a new dictionary
+// Owned by one scan thread
+class FixStringDictionary {
+public:
+	static constexpr idx_t MAX_ENTRIES = 256;
+
+	// Start a new chunk
+	void Reset();
+
+	// Set the value of row, empty or missing values become NULL
+	void Add(Vector &column, idx_t row, const char *data, size_t len);
+
+	// Turn column into a dictionary vector over the values of its first count rows
+	void Finish(Vector &column, idx_t count);
+
+private:
+	static constexpr uint16_t EMPTY_SLOT = 0xFFFF;
+	static constexpr idx_t SLOT_COUNT = MAX_ENTRIES * 2;
+
+	// Allocate what the first row of a chunk needs: the dictionary if there is none, and codes that no
+	// emitted chunk references any more
+	void StartChunk();
+	// Code of a value, adding it to the dictionary; MAX_ENTRIES if the dictionary is full
+	idx_t Intern(const char *data, size_t len);
+	// Write the rows added so far to column as flat strings, every later row is written directly
+	void Flatten(Vector &column, idx_t rows);
+
+	unique_ptr<Vector> entries_;
+	SelectionVector codes_;
+	idx_t entry_count_ = 0;
+	// Code of the NULL entry, MAX_ENTRIES while there is none
+	idx_t null_code_ = MAX_ENTRIES;
+	// Open-addressing table of entry codes, keyed by value
+	uint16_t slots_[SLOT_COUNT];
+	bool flat_ = false;
+	bool chunk_started_ = false;
+	// Dictionary id of the entries, and the entry count it was taken at
+	string dictionary_id_;
+	idx_t id_entry_count_ = 0;
+};
+
+} // namespace duckdb
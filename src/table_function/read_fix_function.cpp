@@ -2,58 +2,222 @@
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/enums/file_compression_type.hpp"
+#include "duckdb/common/string_util.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/common/vector_operations/unary_executor.hpp"
 #include "duckdb/common/types/date.hpp"
 #include "duckdb/common/types/time.hpp"
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/function/table/read_csv.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/expression_executor_state.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "duckdb/storage/statistics/node_statistics.hpp"
 #include "dictionary/fix_dictionary.hpp"
-#include "dictionary/xml_loader.hpp"
-#include "dictionary/embedded_fix44_dictionary.hpp"
+#include "dictionary/fix_dictionary_cache.hpp"
 #include "parser/fix_tokenizer.hpp"
 #include "parser/fix_message.hpp"
 #include "parser/fix_type_conversions.hpp"
+#include "parser/fix_group_layout.hpp"
 #include "parser/fix_group_parser.hpp"
 #include "parser/fix_file_reader.hpp"
 #include "parser/fix_hot_tags.hpp"
+#include "parser/fix_tag_index.hpp"
+#include "parser/fix_tag_layout.hpp"
+#include "table_function/fix_scan_filter.hpp"
+#include "table_function/fix_scan_stats.hpp"
+#include "table_function/fix_string_dictionary.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <sstream>
+#include <stdexcept>
 
 namespace duckdb {
 
+// Virtual column with the file offset of each message, the first virtual column id
+static constexpr column_t FIX_COLUMN_FILE_OFFSET = VIRTUAL_COLUMN_START;
+
+// Cache key prefix of read_fix_follow checkpoints, keyed by prefix + checkpoint name
+static constexpr const char *FIX_FOLLOW_CHECKPOINT_PREFIX = "quackfix_follow:";
+
+// Offset read_fix_follow has read a file up to, kept in the database's ObjectCache
+class FixFollowCheckpoint : public ObjectCacheEntry {
+public:
+	std::atomic<idx_t> offset {0};
+
+	static string ObjectType() {
+		return "quackfix_follow_checkpoint";
+	}
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	// Not accounted against the object cache size
+	optional_idx GetEstimatedCacheMemory() const override {
+		return optional_idx();
+	}
+};
+
+// Bytes and rows of a scan for the optimizer and the progress bar, estimated on first use (see ReadFixEstimateScan)
+// scan_bytes: bytes the scan reads, 0 if unknown; rows is exact when every file has a sidecar index
+struct FixScanEstimate {
+	mutex lock;
+	bool estimated = false;
+	idx_t scan_bytes = 0;
+	idx_t rows = 0;
+	bool exact_rows = false;
+};
+
 // Bind data - configuration for the table function
 struct ReadFixBindData : public TableFunctionData {
 	vector<string> files;
-	shared_ptr<FixDictionary> dictionary;
+	shared_ptr<const FixDictionary> dictionary;
+	// Groups of the dictionary compiled for the group parser and the tokenizer's early exit (cached with it)
+	std::shared_ptr<const FixGroupLayout> group_layout;
 
 	// Phase 7.5: Custom tag support (rtags + tagIds parameters)
 	vector<pair<string, int>> custom_tags; // {tag_name, tag_number}
 
+	// Hot tags plus custom tags, each promoted to a direct-indexed value slot
+	FixTagLayout tag_layout;
+	// Slot of each custom tag (parallel to custom_tags)
+	vector<uint16_t> custom_tag_slots;
+	// Column type of each custom tag (parallel to custom_tags), all VARCHAR unless typed_tags is set
+	vector<FixFilterValueType> custom_tag_types;
+
+	// Type custom tag columns from the dictionary instead of reading them as VARCHAR
+	bool typed_tags = false;
+
 	// Phase 7.7: Delimiter parameter
 	char delimiter = '|'; // Default to pipe
 
 	// Prefix extraction parameter
 	bool extract_prefix = false; // Default to false
 
+	// Size of the byte ranges files are split into for parallel scanning
+	idx_t range_size = DEFAULT_FIX_RANGE_SIZE;
+
+	// Size of each thread's read buffer
+	idx_t buffer_size = DEFAULT_FIX_BUFFER_SIZE;
+
+	// Use <file>.qfidx sidecar indexes when present
+	bool use_index = true;
+
+	// Compression of the input files, detected from the file extension by default
+	FileCompressionType compression = FileCompressionType::AUTO_DETECT;
+
+	// Read ahead in the background, by default only for remote files
+	FixPrefetchMode prefetch = FixPrefetchMode::AUTO;
+
+	// How messages are found in the input: one per line, or by BodyLength
+	FixFraming framing = FixFraming::LINES;
+
+	// Only messages starting within [start_offset, end_offset) of each file are read
+	idx_t start_offset = 0;
+	idx_t end_offset = NumericLimits<idx_t>::Maximum();
+	// read_fix_follow: advanced to the scan's end offset once it has read every range
+	shared_ptr<FixFollowCheckpoint> checkpoint;
+	// read_fix_follow without start_offset: start at the checkpoint (read when the scan starts, see
+	// ReadFixFollowInitBounds, so a prepared statement reads the new messages on every execution)
+	bool resume_from_checkpoint = false;
+
+	// Schema column types (for filters pushed into the scan)
+	vector<LogicalType> column_types;
+
+	// Estimated when the optimizer or the scan first asks, not at bind (DESCRIBE and prepared statements skip it)
+	shared_ptr<FixScanEstimate> estimate = make_shared_ptr<FixScanEstimate>();
+
 	ReadFixBindData() {
 	}
 };
 
+// Hot tag columns with few distinct values per file, emitted as dictionary vectors
+static const idx_t FIX_DICTIONARY_COLUMNS[] = {0, 1, 2, 8, 9, 10, 11}; // MsgType ... OrdStatus
+
 // Global state - shared across all threads
 struct ReadFixGlobalState : public GlobalTableFunctionState {
-	idx_t file_index;
-	mutex lock;
+	// Hands out byte ranges of the input files to scan threads
+	FixRangeScheduler scheduler;
 
 	// Phase 7.5: Projection pushdown support
 	vector<idx_t> projection_ids;
 	vector<ColumnIndex> column_indexes;
 	bool needs_tags;
 	bool needs_groups;
+	bool needs_parse_error;
+	// Conversion error messages are built for parse_error, or counted for quackfix_profiling
+	bool collect_errors;
+	// Output positions of the tags, groups and file_offset columns (INVALID_INDEX if not projected)
+	idx_t tags_output_idx;
+	idx_t groups_output_idx;
+	idx_t file_offset_output_idx;
+	// Tokenizer settings derived from the projection
+	FixParseOptions parse_options;
+	// Filters pushed into the scan
+	FixScanFilter filter;
+	// Dictionary groups compiled for the group parser and for the tokenizer's early exit (shared with parse_options)
+	std::shared_ptr<const FixGroupLayout> group_layout;
+
+	// read_fix_follow: ranges read to their end, and whether the scheduler has handed out all of them
+	shared_ptr<FixFollowCheckpoint> checkpoint;
+	idx_t checkpoint_offset;
+	std::atomic<idx_t> completed_ranges;
+	std::atomic<bool> scheduler_done;
+
+	// Bytes the threads have read, added once per chunk, and bytes the scan reads (progress)
+	std::atomic<idx_t> bytes_read;
+	idx_t scan_bytes;
+
+	// quackfix_profiling: the counters of all threads, published to fix_scan_stats() when the scan is destroyed
+	bool profiling;
+	shared_ptr<FixScanStatsHistory> stats_history;
+	mutable mutex stats_lock;
+	FixScanStats stats;
+	idx_t start_ns;
+
+	explicit ReadFixGlobalState(const ReadFixBindData &bind_data)
+	    : scheduler(bind_data.files, bind_data.range_size, bind_data.compression), needs_tags(true), needs_groups(true),
+	      needs_parse_error(true), collect_errors(true), tags_output_idx(DConstants::INVALID_INDEX),
+	      groups_output_idx(DConstants::INVALID_INDEX), file_offset_output_idx(DConstants::INVALID_INDEX),
+	      checkpoint(bind_data.checkpoint), checkpoint_offset(bind_data.end_offset), completed_ranges(0),
+	      scheduler_done(false), bytes_read(0), scan_bytes(0), profiling(false), start_ns(0) {
+		scheduler.SetBounds(bind_data.start_offset, bind_data.end_offset);
+	}
 
-	ReadFixGlobalState() : file_index(0), needs_tags(true), needs_groups(true) {
+	~ReadFixGlobalState() override {
+		// Scans that never read anything (errors before the first range, LIMIT 0) are not recorded
+		if (stats_history && stats.threads > 0) {
+			stats_history->Add(std::move(stats));
+		}
+	}
+
+	// A thread read its range to the end
+	void CompleteRange() {
+		completed_ranges++;
+		AdvanceCheckpoint();
+	}
+
+	// A thread found no more ranges to scan
+	void FinishScheduling() {
+		scheduler_done = true;
+		AdvanceCheckpoint();
+	}
+
+	// The checkpoint only moves once every message up to the checkpoint offset has been read, a scan that
+	// stops early (LIMIT, errors) returns the same messages again next time
+	void AdvanceCheckpoint() {
+		if (checkpoint && scheduler_done && completed_ranges == scheduler.GetRangeCount()) {
+			checkpoint->offset = checkpoint_offset;
+		}
 	}
 
 	idx_t MaxThreads() const override {
-		return 1; // Single-threaded for Phase 3
+		// Ranges are handed out on demand, threads that find no work finish immediately
+		return GlobalTableFunctionState::MAX_THREADS;
 	}
 
 	bool CanRemoveFilterColumns() const {
@@ -81,17 +245,59 @@ struct ReadFixGlobalState : public GlobalTableFunctionState {
 	}
 };
 
+// Local state - per-thread state
+struct ReadFixLocalState : public LocalTableFunctionState {
+	FixFileReader file_reader;
+
+	// Reused across messages so that steady-state parsing does not allocate
+	ParsedFixMessage parsed;
+	FixConversionErrors conversion_errors;
+	FixParsedGroups parsed_groups;
+	FixTagIndex tag_index;
+
+	// Child entries the MAP columns needed in the previous chunk, reserved up front for the next one
+	idx_t tags_entries_hint = 0;
+	idx_t group_entries_hint = 0;
+
+	// Evaluates the pushed filters that could not be compiled, on the output chunk
+	unique_ptr<ExpressionExecutor> filter_executor;
+	SelectionVector filter_sel;
+
+	// Dictionary-encoded hot tag columns: {output index, dictionary}, and each dictionary by schema column
+	vector<pair<idx_t, unique_ptr<FixStringDictionary>>> dictionary_columns;
+	FixStringDictionary *string_dictionaries[FixHotTags::NUM_HOT_TAGS] = {};
+
+	// Read buffer each output column of the current chunk last took a reference to (see SetLineString)
+	vector<const FixReadBuffer *> referenced_buffers;
+
+	// Bytes of file_reader already added to the scan's totals
+	idx_t counted_bytes = 0;
+	// quackfix_profiling: counted since the last chunk, then added to the scan's totals
+	FixScanCounters counters;
+	bool counted_thread = false;
+
+	explicit ReadFixLocalState(const ReadFixBindData &bind_data)
+	    : file_reader(bind_data.buffer_size, bind_data.prefetch), parsed(bind_data.tag_layout) {
+		file_reader.SetFraming(bind_data.framing, bind_data.delimiter);
+	}
+};
+
 // Column writer helper - encapsulates output column writing logic
 struct FixColumnWriter {
 	DataChunk &output;
 	idx_t row_idx;
 	const ReadFixBindData &bind_data;
 	const ReadFixGlobalState &gstate;
-	vector<string> &conversion_errors;
+	FixConversionErrors &conversion_errors;
+	// Scratch space (group offsets, tag de-duplication), owned by the thread
+	ReadFixLocalState &lstate;
+	// The read buffer holding the current line, nullptr if the line is not in one
+	const buffer_ptr<FixReadBuffer> &line_buffer;
 
 	FixColumnWriter(DataChunk &out, idx_t row, const ReadFixBindData &bind, const ReadFixGlobalState &gs,
-	                vector<string> &errors)
-	    : output(out), row_idx(row), bind_data(bind), gstate(gs), conversion_errors(errors) {
+	                ReadFixLocalState &ls)
+	    : output(out), row_idx(row), bind_data(bind), gstate(gs), conversion_errors(ls.conversion_errors), lstate(ls),
+	      line_buffer(ls.file_reader.GetLineBuffer()) {
 	}
 
 	// Get output column index from schema column index (handles projection pushdown)
@@ -113,23 +319,288 @@ struct FixColumnWriter {
 	// Write groups MAP column (column 20)
 	void WriteGroupsMap(const ParsedFixMessage &parsed);
 
+	// Append groups[begin, begin + count) of the parsed groups to a groups MAP vector as the entry of row, with
+	// the groups nested in each instance down to depth levels
+	void AppendGroups(Vector &groups_vec, idx_t row, size_t begin, size_t count, idx_t depth,
+	                  const ParsedFixMessage &parsed);
+
 	// Write metadata columns (raw_message, parse_error) - columns 21-22
-	void WriteMetadata(const string &raw_line);
+	void WriteMetadata(const char *raw_line, idx_t raw_line_len);
 
 	// Write prefix column (column 23, if extract_prefix enabled)
 	void WritePrefix(const ParsedFixMessage &parsed);
 
 	// Write custom tag columns (columns 23+ or 24+ if prefix enabled)
 	void WriteCustomTags(const ParsedFixMessage &parsed);
+
+	// Write the file_offset virtual column
+	void WriteFileOffset(idx_t offset);
+
+	// Set a VARCHAR value that lies in the current line: referenced in the read buffer when the line is in one,
+	// copied into the vector otherwise
+	void SetLineString(idx_t out_idx, const char *ptr, idx_t len);
 };
 
-// Local state - per-thread state
-struct ReadFixLocalState : public LocalTableFunctionState {
-	FixFileReader file_reader;
+idx_t ReadFixFunction::ParseByteSize(const string &name, const Value &value) {
+	string size_str = StringValue::Get(value);
+	idx_t result;
+	bool all_digits = !size_str.empty();
+	for (auto c : size_str) {
+		if (c < '0' || c > '9') {
+			all_digits = false;
+			break;
+		}
+	}
+	if (all_digits) {
+		try {
+			result = std::stoull(size_str);
+		} catch (std::out_of_range &) {
+			throw BinderException("%s is out of range: \"%s\"", name, size_str);
+		} catch (std::invalid_argument &) {
+			throw BinderException("%s must be a byte size such as '32MB', not \"%s\"", name, size_str);
+		}
+	} else {
+		result = DBConfig::ParseMemoryLimit(size_str);
+	}
+	if (result == 0) {
+		throw BinderException("%s must be greater than zero", name);
+	}
+	return result;
+}
 
-	ReadFixLocalState() {
+// Column type of a custom tag with the given dictionary field type
+// Types without a dedicated converter (STRING, CHAR, dates, ...) stay VARCHAR
+static FixFilterValueType GetTypedTagType(const string &field_type) {
+	if (field_type == "INT" || field_type == "SEQNUM" || field_type == "LENGTH" || field_type == "NUMINGROUP" ||
+	    field_type == "DAYOFMONTH") {
+		return FixFilterValueType::BIGINT;
 	}
-};
+	if (field_type == "PRICE" || field_type == "QTY" || field_type == "FLOAT" || field_type == "AMT" ||
+	    field_type == "PRICEOFFSET" || field_type == "PERCENTAGE") {
+		return FixFilterValueType::DOUBLE;
+	}
+	if (field_type == "UTCTIMESTAMP") {
+		return FixFilterValueType::TIMESTAMP;
+	}
+	if (field_type == "BOOLEAN") {
+		return FixFilterValueType::BOOLEAN;
+	}
+	return FixFilterValueType::VARCHAR;
+}
+
+static LogicalType GetValueLogicalType(FixFilterValueType type) {
+	switch (type) {
+	case FixFilterValueType::BIGINT:
+		return LogicalType(LogicalTypeId::BIGINT);
+	case FixFilterValueType::DOUBLE:
+		return LogicalType(LogicalTypeId::DOUBLE);
+	case FixFilterValueType::TIMESTAMP:
+		return LogicalType(LogicalTypeId::TIMESTAMP);
+	case FixFilterValueType::BOOLEAN:
+		return LogicalType(LogicalTypeId::BOOLEAN);
+	default:
+		return LogicalType(LogicalTypeId::VARCHAR);
+	}
+}
+
+// Type of the groups column: count tag -> instances, each with its fields and, while depth > 1, its nested groups
+static LogicalType GetGroupsLogicalType(idx_t depth) {
+	child_list_t<LogicalType> instance;
+	instance.emplace_back("fields", LogicalType::MAP(LogicalType::INTEGER, LogicalType::VARCHAR));
+	if (depth > 1) {
+		instance.emplace_back("groups", GetGroupsLogicalType(depth - 1));
+	}
+	return LogicalType::MAP(LogicalType::INTEGER, LogicalType::LIST(LogicalType::STRUCT(std::move(instance))));
+}
+
+void ReadFixFunction::AddHotColumns(vector<string> &names, vector<LogicalType> &return_types) {
+	names.emplace_back("MsgType");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("SenderCompID");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("TargetCompID");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("MsgSeqNum");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT)); // Numeric
+
+	names.emplace_back("SendingTime");
+	return_types.emplace_back(LogicalType(LogicalTypeId::TIMESTAMP)); // Timestamp with milliseconds
+
+	names.emplace_back("ClOrdID");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("OrderID");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("ExecID");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("Symbol");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("Side");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("ExecType");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("OrdStatus");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("Price");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
+
+	names.emplace_back("OrderQty");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
+
+	names.emplace_back("CumQty");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
+
+	names.emplace_back("LeavesQty");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
+
+	names.emplace_back("LastPx");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
+
+	names.emplace_back("LastQty");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
+
+	names.emplace_back("Text");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+}
+
+LogicalType ReadFixFunction::GetTypedTagLogicalType(const string &field_type) {
+	return GetValueLogicalType(GetTypedTagType(field_type));
+}
+
+char ReadFixFunction::ParseDelimiter(const string &delimiter) {
+	if (delimiter.empty()) {
+		throw BinderException("delimiter cannot be empty");
+	} else if (delimiter.size() == 1) {
+		return delimiter[0];
+	} else if (delimiter == "\\x01") {
+		return '\x01'; // SOH
+	} else {
+		throw BinderException("delimiter must be a single character or '\\x01' for SOH");
+	}
+}
+
+// Bytes sampled from the first seekable file to estimate the average message length
+static constexpr idx_t FIX_ESTIMATE_SAMPLE_SIZE = 64ULL * 1024ULL;
+// Average message length assumed when no file could be sampled
+static constexpr idx_t FIX_ESTIMATE_MESSAGE_LENGTH = 256;
+// Uncompressed bytes per byte of a compressed file, a rough guess (FIX logs are very repetitive)
+static constexpr idx_t FIX_ESTIMATE_COMPRESSION_RATIO = 8;
+// Files opened for the estimate, the others are assumed to be as large as the average of these
+static constexpr idx_t FIX_ESTIMATE_MAX_FILES = 4;
+
+// Average length of the messages in the first FIX_ESTIMATE_SAMPLE_SIZE bytes after offset, 0 if none ends there
+static double SampleMessageLength(FileHandle &handle, idx_t offset, idx_t size, FixFraming framing) {
+	auto sample_size = MinValue<idx_t>(size, FIX_ESTIMATE_SAMPLE_SIZE);
+	auto sample = unique_ptr<char[]>(new char[sample_size]);
+	handle.Read(sample.get(), sample_size, offset);
+	idx_t messages = 0;
+	idx_t messages_end = 0;
+	if (framing == FixFraming::LINES) {
+		for (idx_t i = 0; i < sample_size; i++) {
+			if (sample[i] == '\n') {
+				messages++;
+				messages_end = i + 1;
+			}
+		}
+		if (messages == 0 && sample_size == size) {
+			// The whole range is one line without a line break
+			messages = 1;
+			messages_end = size;
+		}
+	} else {
+		// Framed messages start with BeginString (8=FIX or 8=FIXT)
+		static constexpr const char *BEGIN_STRING = "8=FIX";
+		for (idx_t i = 0; i + 5 <= sample_size; i++) {
+			if (memcmp(sample.get() + i, BEGIN_STRING, 5) == 0) {
+				messages++;
+			}
+		}
+		messages_end = sample_size;
+	}
+	return messages == 0 ? 0 : static_cast<double>(messages_end) / static_cast<double>(messages);
+}
+
+// Estimate the bytes and rows of a scan from the file sizes, for the optimizer and the progress bar
+// Files with a sidecar index contribute its exact line count, the others their size divided by the average
+// message length of a sample of the first file that can seek; compressed sizes are scaled by a guessed ratio
+// Pipes are not opened, reading a sample would consume their data. Computed once per bind
+static const FixScanEstimate &ReadFixEstimateScan(ClientContext &context, const ReadFixBindData &bind_data) {
+	auto &estimate = *bind_data.estimate;
+	lock_guard<mutex> guard(estimate.lock);
+	if (estimate.estimated) {
+		return estimate;
+	}
+	estimate.estimated = true;
+	auto &fs = FileSystem::GetFileSystem(context);
+	// read_fix_follow: estimated from the checkpoint as of now, the scan reads it again when it starts
+	auto start_offset = bind_data.resume_from_checkpoint ? bind_data.checkpoint->offset.load() : bind_data.start_offset;
+	bool bounded = start_offset > 0 || bind_data.end_offset != NumericLimits<idx_t>::Maximum();
+	idx_t opened_files = 0;
+	idx_t opened_bytes = 0;
+	idx_t indexed_rows = 0;
+	idx_t unindexed_bytes = 0;
+	bool all_indexed = true;
+	double message_length = 0;
+
+	for (idx_t i = 0; i < bind_data.files.size(); i++) {
+		auto &file = bind_data.files[i];
+		// Opening remote files costs a request each, only the first one is
+		if (opened_files >= FIX_ESTIMATE_MAX_FILES || (opened_files > 0 && FileSystem::IsRemoteFile(file))) {
+			auto file_bytes = opened_bytes / opened_files;
+			unindexed_bytes += file_bytes;
+			estimate.scan_bytes += file_bytes;
+			all_indexed = false;
+			continue;
+		}
+		if (fs.IsPipe(file)) {
+			all_indexed = false;
+			continue;
+		}
+		auto handle = fs.OpenFile(file, FileFlags::FILE_FLAGS_READ | bind_data.compression);
+		auto file_size = handle->GetFileSize();
+		idx_t file_bytes;
+		if (handle->CanSeek()) {
+			auto end = MinValue<idx_t>(file_size, bind_data.end_offset);
+			file_bytes = end > start_offset ? end - start_offset : 0;
+		} else {
+			file_bytes = file_size * FIX_ESTIMATE_COMPRESSION_RATIO;
+		}
+		opened_files++;
+		opened_bytes += file_bytes;
+		estimate.scan_bytes += file_bytes;
+
+		FixSparseIndex index;
+		if (handle->CanSeek() && bind_data.use_index && !bounded && FixSparseIndex::TryLoad(fs, file, *handle, index) &&
+		    index.delimiter == bind_data.delimiter) {
+			for (auto &block : index.blocks) {
+				indexed_rows += block.line_count;
+			}
+			continue;
+		}
+		all_indexed = false;
+		unindexed_bytes += file_bytes;
+		if (message_length == 0 && handle->CanSeek() && file_bytes > 0) {
+			message_length = SampleMessageLength(*handle, start_offset, file_bytes, bind_data.framing);
+		}
+	}
+
+	if (message_length == 0) {
+		message_length = FIX_ESTIMATE_MESSAGE_LENGTH;
+	}
+	auto unindexed_rows = static_cast<double>(unindexed_bytes) / message_length;
+	estimate.rows = indexed_rows + static_cast<idx_t>(unindexed_rows + 0.5);
+	estimate.exact_rows = all_indexed;
+	return estimate;
+}
 
 // Bind function - called once at query planning time
 static unique_ptr<FunctionData> ReadFixBind(ClientContext &context, TableFunctionBindInput &input,
@@ -153,35 +624,30 @@ static unique_ptr<FunctionData> ReadFixBind(ClientContext &context, TableFunctio
 	}
 
 	// Load FIX dictionary for group parsing and custom tag validation
+	// Parsed dictionaries are cached across queries; without a dictionary parameter the embedded FIX 4.4 one is used
 	try {
-		FixDictionary dict;
-
+		string dict_path;
 		if (input.named_parameters.find("dictionary") != input.named_parameters.end()) {
-			// User provided a dictionary path - load from file
-			string dict_path = StringValue::Get(input.named_parameters.at("dictionary"));
-			dict = FixDictionaryLoader::LoadBase(context, dict_path);
-		} else {
-			// No dictionary provided - use embedded FIX 4.4 dictionary
-			dict = FixDictionaryLoader::LoadFromString(duckdb::GetEmbeddedFix44Dictionary());
+			dict_path = StringValue::Get(input.named_parameters.at("dictionary"));
 		}
-
-		result->dictionary = make_shared_ptr<FixDictionary>(std::move(dict));
+		result->dictionary = FixDictionaryCache::Get(context, dict_path, result->group_layout);
 	} catch (const std::exception &e) {
 		throw BinderException("Failed to load FIX dictionary: %s", e.what());
 	}
 
 	// Phase 7.7: Parse delimiter parameter
 	if (input.named_parameters.find("delimiter") != input.named_parameters.end()) {
-		string delim_str = StringValue::Get(input.named_parameters.at("delimiter"));
-		if (delim_str.empty()) {
-			throw BinderException("delimiter cannot be empty");
-		} else if (delim_str.size() == 1) {
-			result->delimiter = delim_str[0];
-		} else if (delim_str == "\\x01") {
-			result->delimiter = '\x01'; // SOH
-		} else {
-			throw BinderException("delimiter must be a single character or '\\x01' for SOH");
-		}
+		result->delimiter = ReadFixFunction::ParseDelimiter(StringValue::Get(input.named_parameters.at("delimiter")));
+	}
+
+	// Use sidecar indexes built by fix_build_index
+	if (input.named_parameters.find("use_index") != input.named_parameters.end()) {
+		result->use_index = BooleanValue::Get(input.named_parameters.at("use_index"));
+	}
+
+	// Parse compression parameter ('auto', 'none', 'gzip', 'zstd')
+	if (input.named_parameters.find("compression") != input.named_parameters.end()) {
+		result->compression = FileCompressionTypeFromString(StringValue::Get(input.named_parameters.at("compression")));
 	}
 
 	// Parse prefix parameter
@@ -189,6 +655,55 @@ static unique_ptr<FunctionData> ReadFixBind(ClientContext &context, TableFunctio
 		result->extract_prefix = BooleanValue::Get(input.named_parameters.at("prefix"));
 	}
 
+	// Parse range_size parameter
+	if (input.named_parameters.find("range_size") != input.named_parameters.end()) {
+		result->range_size = ReadFixFunction::ParseByteSize("range_size", input.named_parameters.at("range_size"));
+	}
+
+	// Parse buffer_size parameter
+	if (input.named_parameters.find("buffer_size") != input.named_parameters.end()) {
+		result->buffer_size = ReadFixFunction::ParseByteSize("buffer_size", input.named_parameters.at("buffer_size"));
+	}
+
+	// Parse typed_tags parameter
+	if (input.named_parameters.find("typed_tags") != input.named_parameters.end()) {
+		result->typed_tags = BooleanValue::Get(input.named_parameters.at("typed_tags"));
+	}
+
+	// Parse prefetch parameter
+	if (input.named_parameters.find("prefetch") != input.named_parameters.end()) {
+		result->prefetch = BooleanValue::Get(input.named_parameters.at("prefetch")) ? FixPrefetchMode::ALWAYS
+		                                                                             : FixPrefetchMode::NEVER;
+	}
+
+	// Parse framing parameter ('lines', 'bodylength')
+	if (input.named_parameters.find("framing") != input.named_parameters.end()) {
+		auto framing = StringUtil::Lower(StringValue::Get(input.named_parameters.at("framing")));
+		if (framing == "lines") {
+			result->framing = FixFraming::LINES;
+		} else if (framing == "bodylength") {
+			result->framing = FixFraming::BODY_LENGTH;
+		} else {
+			throw BinderException("framing must be 'lines' or 'bodylength'");
+		}
+	}
+	if (result->framing != FixFraming::LINES) {
+		if (result->extract_prefix) {
+			throw BinderException("prefix cannot be used with framing 'bodylength', messages start at 8=");
+		}
+		// Sidecar indexes describe lines
+		result->use_index = false;
+	}
+
+	// Parse start_offset parameter
+	if (input.named_parameters.find("start_offset") != input.named_parameters.end()) {
+		auto start_offset = BigIntValue::Get(input.named_parameters.at("start_offset"));
+		if (start_offset < 0) {
+			throw BinderException("start_offset cannot be negative");
+		}
+		result->start_offset = static_cast<idx_t>(start_offset);
+	}
+
 	// Phase 7.5: Process custom tag parameters (rtags and tagIds)
 	// Use a set to track already-added tags (avoid duplicates)
 	std::unordered_set<int> added_tags;
@@ -253,63 +768,21 @@ static unique_ptr<FunctionData> ReadFixBind(ClientContext &context, TableFunctio
 		}
 	}
 
-	// Define full schema for Phase 4.5 - with proper types
-	names.emplace_back("MsgType");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
-
-	names.emplace_back("SenderCompID");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
-
-	names.emplace_back("TargetCompID");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
-
-	names.emplace_back("MsgSeqNum");
-	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT)); // Numeric
-
-	names.emplace_back("SendingTime");
-	return_types.emplace_back(LogicalType(LogicalTypeId::TIMESTAMP)); // Timestamp with milliseconds
-
-	names.emplace_back("ClOrdID");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
-
-	names.emplace_back("OrderID");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
-
-	names.emplace_back("ExecID");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
-
-	names.emplace_back("Symbol");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
-
-	names.emplace_back("Side");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
-
-	names.emplace_back("ExecType");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
-
-	names.emplace_back("OrdStatus");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
-
-	names.emplace_back("Price");
-	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
-
-	names.emplace_back("OrderQty");
-	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
-
-	names.emplace_back("CumQty");
-	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
-
-	names.emplace_back("LeavesQty");
-	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
-
-	names.emplace_back("LastPx");
-	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
-
-	names.emplace_back("LastQty");
-	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE)); // Numeric
+	// Promote custom tags to value slots so the tokenizer stores them directly
+	for (const auto &tag_pair : result->custom_tags) {
+		result->custom_tag_slots.push_back(result->tag_layout.AddTag(tag_pair.second));
+		auto type = FixFilterValueType::VARCHAR;
+		if (result->typed_tags) {
+			auto field = result->dictionary->fields.find(tag_pair.second);
+			if (field != result->dictionary->fields.end()) {
+				type = GetTypedTagType(field->second.type);
+			}
+		}
+		result->custom_tag_types.push_back(type);
+	}
 
-	names.emplace_back("Text");
-	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	// Define full schema for Phase 4.5 - with proper types
+	ReadFixFunction::AddHotColumns(names, return_types);
 
 	// Phase 5: Non-hot tags
 	names.emplace_back("tags");
@@ -317,8 +790,7 @@ static unique_ptr<FunctionData> ReadFixBind(ClientContext &context, TableFunctio
 
 	// Phase 5: Repeating groups
 	names.emplace_back("groups");
-	return_types.emplace_back(LogicalType::MAP(
-	    LogicalType::INTEGER, LogicalType::LIST(LogicalType::MAP(LogicalType::INTEGER, LogicalType::VARCHAR))));
+	return_types.emplace_back(GetGroupsLogicalType(ReadFixFunction::GROUP_DEPTH));
 
 	names.emplace_back("raw_message");
 	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
@@ -333,17 +805,65 @@ static unique_ptr<FunctionData> ReadFixBind(ClientContext &context, TableFunctio
 	}
 
 	// Phase 7.5: Add custom tag columns (after standard columns)
-	for (const auto &tag_pair : result->custom_tags) {
-		names.emplace_back(tag_pair.first);
-		return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	for (idx_t i = 0; i < result->custom_tags.size(); i++) {
+		names.emplace_back(result->custom_tags[i].first);
+		return_types.emplace_back(GetValueLogicalType(result->custom_tag_types[i]));
 	}
+	result->column_types = return_types;
 
 	return std::move(result);
 }
 
+// End of the last complete line of the file after start, start if there is none
+// The engine may be writing the last line, it is left for the next read_fix_follow
+static idx_t FindLastLineEnd(FileHandle &handle, idx_t start, idx_t file_size) {
+	static constexpr idx_t TAIL_BLOCK_SIZE = 64ULL * 1024ULL;
+	auto block = unique_ptr<char[]>(new char[TAIL_BLOCK_SIZE]);
+	idx_t end = file_size;
+	while (end > start) {
+		idx_t block_start = end - MinValue<idx_t>(end - start, TAIL_BLOCK_SIZE);
+		handle.Read(block.get(), end - block_start, block_start);
+		for (idx_t i = end - block_start; i > 0; i--) {
+			if (block[i - 1] == '\n') {
+				return block_start + i;
+			}
+		}
+		end = block_start;
+	}
+	return start;
+}
+
+// read_fix_follow: read the file up to the end of its last complete line, from the checkpoint unless start_offset
+// is given. Resolved for each scan rather than at bind, a prepared statement binds once and executes many times
+static void ReadFixFollowInitBounds(ClientContext &context, const ReadFixBindData &bind_data,
+                                    ReadFixGlobalState &gstate) {
+	auto &path = bind_data.files[0];
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ | bind_data.compression);
+	if (!handle->CanSeek()) {
+		throw InvalidInputException("read_fix_follow cannot follow \"%s\", it is compressed or not seekable", path);
+	}
+	auto file_size = handle->GetFileSize();
+	auto start = bind_data.resume_from_checkpoint ? bind_data.checkpoint->offset.load() : bind_data.start_offset;
+	if (start > file_size) {
+		// The file was truncated or rotated, start over
+		start = 0;
+	}
+	auto end = FindLastLineEnd(*handle, start, file_size);
+	gstate.scheduler.SetBounds(start, end);
+	gstate.checkpoint_offset = end;
+	gstate.scan_bytes = end - start;
+}
+
 // InitGlobal - initialize global state
 static unique_ptr<GlobalTableFunctionState> ReadFixInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
-	auto result = make_uniq<ReadFixGlobalState>();
+	auto &bind_data = input.bind_data->Cast<ReadFixBindData>();
+	auto result = make_uniq<ReadFixGlobalState>(bind_data);
+	if (!bind_data.checkpoint) {
+		result->scan_bytes = ReadFixEstimateScan(context, bind_data).scan_bytes;
+	} else {
+		ReadFixFollowInitBounds(context, bind_data, *result);
+	}
 
 	// Phase 7.5: Store projection information
 	result->projection_ids = input.projection_ids;
@@ -353,6 +873,116 @@ static unique_ptr<GlobalTableFunctionState> ReadFixInitGlobal(ClientContext &con
 	// Column 19 is tags, Column 20 is groups (0-indexed)
 	result->needs_tags = result->IsColumnNeeded(19);
 	result->needs_groups = result->IsColumnNeeded(20);
+	result->needs_parse_error = result->IsColumnNeeded(22);
+	result->collect_errors = result->needs_parse_error;
+
+	// SET quackfix_profiling = true: count and time the scan for fix_scan_stats() and EXPLAIN ANALYZE
+	Value profiling;
+	if (context.TryGetCurrentSetting(FIX_PROFILING_SETTING, profiling) && !profiling.IsNull() &&
+	    BooleanValue::Get(profiling)) {
+		result->profiling = true;
+		result->collect_errors = true;
+		result->stats_history = FixScanStatsHistory::Get(context);
+		auto &stats = result->stats;
+		stats.function = bind_data.checkpoint ? "read_fix_follow" : "read_fix";
+		stats.query = context.GetCurrentQuery();
+		stats.files = bind_data.files.size();
+		stats.range_size = bind_data.range_size;
+		stats.buffer_size = bind_data.buffer_size;
+		result->start_ns = FixScanCounters::Now();
+	}
+
+	if (result->needs_groups) {
+		result->group_layout = bind_data.group_layout;
+	}
+	for (idx_t i = 0; i < result->column_indexes.size(); i++) {
+		auto col_idx = result->column_indexes[i].GetPrimaryIndex();
+		if (col_idx == 19) {
+			result->tags_output_idx = i;
+		} else if (col_idx == 20) {
+			result->groups_output_idx = i;
+		} else if (col_idx == FIX_COLUMN_FILE_OFFSET) {
+			result->file_offset_output_idx = i;
+		}
+	}
+
+	// The tokenizer can stop as soon as it has seen every projected tag column, unless a projected column
+	// needs the whole message (tags, groups, or parse_error for errors anywhere in the message)
+	auto &options = result->parse_options;
+	options.delimiter = bind_data.delimiter;
+	options.extract_prefix = bind_data.extract_prefix;
+	options.keep_tag_list = result->needs_tags || result->needs_groups;
+	if (!result->needs_tags && !result->needs_groups && !result->needs_parse_error) {
+		idx_t custom_tag_start_idx = bind_data.extract_prefix ? 24 : 23;
+		for (auto &column_index : result->column_indexes) {
+			auto col_idx = column_index.GetPrimaryIndex();
+			if (col_idx < FixHotTags::NUM_HOT_TAGS) {
+				options.RequireSlot(static_cast<uint16_t>(col_idx));
+			} else if (col_idx >= custom_tag_start_idx &&
+			           col_idx - custom_tag_start_idx < bind_data.custom_tag_slots.size()) {
+				options.RequireSlot(bind_data.custom_tag_slots[col_idx - custom_tag_start_idx]);
+			}
+		}
+		// MsgType is needed to validate the message
+		options.RequireSlot(static_cast<uint16_t>(FixHotTags::HotSlot(FixHotTags::MSG_TYPE)));
+		// Messages whose groups may repeat a projected tag are parsed to the end, its last occurrence wins
+		result->group_layout = bind_data.group_layout;
+		options.SetGroupLayout(result->group_layout, bind_data.tag_layout);
+	}
+
+	if (input.filters) {
+		// Hot tag and custom tag columns can be filtered on the parsed message, before the row is written
+		idx_t custom_tag_start_idx = bind_data.extract_prefix ? 24 : 23;
+		vector<FixFilterColumn> filter_columns;
+		vector<LogicalType> filter_types;
+		for (auto &column_index : result->column_indexes) {
+			auto col_idx = column_index.GetPrimaryIndex();
+			FixFilterColumn column;
+			if (col_idx < FixHotTags::NUM_HOT_TAGS) {
+				column.slot = static_cast<uint16_t>(col_idx);
+			} else if (col_idx >= custom_tag_start_idx &&
+			           col_idx - custom_tag_start_idx < bind_data.custom_tag_slots.size()) {
+				column.slot = bind_data.custom_tag_slots[col_idx - custom_tag_start_idx];
+			}
+			if (col_idx >= bind_data.column_types.size()) {
+				filter_columns.push_back(column);
+				filter_types.push_back(col_idx == FIX_COLUMN_FILE_OFFSET ? LogicalType::BIGINT : LogicalType::ROW_TYPE);
+				continue;
+			}
+			auto &type = bind_data.column_types[col_idx];
+			if (column.slot != FixTagLayout::NO_SLOT) {
+				column.tag = bind_data.tag_layout.GetTag(column.slot);
+				switch (type.id()) {
+				case LogicalTypeId::BIGINT:
+					column.type = FixFilterValueType::BIGINT;
+					break;
+				case LogicalTypeId::DOUBLE:
+					column.type = FixFilterValueType::DOUBLE;
+					break;
+				case LogicalTypeId::TIMESTAMP:
+					column.type = FixFilterValueType::TIMESTAMP;
+					break;
+				case LogicalTypeId::BOOLEAN:
+					column.type = FixFilterValueType::BOOLEAN;
+					break;
+				default:
+					column.type = FixFilterValueType::VARCHAR;
+					break;
+				}
+			}
+			filter_columns.push_back(column);
+			filter_types.push_back(type);
+		}
+		result->filter.Initialize(*input.filters, filter_columns, filter_types, bind_data.delimiter);
+	}
+
+	if (bind_data.use_index) {
+		// The filter lives in the global state as long as the scheduler does
+		auto &filter = result->filter;
+		result->scheduler.UseIndex(bind_data.delimiter, [&filter](const FixSparseIndex &index, idx_t block) {
+			return filter.MayMatchBlock(index, block);
+		});
+	}
 
 	return std::move(result);
 }
@@ -360,76 +990,125 @@ static unique_ptr<GlobalTableFunctionState> ReadFixInitGlobal(ClientContext &con
 // InitLocal - initialize local state
 static unique_ptr<LocalTableFunctionState> ReadFixInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
                                                             GlobalTableFunctionState *global_state) {
-	auto result = make_uniq<ReadFixLocalState>();
+	auto &bind_data = input.bind_data->Cast<ReadFixBindData>();
+	auto &gstate = global_state->Cast<ReadFixGlobalState>();
+	auto result = make_uniq<ReadFixLocalState>(bind_data);
+	result->referenced_buffers.resize(gstate.column_indexes.size(), nullptr);
+	auto residual = gstate.filter.GetResidual();
+	if (residual) {
+		result->filter_executor = make_uniq<ExpressionExecutor>(context.client, *residual);
+		result->filter_sel.Initialize(STANDARD_VECTOR_SIZE);
+	}
+	for (auto col_idx : FIX_DICTIONARY_COLUMNS) {
+		for (idx_t i = 0; i < gstate.column_indexes.size(); i++) {
+			if (gstate.column_indexes[i].GetPrimaryIndex() == col_idx) {
+				result->dictionary_columns.emplace_back(i, make_uniq<FixStringDictionary>());
+				result->string_dictionaries[col_idx] = result->dictionary_columns.back().second.get();
+				break;
+			}
+		}
+	}
 	return std::move(result);
 }
 
 // FixColumnWriter method implementations
 void FixColumnWriter::WriteHotTags(const ParsedFixMessage &parsed) {
+	// Error messages are only built when the parse_error column is read or errors are counted
+	auto errors = gstate.collect_errors ? &conversion_errors : nullptr;
+
 	// Helper lambdas for setting field values
-	auto set_string = [&](idx_t schema_col, const char *ptr, size_t len) {
+	auto set_string = [&](idx_t schema_col, const ParsedFixMessage::TagValue &value) {
 		auto out_idx = GetOutputIdx(schema_col);
-		if (out_idx != DConstants::INVALID_INDEX) {
-			SetStringField(output.data[out_idx], row_idx, ptr, len);
+		if (out_idx == DConstants::INVALID_INDEX) {
+			return;
+		}
+		auto dictionary = lstate.string_dictionaries[schema_col];
+		if (dictionary) {
+			dictionary->Add(output.data[out_idx], row_idx, value.data, value.len);
+		} else {
+			SetLineString(out_idx, value.data, value.len);
 		}
 	};
 
-	auto set_int64 = [&](idx_t schema_col, const char *ptr, size_t len, const char *name) {
+	auto set_int64 = [&](idx_t schema_col, const ParsedFixMessage::TagValue &value, const char *name) {
 		auto out_idx = GetOutputIdx(schema_col);
 		if (out_idx != DConstants::INVALID_INDEX) {
 			int64_t val;
-			if (ConvertToInt64(ptr, len, val, conversion_errors, name)) {
-				output.data[out_idx].SetValue(row_idx, Value::BIGINT(val));
+			if (ConvertToInt64(value.data, value.len, val, errors, name)) {
+				SetFlatField(output.data[out_idx], row_idx, val);
 			} else {
-				output.data[out_idx].SetValue(row_idx, Value());
+				SetNullField(output.data[out_idx], row_idx);
 			}
 		}
 	};
 
-	auto set_double = [&](idx_t schema_col, const char *ptr, size_t len, const char *name) {
+	auto set_double = [&](idx_t schema_col, const ParsedFixMessage::TagValue &value, const char *name) {
 		auto out_idx = GetOutputIdx(schema_col);
 		if (out_idx != DConstants::INVALID_INDEX) {
 			double val;
-			if (ConvertToDouble(ptr, len, val, conversion_errors, name)) {
-				output.data[out_idx].SetValue(row_idx, Value::DOUBLE(val));
+			if (ConvertToDouble(value.data, value.len, val, errors, name)) {
+				SetFlatField(output.data[out_idx], row_idx, val);
 			} else {
-				output.data[out_idx].SetValue(row_idx, Value());
+				SetNullField(output.data[out_idx], row_idx);
 			}
 		}
 	};
 
-	auto set_timestamp = [&](idx_t schema_col, const char *ptr, size_t len, const char *name) {
+	auto set_timestamp = [&](idx_t schema_col, const ParsedFixMessage::TagValue &value, const char *name) {
 		auto out_idx = GetOutputIdx(schema_col);
 		if (out_idx != DConstants::INVALID_INDEX) {
 			timestamp_t ts;
-			if (ConvertToTimestamp(ptr, len, ts, conversion_errors, name)) {
-				output.data[out_idx].SetValue(row_idx, Value::TIMESTAMP(ts));
+			if (ConvertToTimestamp(value.data, value.len, ts, errors, name)) {
+				SetFlatField(output.data[out_idx], row_idx, ts);
 			} else {
-				output.data[out_idx].SetValue(row_idx, Value());
+				SetNullField(output.data[out_idx], row_idx);
 			}
 		}
 	};
 
-	// Write all 19 hot tag columns (0-18)
-	set_string(0, parsed.msg_type, parsed.msg_type_len);
-	set_string(1, parsed.sender_comp_id, parsed.sender_comp_id_len);
-	set_string(2, parsed.target_comp_id, parsed.target_comp_id_len);
-	set_int64(3, parsed.msg_seq_num, parsed.msg_seq_num_len, "MsgSeqNum");
-	set_timestamp(4, parsed.sending_time, parsed.sending_time_len, "SendingTime");
-	set_string(5, parsed.cl_ord_id, parsed.cl_ord_id_len);
-	set_string(6, parsed.order_id, parsed.order_id_len);
-	set_string(7, parsed.exec_id, parsed.exec_id_len);
-	set_string(8, parsed.symbol, parsed.symbol_len);
-	set_string(9, parsed.side, parsed.side_len);
-	set_string(10, parsed.exec_type, parsed.exec_type_len);
-	set_string(11, parsed.ord_status, parsed.ord_status_len);
-	set_double(12, parsed.price, parsed.price_len, "Price");
-	set_double(13, parsed.order_qty, parsed.order_qty_len, "OrderQty");
-	set_double(14, parsed.cum_qty, parsed.cum_qty_len, "CumQty");
-	set_double(15, parsed.leaves_qty, parsed.leaves_qty_len, "LeavesQty");
-	set_double(16, parsed.last_px, parsed.last_px_len, "LastPx");
-	set_double(17, parsed.last_qty, parsed.last_qty_len, "LastQty");
-	set_string(18, parsed.text, parsed.text_len);
+	// Write all 19 hot tag columns (0-18) from their slots
+	set_string(0, parsed.Hot<FixHotTags::MSG_TYPE>());
+	set_string(1, parsed.Hot<FixHotTags::SENDER_COMP_ID>());
+	set_string(2, parsed.Hot<FixHotTags::TARGET_COMP_ID>());
+	set_int64(3, parsed.Hot<FixHotTags::MSG_SEQ_NUM>(), "MsgSeqNum");
+	set_timestamp(4, parsed.Hot<FixHotTags::SENDING_TIME>(), "SendingTime");
+	set_string(5, parsed.Hot<FixHotTags::CL_ORD_ID>());
+	set_string(6, parsed.Hot<FixHotTags::ORDER_ID>());
+	set_string(7, parsed.Hot<FixHotTags::EXEC_ID>());
+	set_string(8, parsed.Hot<FixHotTags::SYMBOL>());
+	set_string(9, parsed.Hot<FixHotTags::SIDE>());
+	set_string(10, parsed.Hot<FixHotTags::EXEC_TYPE>());
+	set_string(11, parsed.Hot<FixHotTags::ORD_STATUS>());
+	set_double(12, parsed.Hot<FixHotTags::PRICE>(), "Price");
+	set_double(13, parsed.Hot<FixHotTags::ORDER_QTY>(), "OrderQty");
+	set_double(14, parsed.Hot<FixHotTags::CUM_QTY>(), "CumQty");
+	set_double(15, parsed.Hot<FixHotTags::LEAVES_QTY>(), "LeavesQty");
+	set_double(16, parsed.Hot<FixHotTags::LAST_PX>(), "LastPx");
+	set_double(17, parsed.Hot<FixHotTags::LAST_QTY>(), "LastQty");
+	set_string(18, parsed.Hot<FixHotTags::TEXT>());
+}
+
+// Append count (tag, value) pairs to a MAP(INTEGER, VARCHAR) vector as the entry of row
+// get_tag(i) returns the i-th pair of the ordered tag list to append
+template <class GET_TAG>
+static void AppendTagMap(Vector &map_vec, idx_t row, idx_t count, GET_TAG &&get_tag) {
+	auto offset = ListVector::GetListSize(map_vec);
+	ListVector::Reserve(map_vec, offset + count);
+
+	auto &key_vec = MapVector::GetKeys(map_vec);
+	auto &value_vec = MapVector::GetValues(map_vec);
+	auto keys = FlatVector::GetData<int32_t>(key_vec);
+	auto values = FlatVector::GetData<string_t>(value_vec);
+	for (idx_t i = 0; i < count; i++) {
+		auto &tag = get_tag(i);
+		keys[offset + i] = tag.first;
+		values[offset + i] = StringVector::AddString(value_vec, tag.second.data, tag.second.len);
+	}
+	ListVector::SetListSize(map_vec, offset + count);
+
+	auto &entry = ListVector::GetData(map_vec)[row];
+	entry.offset = offset;
+	entry.length = count;
 }
 
 void FixColumnWriter::WriteTagsMap(const ParsedFixMessage &parsed) {
@@ -438,24 +1117,26 @@ void FixColumnWriter::WriteTagsMap(const ParsedFixMessage &parsed) {
 		return;
 	}
 
-	if (!gstate.needs_tags || parsed.other_tags.empty()) {
-		output.data[out_idx].SetValue(row_idx, Value());
+	auto &tags_vec = output.data[out_idx];
+	if (!gstate.needs_tags || parsed.other_tag_count == 0) {
+		SetNullField(tags_vec, row_idx);
 		return;
 	}
 
-	// Build MAP(INTEGER, VARCHAR) from other_tags
-	vector<Value> map_entries;
-	for (const auto &entry : parsed.other_tags) {
-		child_list_t<Value> map_struct;
-		map_struct.push_back(make_pair("key", Value::INTEGER(entry.first)));
-		string tag_value_str(entry.second.data, entry.second.len);
-		map_struct.push_back(make_pair("value", Value(tag_value_str)));
-		map_entries.push_back(Value::STRUCT(map_struct));
+	// MAP keys must be unique: repeated tags (e.g. inside groups) keep their last value
+	auto &ordered_tags = parsed.all_tags_ordered;
+	auto &tag_index = lstate.tag_index;
+	tag_index.Reset(parsed.other_tag_count);
+	for (idx_t i = 0; i < ordered_tags.size(); i++) {
+		if (!bind_data.tag_layout.IsHotTag(ordered_tags[i].first)) {
+			tag_index.Insert(ordered_tags[i].first, static_cast<uint32_t>(i));
+		}
 	}
 
-	auto map_type = LogicalType::MAP(LogicalType::INTEGER, LogicalType::VARCHAR);
-	auto child_type = ListType::GetChildType(map_type);
-	output.data[out_idx].SetValue(row_idx, Value::MAP(child_type, map_entries));
+	// Build MAP(INTEGER, VARCHAR) of the non-hot tags directly in the child vectors
+	auto &positions = tag_index.Positions();
+	AppendTagMap(tags_vec, row_idx, positions.size(),
+	             [&](idx_t i) -> const pair<int, ParsedFixMessage::TagValue> & { return ordered_tags[positions[i]]; });
 }
 
 void FixColumnWriter::WriteGroupsMap(const ParsedFixMessage &parsed) {
@@ -464,31 +1145,99 @@ void FixColumnWriter::WriteGroupsMap(const ParsedFixMessage &parsed) {
 		return;
 	}
 
-	Value groups_value = FixGroupParser::ParseGroups(parsed, *bind_data.dictionary, gstate.needs_groups);
-	output.data[out_idx].SetValue(row_idx, groups_value);
+	auto &groups_vec = output.data[out_idx];
+	auto &parsed_groups = lstate.parsed_groups;
+	if (!gstate.needs_groups || !FixGroupParser::ParseGroups(parsed, *gstate.group_layout, parsed_groups)) {
+		SetNullField(groups_vec, row_idx);
+		return;
+	}
+	AppendGroups(groups_vec, row_idx, 0, parsed_groups.message_group_count, ReadFixFunction::GROUP_DEPTH, parsed);
 }
 
-void FixColumnWriter::WriteMetadata(const string &raw_line) {
+void FixColumnWriter::AppendGroups(Vector &groups_vec, idx_t row, size_t begin, size_t count, idx_t depth,
+                                   const ParsedFixMessage &parsed) {
+	auto &parsed_groups = lstate.parsed_groups;
+
+	// Outer MAP(count tag -> LIST of instances), one entry per group
+	auto group_offset = ListVector::GetListSize(groups_vec);
+	ListVector::Reserve(groups_vec, group_offset + count);
+	auto count_tags = FlatVector::GetData<int32_t>(MapVector::GetKeys(groups_vec));
+	auto &instance_list_vec = MapVector::GetValues(groups_vec);
+
+	// The instances of the groups are contiguous, one STRUCT(fields, groups) entry each
+	auto first_instance = parsed_groups.groups[begin].instance_begin;
+	auto &last_group = parsed_groups.groups[begin + count - 1];
+	auto instance_count = last_group.instance_begin + last_group.instance_count - first_instance;
+	auto instance_offset = ListVector::GetListSize(instance_list_vec);
+	ListVector::Reserve(instance_list_vec, instance_offset + instance_count);
+	auto instance_lists = ListVector::GetData(instance_list_vec);
+	for (idx_t g = 0; g < count; g++) {
+		auto &group = parsed_groups.groups[begin + g];
+		count_tags[group_offset + g] = group.count_tag;
+		instance_lists[group_offset + g].offset = instance_offset + group.instance_begin - first_instance;
+		instance_lists[group_offset + g].length = group.instance_count;
+	}
+	ListVector::SetListSize(instance_list_vec, instance_offset + instance_count);
+	ListVector::SetListSize(groups_vec, group_offset + count);
+
+	auto &entries = StructVector::GetEntries(ListVector::GetEntry(instance_list_vec));
+	auto &ordered_tags = parsed.all_tags_ordered;
+	for (idx_t i = 0; i < instance_count; i++) {
+		auto &instance = parsed_groups.instances[first_instance + i];
+		AppendTagMap(*entries[0], instance_offset + i, instance.end - instance.begin,
+		             [&](idx_t t) -> const pair<int, ParsedFixMessage::TagValue> & {
+			             return ordered_tags[parsed_groups.fields[instance.begin + t]];
+		             });
+		if (depth <= 1) {
+			continue; // Nested deeper than the column type, left out
+		}
+		if (instance.group_count == 0) {
+			SetNullField(*entries[1], instance_offset + i);
+		} else {
+			AppendGroups(*entries[1], instance_offset + i, instance.group_begin, instance.group_count, depth - 1,
+			             parsed);
+		}
+	}
+
+	auto &entry = ListVector::GetData(groups_vec)[row];
+	entry.offset = group_offset;
+	entry.length = count;
+}
+
+void FixColumnWriter::SetLineString(idx_t out_idx, const char *ptr, idx_t len) {
+	auto &column = output.data[out_idx];
+	if (line_buffer && len > string_t::INLINE_LENGTH) {
+		// Referenced in the read buffer instead of being copied, the vector keeps the buffer alive
+		auto &referenced = lstate.referenced_buffers[out_idx];
+		if (referenced != line_buffer.get()) {
+			StringVector::AddBuffer(column, line_buffer);
+			referenced = line_buffer.get();
+		}
+		FlatVector::GetData<string_t>(column)[row_idx] = string_t(ptr, static_cast<uint32_t>(len));
+	} else {
+		SetStringField(column, row_idx, ptr, len);
+	}
+}
+
+void FixColumnWriter::WriteMetadata(const char *raw_line, idx_t raw_line_len) {
 	// raw_message column (21)
 	auto out_idx = GetOutputIdx(21);
 	if (out_idx != DConstants::INVALID_INDEX) {
-		output.data[out_idx].SetValue(row_idx, Value(raw_line));
+		SetLineString(out_idx, raw_line, raw_line_len);
 	}
 
 	// parse_error column (22)
 	out_idx = GetOutputIdx(22);
 	if (out_idx != DConstants::INVALID_INDEX) {
-		if (conversion_errors.empty()) {
-			output.data[out_idx].SetValue(row_idx, Value());
+		auto &column = output.data[out_idx];
+		if (conversion_errors.Empty()) {
+			SetNullField(column, row_idx);
 		} else {
-			string combined_error;
-			for (size_t i = 0; i < conversion_errors.size(); i++) {
-				if (i > 0) {
-					combined_error += "; ";
-				}
-				combined_error += conversion_errors[i];
-			}
-			output.data[out_idx].SetValue(row_idx, Value(combined_error));
+			// The error records are formatted straight into the vector's string heap
+			auto message = StringVector::EmptyString(column, conversion_errors.FormattedLength());
+			conversion_errors.Format(message.GetDataWriteable());
+			message.Finalize();
+			FlatVector::GetData<string_t>(column)[row_idx] = message;
 		}
 	}
 }
@@ -506,176 +1255,346 @@ void FixColumnWriter::WritePrefix(const ParsedFixMessage &parsed) {
 void FixColumnWriter::WriteCustomTags(const ParsedFixMessage &parsed) {
 	// Custom tags start after prefix column (if enabled)
 	idx_t custom_tag_start_idx = bind_data.extract_prefix ? 24 : 23;
+	auto errors = gstate.collect_errors ? &conversion_errors : nullptr;
 
 	for (size_t i = 0; i < bind_data.custom_tags.size(); i++) {
-		const auto &tag_pair = bind_data.custom_tags[i];
-		const string &tag_name = tag_pair.first;
-		int tag_num = tag_pair.second;
 		auto out_idx = GetOutputIdx(custom_tag_start_idx + i);
 
 		if (out_idx == DConstants::INVALID_INDEX) {
 			continue;
 		}
 
-		// Find value in hot tags first, then other_tags
-		const char *value_ptr = nullptr;
-		size_t value_len = 0;
-
-		// Check if this is a hot tag - using centralized FixHotTags constants
-		switch (tag_num) {
-		case duckdb::FixHotTags::MSG_TYPE:
-			value_ptr = parsed.msg_type;
-			value_len = parsed.msg_type_len;
-			break;
-		case duckdb::FixHotTags::SENDER_COMP_ID:
-			value_ptr = parsed.sender_comp_id;
-			value_len = parsed.sender_comp_id_len;
-			break;
-		case duckdb::FixHotTags::TARGET_COMP_ID:
-			value_ptr = parsed.target_comp_id;
-			value_len = parsed.target_comp_id_len;
-			break;
-		case duckdb::FixHotTags::MSG_SEQ_NUM:
-			value_ptr = parsed.msg_seq_num;
-			value_len = parsed.msg_seq_num_len;
-			break;
-		case duckdb::FixHotTags::SENDING_TIME:
-			value_ptr = parsed.sending_time;
-			value_len = parsed.sending_time_len;
-			break;
-		case duckdb::FixHotTags::CL_ORD_ID:
-			value_ptr = parsed.cl_ord_id;
-			value_len = parsed.cl_ord_id_len;
-			break;
-		case duckdb::FixHotTags::ORDER_ID:
-			value_ptr = parsed.order_id;
-			value_len = parsed.order_id_len;
-			break;
-		case duckdb::FixHotTags::EXEC_ID:
-			value_ptr = parsed.exec_id;
-			value_len = parsed.exec_id_len;
-			break;
-		case duckdb::FixHotTags::SYMBOL:
-			value_ptr = parsed.symbol;
-			value_len = parsed.symbol_len;
-			break;
-		case duckdb::FixHotTags::SIDE:
-			value_ptr = parsed.side;
-			value_len = parsed.side_len;
-			break;
-		case duckdb::FixHotTags::EXEC_TYPE:
-			value_ptr = parsed.exec_type;
-			value_len = parsed.exec_type_len;
-			break;
-		case duckdb::FixHotTags::ORD_STATUS:
-			value_ptr = parsed.ord_status;
-			value_len = parsed.ord_status_len;
-			break;
-		case duckdb::FixHotTags::PRICE:
-			value_ptr = parsed.price;
-			value_len = parsed.price_len;
-			break;
-		case duckdb::FixHotTags::ORDER_QTY:
-			value_ptr = parsed.order_qty;
-			value_len = parsed.order_qty_len;
-			break;
-		case duckdb::FixHotTags::CUM_QTY:
-			value_ptr = parsed.cum_qty;
-			value_len = parsed.cum_qty_len;
-			break;
-		case duckdb::FixHotTags::LEAVES_QTY:
-			value_ptr = parsed.leaves_qty;
-			value_len = parsed.leaves_qty_len;
+		// Custom tags are promoted to slots at bind time, typed tags use the hot tag converters
+		auto &value = parsed.GetSlot(bind_data.custom_tag_slots[i]);
+		auto &column = output.data[out_idx];
+		auto name = bind_data.custom_tags[i].first.c_str();
+		switch (bind_data.custom_tag_types[i]) {
+		case FixFilterValueType::BIGINT: {
+			int64_t val;
+			if (ConvertToInt64(value.data, value.len, val, errors, name)) {
+				SetFlatField(column, row_idx, val);
+			} else {
+				SetNullField(column, row_idx);
+			}
 			break;
-		case duckdb::FixHotTags::LAST_PX:
-			value_ptr = parsed.last_px;
-			value_len = parsed.last_px_len;
+		}
+		case FixFilterValueType::DOUBLE: {
+			double val;
+			if (ConvertToDouble(value.data, value.len, val, errors, name)) {
+				SetFlatField(column, row_idx, val);
+			} else {
+				SetNullField(column, row_idx);
+			}
 			break;
-		case duckdb::FixHotTags::LAST_QTY:
-			value_ptr = parsed.last_qty;
-			value_len = parsed.last_qty_len;
+		}
+		case FixFilterValueType::TIMESTAMP: {
+			timestamp_t val;
+			if (ConvertToTimestamp(value.data, value.len, val, errors, name)) {
+				SetFlatField(column, row_idx, val);
+			} else {
+				SetNullField(column, row_idx);
+			}
 			break;
-		case duckdb::FixHotTags::TEXT:
-			value_ptr = parsed.text;
-			value_len = parsed.text_len;
+		}
+		case FixFilterValueType::BOOLEAN: {
+			bool val;
+			if (ConvertToBoolean(value.data, value.len, val, errors, name)) {
+				SetFlatField(column, row_idx, val);
+			} else {
+				SetNullField(column, row_idx);
+			}
 			break;
+		}
 		default:
-			// Not a hot tag, check other_tags
-			auto it = parsed.other_tags.find(tag_num);
-			if (it != parsed.other_tags.end()) {
-				value_ptr = it->second.data;
-				value_len = it->second.len;
-			}
+			SetLineString(out_idx, value.data, value.len);
 			break;
 		}
-
-		SetStringField(output.data[out_idx], row_idx, value_ptr, value_len);
 	}
 }
 
-// Scan function - called repeatedly to fill DataChunks
-static void ReadFixScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
-	auto &bind_data = data_p.bind_data->Cast<ReadFixBindData>();
-	auto &gstate = data_p.global_state->Cast<ReadFixGlobalState>();
-	auto &lstate = data_p.local_state->Cast<ReadFixLocalState>();
+void FixColumnWriter::WriteFileOffset(idx_t offset) {
+	if (gstate.file_offset_output_idx != DConstants::INVALID_INDEX) {
+		SetFlatField(output.data[gstate.file_offset_output_idx], row_idx, static_cast<int64_t>(offset));
+	}
+}
 
+// Read lines into output until it is full or the current range ends
+static void ReadFixFillChunk(ClientContext &context, const ReadFixBindData &bind_data, ReadFixGlobalState &gstate,
+                             ReadFixLocalState &lstate, DataChunk &output) {
 	idx_t output_idx = 0;
+	auto &fs = FileSystem::GetFileSystem(context);
 
-	// Open file if needed using FixFileReader
-	if (!lstate.file_reader.IsOpen()) {
-		auto &fs = FileSystem::GetFileSystem(context);
-		if (!lstate.file_reader.OpenNextFile(fs, bind_data.files, gstate.file_index, gstate.lock)) {
-			// No more files
-			output.SetCardinality(0);
-			return;
-		}
+	// Read and parse lines using FixFileReader
+	// A chunk never mixes rows of two ranges, so that each chunk maps to a single batch index
+	const char *line;
+	idx_t line_len;
+
+	// Size the MAP child vectors once per chunk from what the previous chunk needed
+	Vector *tags_entries = nullptr;
+	Vector *group_entries = nullptr;
+	if (gstate.needs_tags && gstate.tags_output_idx != DConstants::INVALID_INDEX) {
+		tags_entries = &output.data[gstate.tags_output_idx];
+		ListVector::Reserve(*tags_entries, lstate.tags_entries_hint);
+	}
+	if (gstate.needs_groups && gstate.groups_output_idx != DConstants::INVALID_INDEX) {
+		auto &instances = ListVector::GetEntry(MapVector::GetValues(output.data[gstate.groups_output_idx]));
+		group_entries = StructVector::GetEntries(instances)[0].get();
+		ListVector::Reserve(*group_entries, lstate.group_entries_hint);
 	}
+	for (auto &column : lstate.dictionary_columns) {
+		column.second->Reset();
+	}
+	std::fill(lstate.referenced_buffers.begin(), lstate.referenced_buffers.end(), nullptr);
+
+	// Phase timings for quackfix_profiling, each lap adds the time since the previous one to a phase
+	auto &counters = lstate.counters;
+	FixPhaseTimer timer(gstate.profiling);
 
-	// Read and parse lines using FixFileReader
-	string line;
 	while (output_idx < STANDARD_VECTOR_SIZE) {
-		if (!lstate.file_reader.ReadLine(line)) {
-			// End of file, close and try next file
-			lstate.file_reader.Close();
+		if (!lstate.file_reader.IsOpen()) {
+			if (!lstate.file_reader.OpenNextRange(fs, gstate.scheduler)) {
+				// No more ranges
+				gstate.FinishScheduling();
+				timer.Lap(counters.read_ns);
+				break;
+			}
+		}
 
-			auto &fs = FileSystem::GetFileSystem(context);
-			if (!lstate.file_reader.OpenNextFile(fs, bind_data.files, gstate.file_index, gstate.lock)) {
-				// No more files
+		if (!lstate.file_reader.ReadLine(line, line_len)) {
+			// End of range, emit what we have before moving on to the next range
+			lstate.file_reader.Close();
+			gstate.CompleteRange();
+			timer.Lap(counters.read_ns);
+			if (output_idx > 0) {
 				break;
 			}
 			continue;
 		}
+		timer.Lap(counters.read_ns);
+		counters.lines_read++;
 
-		// Skip empty lines
-		if (line.empty()) {
+		// Skip empty lines, and lines the pushed filters reject on their raw bytes
+		if (line_len == 0) {
+			continue;
+		}
+		auto may_match = gstate.filter.MayMatch(line, line_len);
+		timer.Lap(counters.filter_ns);
+		if (!may_match) {
 			continue;
 		}
 
-		// Parse FIX message
-		ParsedFixMessage parsed;
-		FixTokenizer::Parse(line.c_str(), line.size(), parsed, bind_data.delimiter, bind_data.extract_prefix);
+		// Parse FIX message into the thread's reusable message
+		auto &parsed = lstate.parsed;
+		FixTokenizer::Parse(line, line_len, parsed, gstate.parse_options);
+		timer.Lap(counters.tokenize_ns);
+		counters.messages_parsed++;
+		if (parsed.parse_error) {
+			counters.parse_errors++;
+		}
+		auto matches = gstate.filter.Matches(parsed);
+		timer.Lap(counters.filter_ns);
+		if (!matches) {
+			continue;
+		}
 
 		// Initialize error collection
-		vector<string> conversion_errors;
-		if (!parsed.parse_error.empty()) {
-			conversion_errors.push_back(parsed.parse_error);
+		auto &conversion_errors = lstate.conversion_errors;
+		conversion_errors.Clear();
+		if (parsed.parse_error) {
+			conversion_errors.AddMessage(parsed.parse_error);
 		}
 
 		// Use FixColumnWriter helper to write all columns
-		FixColumnWriter writer(output, output_idx, bind_data, gstate, conversion_errors);
+		FixColumnWriter writer(output, output_idx, bind_data, gstate, lstate);
 		writer.WriteHotTags(parsed);
 		writer.WriteTagsMap(parsed);
+		timer.Lap(counters.materialize_ns);
 		writer.WriteGroupsMap(parsed);
-		writer.WriteMetadata(line);
+		timer.Lap(counters.groups_ns);
 		writer.WritePrefix(parsed);
 		writer.WriteCustomTags(parsed);
+		writer.WriteFileOffset(lstate.file_reader.GetLineOffset());
+		// Last, so that parse_error includes the conversion errors of every column
+		writer.WriteMetadata(line, line_len);
+		timer.Lap(counters.materialize_ns);
+		counters.conversion_errors += conversion_errors.Count() - (parsed.parse_error ? 1 : 0);
 
 		output_idx++;
 	}
 
+	if (tags_entries) {
+		lstate.tags_entries_hint = ListVector::GetListSize(*tags_entries);
+	}
+	if (group_entries) {
+		lstate.group_entries_hint = ListVector::GetListSize(*group_entries);
+	}
+	for (auto &column : lstate.dictionary_columns) {
+		column.second->Finish(output.data[column.first], output_idx);
+	}
+	timer.Lap(counters.materialize_ns);
+
 	output.SetCardinality(output_idx);
 }
 
+// Add the counters of a thread to the scan's totals, once per chunk so that a scan stopped early (LIMIT) has
+// counted everything it read
+static void ReadFixAddCounters(ReadFixGlobalState &gstate, ReadFixLocalState &lstate) {
+	auto &counters = lstate.counters;
+	lock_guard<mutex> guard(gstate.stats_lock);
+	if (!lstate.counted_thread && lstate.counted_bytes > 0) {
+		lstate.counted_thread = true;
+		gstate.stats.threads++;
+	}
+	gstate.stats.counters.Add(counters);
+	gstate.stats.wall_ns = FixScanCounters::Now() - gstate.start_ns;
+	counters = FixScanCounters();
+}
+
+// Scan function - called repeatedly to fill DataChunks
+static void ReadFixScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<ReadFixBindData>();
+	auto &gstate = data_p.global_state->Cast<ReadFixGlobalState>();
+	auto &lstate = data_p.local_state->Cast<ReadFixLocalState>();
+
+	while (true) {
+		ReadFixFillChunk(context, bind_data, gstate, lstate, output);
+		if (!lstate.filter_executor || output.size() == 0) {
+			break;
+		}
+
+		// Pushed filters that were not compiled are evaluated on the chunk
+		FixPhaseTimer timer(gstate.profiling);
+		auto count = output.size();
+		auto selected = lstate.filter_executor->SelectExpression(output, lstate.filter_sel);
+		timer.Lap(lstate.counters.filter_ns);
+		if (selected == count) {
+			break;
+		}
+		if (selected > 0) {
+			output.Slice(lstate.filter_sel, selected);
+			break;
+		}
+		// An empty chunk ends the scan, so keep reading until a row passes or the input is exhausted
+		output.Reset();
+	}
+
+	// Bytes read since the previous chunk, for the progress bar and the profiling counters
+	auto bytes_read = lstate.file_reader.GetBytesRead();
+	auto new_bytes = bytes_read - lstate.counted_bytes;
+	lstate.counted_bytes = bytes_read;
+	gstate.bytes_read += new_bytes;
+
+	if (gstate.profiling) {
+		lstate.counters.bytes_read += new_bytes;
+		lstate.counters.rows_emitted += output.size();
+		ReadFixAddCounters(gstate, lstate);
+	}
+}
+
+// Estimated rows, exact (also the maximum) when every file has a sidecar index
+static unique_ptr<NodeStatistics> ReadFixCardinality(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &estimate = ReadFixEstimateScan(context, bind_data_p->Cast<ReadFixBindData>());
+	if (estimate.exact_rows) {
+		return make_uniq<NodeStatistics>(estimate.rows, estimate.rows);
+	}
+	if (estimate.scan_bytes == 0) {
+		// Only pipes, or nothing to read
+		return make_uniq<NodeStatistics>();
+	}
+	return make_uniq<NodeStatistics>(estimate.rows);
+}
+
+// Progress in percent: bytes read, plus the blocks the sidecar indexes skipped, over the bytes of all files
+static double ReadFixProgress(ClientContext &context, const FunctionData *bind_data_p,
+                              const GlobalTableFunctionState *global_state) {
+	auto &bind_data = bind_data_p->Cast<ReadFixBindData>();
+	auto &gstate = global_state->Cast<ReadFixGlobalState>();
+	if (gstate.scan_bytes == 0) {
+		return -1;
+	}
+	auto done = static_cast<double>(gstate.bytes_read + gstate.scheduler.GetSkippedBytes());
+	return MinValue<double>(100.0 * done / static_cast<double>(gstate.scan_bytes), 100.0);
+}
+
+// EXPLAIN ANALYZE extra info: the scan's totals so far (with quackfix_profiling)
+static InsertionOrderPreservingMap<string> ReadFixDynamicToString(TableFunctionDynamicToStringInput &input) {
+	InsertionOrderPreservingMap<string> result;
+	if (!input.global_state) {
+		return result;
+	}
+	auto &gstate = input.global_state->Cast<ReadFixGlobalState>();
+	if (!gstate.profiling) {
+		return result;
+	}
+	lock_guard<mutex> guard(gstate.stats_lock);
+	auto &counters = gstate.stats.counters;
+	auto milliseconds = [](idx_t ns) {
+		return StringUtil::Format("%.3fms", static_cast<double>(ns) / 1e6);
+	};
+	result["Threads"] = std::to_string(gstate.stats.threads);
+	result["Bytes Read"] = std::to_string(counters.bytes_read);
+	result["Lines Read"] = std::to_string(counters.lines_read);
+	result["Messages Parsed"] = std::to_string(counters.messages_parsed);
+	result["Parse Errors"] = std::to_string(counters.parse_errors);
+	result["Conversion Errors"] = std::to_string(counters.conversion_errors);
+	result["Read Time"] = milliseconds(counters.read_ns);
+	result["Filter Time"] = milliseconds(counters.filter_ns);
+	result["Tokenize Time"] = milliseconds(counters.tokenize_ns);
+	result["Groups Time"] = milliseconds(counters.groups_ns);
+	result["Materialize Time"] = milliseconds(counters.materialize_ns);
+	return result;
+}
+
+// Partition data - each byte range is its own batch so insertion order can be preserved
+static OperatorPartitionData ReadFixGetPartitionData(ClientContext &context, TableFunctionGetPartitionInput &input) {
+	if (input.partition_info.RequiresPartitionColumns()) {
+		throw InternalException("read_fix: partition columns not supported");
+	}
+	auto &lstate = input.local_state->Cast<ReadFixLocalState>();
+	return OperatorPartitionData(lstate.file_reader.GetBatchIndex());
+}
+
+// Virtual columns - file_offset can be selected but is not part of SELECT *
+static virtual_column_map_t ReadFixGetVirtualColumns(ClientContext &context, optional_ptr<FunctionData> bind_data) {
+	virtual_column_map_t result;
+	result.insert(make_pair(FIX_COLUMN_FILE_OFFSET, TableColumn("file_offset", LogicalType::BIGINT)));
+	result.insert(make_pair(COLUMN_IDENTIFIER_EMPTY, TableColumn("", LogicalType::BOOLEAN)));
+	return result;
+}
+
+// read_fix_follow bind - read_fix over the messages appended to a file since its checkpoint
+static unique_ptr<FunctionData> ReadFixFollowBind(ClientContext &context, TableFunctionBindInput &input,
+                                                  vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = ReadFixBind(context, input, return_types, names);
+	auto &bind_data = result->Cast<ReadFixBindData>();
+	if (bind_data.files.size() != 1) {
+		throw BinderException("read_fix_follow reads a single file, \"%s\" matches %llu files",
+		                      StringValue::Get(input.inputs[0]), bind_data.files.size());
+	}
+	if (bind_data.framing != FixFraming::LINES) {
+		throw BinderException("read_fix_follow only supports framing 'lines'");
+	}
+	// An index of a growing file is out of date
+	bind_data.use_index = false;
+
+	auto &path = bind_data.files[0];
+	string name = path;
+	if (input.named_parameters.find("checkpoint") != input.named_parameters.end()) {
+		name = StringValue::Get(input.named_parameters.at("checkpoint"));
+	}
+	auto &cache = ObjectCache::GetObjectCache(context);
+	auto key = FIX_FOLLOW_CHECKPOINT_PREFIX + name;
+	auto checkpoint = cache.Get<FixFollowCheckpoint>(key);
+	if (!checkpoint) {
+		checkpoint = make_shared_ptr<FixFollowCheckpoint>();
+		cache.Put(key, checkpoint);
+	}
+	// start_offset overrides the checkpoint, e.g. one saved before a restart (see fix_follow_checkpoint)
+	bind_data.resume_from_checkpoint = input.named_parameters.find("start_offset") == input.named_parameters.end();
+	bind_data.checkpoint = std::move(checkpoint);
+	return result;
+}
+
 // Get the table function definition
 TableFunction ReadFixFunction::GetFunction() {
 	TableFunction func("read_fix", {LogicalType(LogicalTypeId::VARCHAR)}, ReadFixScan, ReadFixBind, ReadFixInitGlobal,
@@ -685,6 +1604,20 @@ TableFunction ReadFixFunction::GetFunction() {
 	// Phase 7.5: Enable projection pushdown
 	func.projection_pushdown = true;
 
+	// Filters on tag columns are applied while scanning (see FixScanFilter)
+	func.filter_pushdown = true;
+
+	// Parallel scans over byte ranges
+	func.get_partition_data = ReadFixGetPartitionData;
+	func.get_virtual_columns = ReadFixGetVirtualColumns;
+
+	// Scan counters in EXPLAIN ANALYZE (with quackfix_profiling)
+	func.dynamic_to_string = ReadFixDynamicToString;
+
+	// Row estimate for the optimizer, progress bar
+	func.cardinality = ReadFixCardinality;
+	func.table_scan_progress = ReadFixProgress;
+
 	// Phase 7.5: Custom tag parameters
 	func.named_parameters["rtags"] = LogicalType::LIST(LogicalType(LogicalTypeId::VARCHAR));  // Tag names
 	func.named_parameters["tagIds"] = LogicalType::LIST(LogicalType(LogicalTypeId::INTEGER)); // Tag numbers
@@ -698,6 +1631,64 @@ TableFunction ReadFixFunction::GetFunction() {
 	// Prefix extraction parameter
 	func.named_parameters["prefix"] = LogicalType(LogicalTypeId::BOOLEAN);
 
+	// Parallel scan range size (e.g. '64MB')
+	func.named_parameters["range_size"] = LogicalType(LogicalTypeId::VARCHAR);
+
+	// Read buffer size (e.g. '16MB')
+	func.named_parameters["buffer_size"] = LogicalType(LogicalTypeId::VARCHAR);
+
+	// Sidecar index usage (default true)
+	func.named_parameters["use_index"] = LogicalType(LogicalTypeId::BOOLEAN);
+
+	// Background read-ahead (default: remote files only)
+	func.named_parameters["prefetch"] = LogicalType(LogicalTypeId::BOOLEAN);
+
+	// Input compression (default 'auto')
+	func.named_parameters["compression"] = LogicalType(LogicalTypeId::VARCHAR);
+
+	// Dictionary-typed custom tag columns (default false)
+	func.named_parameters["typed_tags"] = LogicalType(LogicalTypeId::BOOLEAN);
+
+	// Message framing (default 'lines')
+	func.named_parameters["framing"] = LogicalType(LogicalTypeId::VARCHAR);
+
+	// Skip to the first message at or after this byte offset
+	func.named_parameters["start_offset"] = LogicalType(LogicalTypeId::BIGINT);
+
+	return func;
+}
+
+TableFunction ReadFixFunction::GetFollowFunction() {
+	// Same scan and parameters, the bind restricts it to the messages appended since the checkpoint
+	auto func = GetFunction();
+	func.name = "read_fix_follow";
+	func.bind = ReadFixFollowBind;
+
+	// Checkpoint name (default: the file path)
+	func.named_parameters["checkpoint"] = LogicalType(LogicalTypeId::VARCHAR);
+
+	return func;
+}
+
+// fix_follow_checkpoint(name) - offset a read_fix_follow checkpoint has read its file up to, NULL if there is none
+static void FixFollowCheckpointExecute(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &cache = ObjectCache::GetObjectCache(state.GetContext());
+	UnaryExecutor::ExecuteWithNulls<string_t, int64_t>(
+	    args.data[0], result, args.size(), [&](string_t name, ValidityMask &mask, idx_t row) -> int64_t {
+		    auto checkpoint = cache.Get<FixFollowCheckpoint>(FIX_FOLLOW_CHECKPOINT_PREFIX + name.GetString());
+		    if (!checkpoint) {
+			    mask.SetInvalid(row);
+			    return 0;
+		    }
+		    return static_cast<int64_t>(checkpoint->offset.load());
+	    });
+}
+
+ScalarFunction ReadFixFunction::GetFollowCheckpointFunction() {
+	ScalarFunction func("fix_follow_checkpoint", {LogicalType(LogicalTypeId::VARCHAR)},
+	                    LogicalType(LogicalTypeId::BIGINT), FixFollowCheckpointExecute);
+	// The checkpoint moves between queries
+	func.stability = FunctionStability::VOLATILE;
 	return func;
 }
 
@@ -1,12 +1,35 @@
 #pragma once
 
 #include "duckdb.hpp"
+#include "duckdb/function/scalar_function.hpp"
 #include "duckdb/function/table_function.hpp"
 
 namespace duckdb {
 
 struct ReadFixFunction {
+	// Levels of nested groups in the groups column, as deep as FIX 4.4 nests them (e.g. NoRelatedSym > NoLegs >
+	// NoNestedPartyIDs > NoNestedPartySubIDs); deeper groups are left out, their count tag stays a field
+	static constexpr idx_t GROUP_DEPTH = 4;
+
 	static TableFunction GetFunction();
+
+	// read_fix_follow(file) - the messages appended to a growing file since the last call
+	static TableFunction GetFollowFunction();
+
+	// fix_follow_checkpoint(name) - the offset read_fix_follow has read a file up to, to save across restarts
+	static ScalarFunction GetFollowCheckpointFunction();
+
+	// Parse the delimiter parameter: a single character, or '\x01' for SOH
+	static char ParseDelimiter(const string &delimiter);
+
+	// Parse a byte size parameter such as '32MB' or a plain number of bytes
+	static idx_t ParseByteSize(const string &name, const Value &value);
+
+	// Append the hot tag columns (MsgType ... Text), in slot order (see FixHotTags::ALL_TAGS)
+	static void AddHotColumns(vector<string> &names, vector<LogicalType> &return_types);
+
+	// Column type of a typed_tags column for a dictionary field type (INT, PRICE, UTCTIMESTAMP, ...)
+	static LogicalType GetTypedTagLogicalType(const string &field_type);
 };
 
 } // namespace duckdb
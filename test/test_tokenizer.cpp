@@ -5,6 +5,9 @@
 
 #include "parser/fix_tokenizer.hpp"
 #include "parser/fix_message.hpp"
+#include "parser/fix_simd_scan.hpp"
+
+namespace FixHotTags = duckdb::FixHotTags;
 
 // Helper to compare string with pointer/length
 bool str_eq(const char *ptr, size_t len, const char *expected) {
@@ -13,6 +16,11 @@ bool str_eq(const char *ptr, size_t len, const char *expected) {
 	return len == strlen(expected) && strncmp(ptr, expected, len) == 0;
 }
 
+// Helper to compare a tag value
+bool tag_eq(const ParsedFixMessage::TagValue &value, const char *expected) {
+	return str_eq(value.data, value.len, expected);
+}
+
 void test_basic_parsing() {
 	std::cout << "Test: Basic FIX message parsing..." << std::endl;
 
@@ -24,16 +32,16 @@ void test_basic_parsing() {
 	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
 
 	assert(success && "Parse should succeed");
-	assert(parsed.msg_type != nullptr && "MsgType should be set");
-	assert(str_eq(parsed.msg_type, parsed.msg_type_len, "D") && "MsgType should be D");
-	assert(str_eq(parsed.sender_comp_id, parsed.sender_comp_id_len, "SENDER"));
-	assert(str_eq(parsed.target_comp_id, parsed.target_comp_id_len, "TARGET"));
-	assert(str_eq(parsed.msg_seq_num, parsed.msg_seq_num_len, "1"));
-	assert(str_eq(parsed.cl_ord_id, parsed.cl_ord_id_len, "ORDER123"));
-	assert(str_eq(parsed.symbol, parsed.symbol_len, "AAPL"));
-	assert(str_eq(parsed.side, parsed.side_len, "1"));
-	assert(str_eq(parsed.order_qty, parsed.order_qty_len, "100"));
-	assert(str_eq(parsed.price, parsed.price_len, "150.50"));
+	assert(parsed.Hot<FixHotTags::MSG_TYPE>().data != nullptr && "MsgType should be set");
+	assert(tag_eq(parsed.Hot<FixHotTags::MSG_TYPE>(), "D") && "MsgType should be D");
+	assert(tag_eq(parsed.Hot<FixHotTags::SENDER_COMP_ID>(), "SENDER"));
+	assert(tag_eq(parsed.Hot<FixHotTags::TARGET_COMP_ID>(), "TARGET"));
+	assert(tag_eq(parsed.Hot<FixHotTags::MSG_SEQ_NUM>(), "1"));
+	assert(tag_eq(parsed.Hot<FixHotTags::CL_ORD_ID>(), "ORDER123"));
+	assert(tag_eq(parsed.Hot<FixHotTags::SYMBOL>(), "AAPL"));
+	assert(tag_eq(parsed.Hot<FixHotTags::SIDE>(), "1"));
+	assert(tag_eq(parsed.Hot<FixHotTags::ORDER_QTY>(), "100"));
+	assert(tag_eq(parsed.Hot<FixHotTags::PRICE>(), "150.50"));
 
 	std::cout << "  ✓ Basic parsing works correctly" << std::endl;
 }
@@ -48,15 +56,15 @@ void test_execution_report() {
 	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
 
 	assert(success && "Parse should succeed");
-	assert(str_eq(parsed.msg_type, parsed.msg_type_len, "8") && "MsgType should be 8 (ExecutionReport)");
-	assert(str_eq(parsed.order_id, parsed.order_id_len, "EXEC001"));
-	assert(str_eq(parsed.exec_id, parsed.exec_id_len, "TRADE001"));
-	assert(str_eq(parsed.exec_type, parsed.exec_type_len, "F"));
-	assert(str_eq(parsed.ord_status, parsed.ord_status_len, "2"));
-	assert(str_eq(parsed.cum_qty, parsed.cum_qty_len, "100"));
-	assert(str_eq(parsed.leaves_qty, parsed.leaves_qty_len, "0"));
-	assert(str_eq(parsed.last_px, parsed.last_px_len, "150.50"));
-	assert(str_eq(parsed.last_qty, parsed.last_qty_len, "100"));
+	assert(tag_eq(parsed.Hot<FixHotTags::MSG_TYPE>(), "8") && "MsgType should be 8 (ExecutionReport)");
+	assert(tag_eq(parsed.Hot<FixHotTags::ORDER_ID>(), "EXEC001"));
+	assert(tag_eq(parsed.Hot<FixHotTags::EXEC_ID>(), "TRADE001"));
+	assert(tag_eq(parsed.Hot<FixHotTags::EXEC_TYPE>(), "F"));
+	assert(tag_eq(parsed.Hot<FixHotTags::ORD_STATUS>(), "2"));
+	assert(tag_eq(parsed.Hot<FixHotTags::CUM_QTY>(), "100"));
+	assert(tag_eq(parsed.Hot<FixHotTags::LEAVES_QTY>(), "0"));
+	assert(tag_eq(parsed.Hot<FixHotTags::LAST_PX>(), "150.50"));
+	assert(tag_eq(parsed.Hot<FixHotTags::LAST_QTY>(), "100"));
 
 	std::cout << "  ✓ Execution report parsing works correctly" << std::endl;
 }
@@ -64,21 +72,23 @@ void test_execution_report() {
 void test_other_tags() {
 	std::cout << "Test: Non-hot tags stored in other_tags..." << std::endl;
 
-	std::string msg = "35=D|49=SENDER|8=FIX.4.4|9=100|21=1|40=2|59=0|60=20231215-10:30:00|10=000";
+	std::string msg = "8=FIX.4.4|35=D|49=SENDER|9=100|21=1|40=2|59=0|60=20231215-10:30:00|10=000";
 
 	ParsedFixMessage parsed;
 	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
 
 	assert(success && "Parse should succeed");
-	assert(parsed.other_tags.count(8) == 1 && "Tag 8 should be in other_tags");
-	assert(str_eq(parsed.other_tags[8].data, parsed.other_tags[8].len, "FIX.4.4"));
-	assert(parsed.other_tags.count(9) == 1 && "Tag 9 should be in other_tags");
-	assert(str_eq(parsed.other_tags[9].data, parsed.other_tags[9].len, "100"));
-	assert(parsed.other_tags.count(21) == 1 && "Tag 21 should be in other_tags");
-	assert(parsed.other_tags.count(40) == 1 && "Tag 40 should be in other_tags");
-	assert(parsed.other_tags.count(59) == 1 && "Tag 59 should be in other_tags");
-	assert(parsed.other_tags.count(60) == 1 && "Tag 60 should be in other_tags");
-	assert(parsed.other_tags.count(10) == 1 && "Tag 10 (checksum) should be in other_tags");
+	assert(parsed.other_tag_count == 7 && "Seven non-hot tags expected");
+	assert(parsed.FindTag(8) != nullptr && "Tag 8 should be in the tag list");
+	assert(str_eq(parsed.FindTag(8)->data, parsed.FindTag(8)->len, "FIX.4.4"));
+	assert(parsed.FindTag(9) != nullptr && "Tag 9 should be in the tag list");
+	assert(str_eq(parsed.FindTag(9)->data, parsed.FindTag(9)->len, "100"));
+	assert(parsed.FindTag(21) != nullptr && "Tag 21 should be in the tag list");
+	assert(parsed.FindTag(40) != nullptr && "Tag 40 should be in the tag list");
+	assert(parsed.FindTag(59) != nullptr && "Tag 59 should be in the tag list");
+	assert(parsed.FindTag(60) != nullptr && "Tag 60 should be in the tag list");
+	assert(parsed.FindTag(10) != nullptr && "Tag 10 (checksum) should be in the tag list");
+	assert(parsed.FindTag(999) == nullptr && "Tag 999 is not in the message");
 
 	std::cout << "  ✓ Non-hot tags correctly stored" << std::endl;
 }
@@ -87,7 +97,8 @@ void test_soh_delimiter() {
 	std::cout << "Test: SOH delimiter parsing..." << std::endl;
 
 	// Build message with SOH delimiter
-	std::string msg = "35=D\x01"
+	std::string msg = "8=FIX.4.4\x01"
+	                  "35=D\x01"
 	                  "49=SENDER\x01"
 	                  "56=TARGET\x01"
 	                  "11=ORDER123\x01"
@@ -97,11 +108,11 @@ void test_soh_delimiter() {
 	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '\x01');
 
 	assert(success && "Parse should succeed with SOH delimiter");
-	assert(str_eq(parsed.msg_type, parsed.msg_type_len, "D"));
-	assert(str_eq(parsed.sender_comp_id, parsed.sender_comp_id_len, "SENDER"));
-	assert(str_eq(parsed.target_comp_id, parsed.target_comp_id_len, "TARGET"));
-	assert(str_eq(parsed.cl_ord_id, parsed.cl_ord_id_len, "ORDER123"));
-	assert(str_eq(parsed.symbol, parsed.symbol_len, "MSFT"));
+	assert(tag_eq(parsed.Hot<FixHotTags::MSG_TYPE>(), "D"));
+	assert(tag_eq(parsed.Hot<FixHotTags::SENDER_COMP_ID>(), "SENDER"));
+	assert(tag_eq(parsed.Hot<FixHotTags::TARGET_COMP_ID>(), "TARGET"));
+	assert(tag_eq(parsed.Hot<FixHotTags::CL_ORD_ID>(), "ORDER123"));
+	assert(tag_eq(parsed.Hot<FixHotTags::SYMBOL>(), "MSFT"));
 
 	std::cout << "  ✓ SOH delimiter parsing works correctly" << std::endl;
 }
@@ -109,14 +120,14 @@ void test_soh_delimiter() {
 void test_missing_msgtype() {
 	std::cout << "Test: Missing MsgType error..." << std::endl;
 
-	std::string msg = "49=SENDER|56=TARGET|11=ORDER123";
+	std::string msg = "8=FIX.4.4|49=SENDER|56=TARGET|11=ORDER123";
 
 	ParsedFixMessage parsed;
 	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
 
 	assert(!success && "Parse should fail without MsgType");
-	assert(!parsed.parse_error.empty() && "Parse error should be set");
-	assert(parsed.parse_error.find("MsgType") != std::string::npos && "Error should mention MsgType");
+	assert(parsed.parse_error != nullptr && "Parse error should be set");
+	assert(strstr(parsed.parse_error, "MsgType") != nullptr && "Error should mention MsgType");
 
 	std::cout << "  ✓ Missing MsgType correctly detected" << std::endl;
 }
@@ -124,13 +135,13 @@ void test_missing_msgtype() {
 void test_invalid_format() {
 	std::cout << "Test: Invalid tag format error..." << std::endl;
 
-	std::string msg = "35=D|49SENDER|56=TARGET"; // Missing = in tag 49
+	std::string msg = "8=FIX.4.4|35=D|49SENDER|56=TARGET"; // Missing = in tag 49
 
 	ParsedFixMessage parsed;
 	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
 
 	assert(!success && "Parse should fail with invalid format");
-	assert(!parsed.parse_error.empty() && "Parse error should be set");
+	assert(parsed.parse_error != nullptr && "Parse error should be set");
 
 	std::cout << "  ✓ Invalid format correctly detected" << std::endl;
 }
@@ -144,7 +155,7 @@ void test_empty_message() {
 	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
 
 	assert(!success && "Parse should fail with empty message");
-	assert(!parsed.parse_error.empty() && "Parse error should be set");
+	assert(parsed.parse_error != nullptr && "Parse error should be set");
 
 	std::cout << "  ✓ Empty message correctly detected" << std::endl;
 }
@@ -152,7 +163,7 @@ void test_empty_message() {
 void test_raw_message_stored() {
 	std::cout << "Test: Raw message is stored..." << std::endl;
 
-	std::string msg = "35=D|49=SENDER|56=TARGET|55=AAPL";
+	std::string msg = "8=FIX.4.4|35=D|49=SENDER|56=TARGET|55=AAPL";
 
 	ParsedFixMessage parsed;
 	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
@@ -165,6 +176,171 @@ void test_raw_message_stored() {
 	std::cout << "  ✓ Raw message correctly stored" << std::endl;
 }
 
+void test_message_reuse() {
+	std::cout << "Test: Reused message keeps its capacity..." << std::endl;
+
+	std::string first = "8=FIX.4.4|35=W|55=AAPL|268=2|269=0|270=1.5|269=1|270=1.6|10=000";
+	std::string second = "8=FIX.4.4|35=W|55=MSFT|268=2|269=0|270=2.5|269=1|270=2.6|10=000";
+
+	ParsedFixMessage parsed;
+	assert(FixTokenizer::Parse(first.c_str(), first.size(), parsed, '|'));
+	auto capacity = parsed.all_tags_ordered.capacity();
+	auto data = parsed.all_tags_ordered.data();
+
+	assert(FixTokenizer::Parse(second.c_str(), second.size(), parsed, '|'));
+	assert(parsed.all_tags_ordered.capacity() == capacity && "Tag list should not be reallocated");
+	assert(parsed.all_tags_ordered.data() == data && "Tag list should not be reallocated");
+	assert(tag_eq(parsed.Hot<FixHotTags::SYMBOL>(), "MSFT"));
+	// Repeated tags: the last occurrence wins
+	assert(str_eq(parsed.FindTag(270)->data, parsed.FindTag(270)->len, "2.6"));
+	assert(parsed.parse_error == nullptr);
+
+	std::cout << "  ✓ Reused message does not reallocate" << std::endl;
+}
+
+void test_simd_classifiers() {
+	std::cout << "Test: SIMD classifiers match the scalar kernel..." << std::endl;
+
+	auto scalar = FixSimdScan::GetClassifier(FixSimdLevel::SCALAR);
+	const FixSimdLevel levels[] = {FixSimdLevel::SSE2, FixSimdLevel::AVX2, FixSimdLevel::NEON};
+	const char alphabet[] = {'|', '=', '\x01', '8', 'A', ' ', '\xff', '\0'};
+
+	char block[FIX_SCAN_BLOCK_SIZE];
+	unsigned seed = 12345;
+	for (int iteration = 0; iteration < 10000; iteration++) {
+		for (size_t i = 0; i < FIX_SCAN_BLOCK_SIZE; i++) {
+			seed = seed * 1103515245 + 12345;
+			block[i] = alphabet[(seed >> 16) % sizeof(alphabet)];
+		}
+		for (char delimiter : {'|', '\x01'}) {
+			uint64_t expected = scalar(block, delimiter);
+			for (auto level : levels) {
+				auto classify = FixSimdScan::GetClassifier(level);
+				if (classify) {
+					assert(classify(block, delimiter) == expected && "Kernel disagrees with scalar");
+				}
+			}
+			for (size_t len = 0; len < FIX_SCAN_BLOCK_SIZE; len += 7) {
+				uint64_t tail_mask = len == 0 ? 0 : expected & ((static_cast<uint64_t>(1) << len) - 1);
+				assert(FixSimdScan::ClassifyTail(FixSimdScan::GetClassifier(), block, len, delimiter) == tail_mask);
+			}
+		}
+	}
+
+	std::cout << "  ✓ Kernels agree (host level: " << FixSimdScan::GetLevelName(FixSimdScan::GetLevel()) << ")"
+	          << std::endl;
+}
+
+void test_value_with_equals() {
+	std::cout << "Test: '=' inside values and long messages..." << std::endl;
+
+	// Values may contain '=', only the first '=' of a field separates tag and value
+	std::string msg = "8=FIX.4.4|35=D|58=a=b=c|";
+	// Long enough to cross several 64-byte blocks
+	for (int i = 0; i < 20; i++) {
+		msg += "448=PARTY" + std::to_string(i) + "|";
+	}
+	msg += "10=000";
+
+	ParsedFixMessage parsed;
+	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
+
+	assert(success && "Parse should succeed");
+	assert(tag_eq(parsed.Hot<FixHotTags::TEXT>(), "a=b=c"));
+	assert(parsed.all_tags_ordered.size() == 24);
+	assert(str_eq(parsed.FindTag(448)->data, parsed.FindTag(448)->len, "PARTY19"));
+	assert(str_eq(parsed.FindTag(10)->data, parsed.FindTag(10)->len, "000"));
+
+	std::cout << "  ✓ Values with '=' and multi-block messages parse correctly" << std::endl;
+}
+
+void test_promoted_tags() {
+	std::cout << "Test: Promoted tags are stored in slots..." << std::endl;
+
+	FixTagLayout layout;
+	auto ord_type_slot = layout.AddTag(40);
+	auto big_tag_slot = layout.AddTag(100000);
+	assert(layout.AddTag(40) == ord_type_slot && "Promoting a tag twice should reuse its slot");
+	assert(layout.AddTag(FixHotTags::SYMBOL) == FixHotTags::HotSlot(FixHotTags::SYMBOL));
+	assert(layout.IsHotTag(FixHotTags::SYMBOL) && !layout.IsHotTag(40) && !layout.IsHotTag(7));
+
+	std::string msg = "8=FIX.4.4|35=D|55=AAPL|40=2|100000=X|59=0|10=000";
+	ParsedFixMessage parsed(layout);
+	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
+
+	assert(success && "Parse should succeed");
+	assert(tag_eq(parsed.GetSlot(ord_type_slot), "2"));
+	assert(tag_eq(parsed.GetSlot(big_tag_slot), "X"));
+	assert(tag_eq(parsed.Hot<FixHotTags::SYMBOL>(), "AAPL"));
+	assert(tag_eq(*parsed.FindTag(40), "2"));
+	assert(tag_eq(*parsed.FindTag(59), "0"));
+	// 8, 40, 100000, 59 and 10 are not hot tags
+	assert(parsed.other_tag_count == 5);
+
+	std::cout << "  ✓ Promoted tags correctly stored" << std::endl;
+}
+
+void test_early_exit() {
+	std::cout << "Test: Parsing stops once the required tags are found..." << std::endl;
+
+	// The tail after 55 is malformed, an early exit never looks at it
+	std::string msg = "8=FIX.4.4|35=D|55=AAPL|55=MSFT|44=1.5|49SENDER|10=000";
+
+	FixParseOptions options;
+	options.delimiter = '|';
+	options.keep_tag_list = false;
+	options.RequireSlot(FixHotTags::HotSlot(FixHotTags::MSG_TYPE));
+	options.RequireSlot(FixHotTags::HotSlot(FixHotTags::SYMBOL));
+	options.RequireSlot(FixHotTags::HotSlot(FixHotTags::SYMBOL));
+	assert(options.required_count == 2 && "Requiring a slot twice should count it once");
+
+	ParsedFixMessage parsed;
+	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, options);
+	assert(success && "Parse should stop before the malformed field");
+	assert(tag_eq(parsed.Hot<FixHotTags::SYMBOL>(), "AAPL"));
+	assert(parsed.Hot<FixHotTags::PRICE>().data == nullptr && "Tags after the exit should not be parsed");
+	assert(parsed.all_tags_ordered.empty() && "Tag list should not be built");
+
+	// Without early exit the whole message is checked
+	success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
+	assert(!success && "Full parse should reject the malformed field");
+
+	std::cout << "  ✓ Early exit skips the rest of the message" << std::endl;
+}
+
+void test_repeated_tags() {
+	std::cout << "Test: Repeated tags keep their last occurrence..." << std::endl;
+
+	// The empty first MsgType does not count, the later one is kept
+	std::string msg = "8=FIX.4.4|35=|34=1|35=D|55=AAPL|55=MSFT|10=000";
+
+	ParsedFixMessage parsed;
+	bool success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, '|');
+	assert(success && "An empty first MsgType should not reject the message");
+	assert(tag_eq(parsed.Hot<FixHotTags::MSG_TYPE>(), "D"));
+	assert(tag_eq(parsed.Hot<FixHotTags::SYMBOL>(), "MSFT"));
+	assert(str_eq(parsed.FindTag(55)->data, parsed.FindTag(55)->len, "MSFT"));
+
+	// With an early exit, the empty value does not satisfy MsgType either
+	FixParseOptions options;
+	options.delimiter = '|';
+	options.keep_tag_list = false;
+	options.RequireSlot(FixHotTags::HotSlot(FixHotTags::MSG_TYPE));
+	options.RequireSlot(FixHotTags::HotSlot(FixHotTags::MSG_SEQ_NUM));
+	success = FixTokenizer::Parse(msg.c_str(), msg.size(), parsed, options);
+	assert(success && "Early exit should wait for a non-empty MsgType");
+	assert(tag_eq(parsed.Hot<FixHotTags::MSG_TYPE>(), "D"));
+	assert(parsed.Hot<FixHotTags::SYMBOL>().data == nullptr && "Tags after the exit should not be parsed");
+
+	// A later empty value clears the tag
+	std::string cleared = "8=FIX.4.4|35=D|55=AAPL|55=|10=000";
+	success = FixTokenizer::Parse(cleared.c_str(), cleared.size(), parsed, '|');
+	assert(success && "Parse should succeed");
+	assert(parsed.Hot<FixHotTags::SYMBOL>().len == 0 && "The last, empty Symbol should win");
+
+	std::cout << "  ✓ Repeated tags resolve to their last occurrence, empty values do not count as found" << std::endl;
+}
+
 int main() {
 	std::cout << "Running QuackFIX Tokenizer Tests...\n" << std::endl;
 
@@ -177,6 +353,12 @@ int main() {
 		test_invalid_format();
 		test_empty_message();
 		test_raw_message_stored();
+		test_message_reuse();
+		test_simd_classifiers();
+		test_value_with_equals();
+		test_promoted_tags();
+		test_early_exit();
+		test_repeated_tags();
 
 		std::cout << "\n✅ All tokenizer tests passed!" << std::endl;
 		return 0;